@@ -47,6 +47,9 @@ function connectCallback(msg) {
             case "plotcheck-result":
                 setPlotIntegrity(response);
                 break;
+            case "totalPlotcheck-progress":
+                setTotalPlotCheckProgress(response);
+                break;
             case "totalPlotcheck-result":
                 setTotalPlotIntegrity(response);
                 break;
@@ -106,7 +109,8 @@ function parsePlots() {
             var account = filename_tokens[0];
             var start_nonce = filename_tokens[1];
             var nonces = filename_tokens[2];
-            var staggersize = filename_tokens[3];
+            // PoC2 plot files are optimized and have no stagger size in their name
+            var staggersize = filename_tokens.length > 3 ? filename_tokens[3] : nonces;
             var size = plotFile["size"];
             var lineFile = createPlotfileLine(account, start_nonce, nonces, staggersize, size, path);
 
@@ -198,6 +202,12 @@ function setPlotIntegrity(checkPlotResult) {
 });
 }
 
+function setTotalPlotCheckProgress(progress) {
+    if (isCheckingAll)
+        $("#CheckAllButton").html("<i class='fas fa-spinner fa-pulse'></i>&nbsp;&nbsp;" +
+            progress["checked"] + " / " + progress["total"]);
+}
+
 function setTotalPlotIntegrity(totalCheckResult) {
     isCheckingAll=false;
     var totIntegrity = Math.round(Number(totalCheckResult["totalPlotIntegrity"])*100)/100;
@@ -31,6 +31,12 @@ std::string Burst::Settings::Cpu_Instruction_Set = "";
 Burst::ProjectData Burst::Settings::Project("creepMiner",
 	Burst::Version(VERSION_MAJOR, VERSION_MINOR, VERSION_BUILD, 0));
 
+#ifdef USE_SSE2
+const bool Burst::Settings::Sse2 = true;
+#else
+const bool Burst::Settings::Sse2 = false;
+#endif
+
 #ifdef USE_SSE4
 const bool Burst::Settings::Sse4 = true;
 #else
@@ -49,6 +55,12 @@ const bool Burst::Settings::Avx2 = true;
 const bool Burst::Settings::Avx2 = false;
 #endif
 
+#ifdef USE_AVX512
+const bool Burst::Settings::Avx512 = true;
+#else
+const bool Burst::Settings::Avx512 = false;
+#endif
+
 #ifdef USE_CUDA
 const bool Burst::Settings::Cuda = true;
 #else
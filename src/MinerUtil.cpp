@@ -48,6 +48,9 @@
 #include <fstream>
 #include "plots/PlotSizes.hpp"
 #include <chrono>
+#include <array>
+#include <cstring>
+#include <Poco/String.h>
 
 #if defined(_WIN32)
 #include <Windows.h>
@@ -210,9 +213,52 @@ std::string Burst::getNonceCountFromPlotFile(const std::string& path)
 
 std::string Burst::getStaggerSizeFromPlotFile(const std::string& path)
 {
+	// PoC2 plot files are optimized, there is only one stagger
+	if (isPoc2PlotFile(path))
+		return getNonceCountFromPlotFile(path);
+
 	return getInformationFromPlotFile(path, 3);
 }
 
+bool Burst::isPoc2PlotFile(const std::string& path)
+{
+	auto filenamePos = path.find_last_of("/\\");
+
+	if (filenamePos == std::string::npos)
+		filenamePos = 0;
+	else
+		++filenamePos;
+
+	auto fileNamePart = splitStr(path.substr(filenamePos), '_');
+
+	if (fileNamePart.size() != 3)
+		return false;
+
+	for (const auto& part : fileNamePart)
+		if (!isNumberStr(part))
+			return false;
+
+	return true;
+}
+
+bool Burst::readPlotFileProgress(const std::string& path, Poco::UInt64& noncesWritten)
+{
+	std::ifstream progress{path + ":stream", std::ios::in | std::ios::binary};
+
+	if (!progress)
+		return false;
+
+	progress.read(reinterpret_cast<char*>(&noncesWritten), sizeof noncesWritten);
+	return static_cast<bool>(progress);
+}
+
+bool Burst::writePlotFileProgress(const std::string& path, const Poco::UInt64 noncesWritten)
+{
+	std::ofstream progress{path + ":stream", std::ios::out | std::ios::binary | std::ios::trunc};
+	progress.write(reinterpret_cast<const char*>(&noncesWritten), sizeof noncesWritten);
+	return static_cast<bool>(progress);
+}
+
 std::string Burst::getStartNonceFromPlotFile(const std::string& path)
 {
 	auto filenamePos = path.find_last_of("/\\");
@@ -222,7 +268,7 @@ std::string Burst::getStartNonceFromPlotFile(const std::string& path)
 
 	auto fileNamePart = splitStr(path.substr(filenamePos + 1, path.length() - (filenamePos + 1)), '_');
 
-	if (fileNamePart.size() > 3)
+	if (fileNamePart.size() > 2)
 	{
 		auto nonceStartPart = fileNamePart[1];
 
@@ -552,6 +598,7 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 			Poco::JSON::Array jsonRoundTimeHistory;
 			jsonRoundTimeHistory.add(std::to_string(historicalRoundTime->getBlockheight()));
 			jsonRoundTimeHistory.add(std::to_string(roundTime));
+			jsonRoundTimeHistory.add(std::to_string(historicalRoundTime->getPredictedRoundTime()));
 			roundTimeHistory.add(jsonRoundTimeHistory);
 			nRTimes++;
 			sumRTimes += roundTime;
@@ -805,6 +852,8 @@ Poco::JSON::Object Burst::createJsonPlotDir(const PlotDir& plotDir)
 
 		jsonPlotFile.set("path", plotFile->getPath());
 		jsonPlotFile.set("size", memToString(plotFile->getSize(), 2));
+		// the physically contiguous parts of the file (0 = unknown), a file with many fragments should be defragmented
+		jsonPlotFile.set("fragments", plotFile->getExtents().size());
 
 		jsonPlotFiles.add(jsonPlotFile);
 	}
@@ -933,6 +982,7 @@ bool Burst::cpuHasInstructionSet(CpuInstructionSet cpuInstructionSet)
 	case sse4: return (instructionSets & sse4) == sse4;
 	case avx: return (instructionSets & avx) == avx;
 	case avx2: return (instructionSets & avx2) == avx2;
+	case avx512: return (instructionSets & avx512) == avx512;
 	default: return false;
 	}
 }
@@ -956,6 +1006,9 @@ int Burst::cpuGetInstructionSets()
 	if (__builtin_cpu_supports("avx2"))
 		instruction_sets += avx2;
 
+	if (__builtin_cpu_supports("avx512f"))
+		instruction_sets += avx512;
+
 	return instruction_sets;
 #else
 	int info[4];
@@ -966,6 +1019,7 @@ int Burst::cpuGetInstructionSets()
 	auto has_sse4 = false;
 	auto has_avx = false;
 	auto has_avx2 = false;
+	auto has_avx512 = false;
 
 	//  Detect Features
 	if (n_ids >= 0x00000001)
@@ -980,6 +1034,7 @@ int Burst::cpuGetInstructionSets()
 	{
 		cpuid(info, 0x00000007);
 		has_avx2 = (info[1] & (static_cast<int>(1) << 5)) != 0;
+		has_avx512 = (info[1] & (static_cast<int>(1) << 16)) != 0;
 	}
 
 	auto instruction_sets = 0;
@@ -996,10 +1051,54 @@ int Burst::cpuGetInstructionSets()
 	if (has_avx2)
 		instruction_sets += avx2;
 
+	if (has_avx512)
+		instruction_sets += avx512;
+
 	return instruction_sets;
 #endif
 }
 
+bool Burst::cpuHasSse42()
+{
+#if defined __arm__
+	return false;
+#elif defined __GNUC__
+	return __builtin_cpu_supports("sse4.2") != 0;
+#else
+	int info[4];
+	cpuid(info, 0);
+
+	if (info[0] < 0x00000001)
+		return false;
+
+	cpuid(info, 0x00000001);
+	return (info[2] & 1 << 20) != 0;
+#endif
+}
+
+std::string Burst::cpuGetBrand()
+{
+#if defined __arm__
+	return "";
+#else
+	int info[4];
+	cpuid(info, static_cast<int>(0x80000000));
+
+	if (static_cast<unsigned>(info[0]) < 0x80000004)
+		return "";
+
+	std::array<char, 3 * sizeof info + 1> brand{};
+
+	for (auto i = 0u; i < 3; ++i)
+	{
+		cpuid(info, static_cast<int>(0x80000002 + i));
+		memcpy(brand.data() + i * sizeof info, info, sizeof info);
+	}
+
+	return Poco::trim(std::string(brand.data()));
+#endif
+}
+
 size_t Burst::getMemorySize()
 {
 	/*
@@ -1079,6 +1178,27 @@ size_t Burst::getMemorySize()
 #endif
 }
 
+Poco::UInt64 Burst::getPageCacheSize()
+{
+#ifdef __linux__
+	std::ifstream meminfo("/proc/meminfo");
+	std::string line;
+
+	// the line looks like "Cached:  1234 kB"
+	while (std::getline(meminfo, line))
+	{
+		std::istringstream lineStream(line);
+		std::string key;
+		Poco::UInt64 value = 0;
+
+		if (lineStream >> key >> value && key == "Cached:")
+			return value * 1024;
+	}
+#endif
+
+	return 0;
+}
+
 // https://stackoverflow.com/questions/1413445/reading-a-password-from-stdcin
 void Burst::setStdInEcho(bool enable)
 {
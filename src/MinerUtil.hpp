@@ -93,7 +93,8 @@ namespace Burst
 		sse2 = 1 << 0,
 		sse4 = 1 << 1,
 		avx = 1 << 2,
-		avx2 = 1 << 3
+		avx2 = 1 << 3,
+		avx512 = 1 << 4
 	};
 
 	bool isNumberStr(const std::string& str);
@@ -106,6 +107,31 @@ namespace Burst
 	std::string getStartNonceFromPlotFile(const std::string& path);
 	std::string getNonceCountFromPlotFile(const std::string& path);
 	std::string getStaggerSizeFromPlotFile(const std::string& path);
+
+	/**
+	 * \brief Checks, if a plot file has the PoC2 format.
+	 * PoC2 plot files are named <account>_<start nonce>_<nonces> and are always optimized,
+	 * PoC1 plot files have the stagger size as fourth part.
+	 * \param path The path of the plot file.
+	 * \return true, if the plot file has the PoC2 format.
+	 */
+	bool isPoc2PlotFile(const std::string& path);
+
+	/**
+	 * \brief Reads the progress of a plot file, that is written by a plotter (<file>:stream).
+	 * \param path The path of the plot file.
+	 * \param noncesWritten The number of nonces, that are written completely.
+	 * \return true, if the plot file has a progress, false otherwise.
+	 */
+	bool readPlotFileProgress(const std::string& path, Poco::UInt64& noncesWritten);
+
+	/**
+	 * \brief Writes the progress of a plot file (<file>:stream), that is checked by isValidPlotFile.
+	 * \param path The path of the plot file.
+	 * \param noncesWritten The number of nonces, that are written completely.
+	 * \return true, if the progress was written, false otherwise.
+	 */
+	bool writePlotFileProgress(const std::string& path, Poco::UInt64 noncesWritten);
 	std::string deadlineFormat(Poco::UInt64 seconds);
 	Poco::UInt64 deadlineFragment(Poco::UInt64 seconds, DeadlineFragment fragment);
 	Poco::UInt64 formatDeadline(const std::string& format);
@@ -169,8 +195,25 @@ namespace Burst
 
 	bool cpuHasInstructionSet(CpuInstructionSet cpuInstructionSet);
 	int cpuGetInstructionSets();
+	/**
+	 * \brief Checks, if the CPU supports SSE4.2 (and with it the crc32 instruction).
+	 * The SSE4 flag of \see cpuGetInstructionSets is also set for CPUs with SSE4.1 only.
+	 * \return true, if the CPU supports SSE4.2, false otherwise.
+	 */
+	bool cpuHasSse42();
+	/**
+	 * \brief Returns the brand string of the CPU, e.g. "Intel(R) Core(TM) i7-7700K CPU @ 4.20GHz".
+	 * \return The brand string or an empty string, if the CPU does not provide one.
+	 */
+	std::string cpuGetBrand();
 
 	size_t getMemorySize();
+
+	/**
+	 * \brief Returns the size of the page cache of the operating system.
+	 * \return The size of the page cache in bytes, 0 if it is unknown on the platform.
+	 */
+	Poco::UInt64 getPageCacheSize();
 	void setStdInEcho(bool enable);
 
 	Poco::Path getMinerHomeDir();
@@ -71,6 +71,22 @@ void Burst::Performance::takeProbe(const std::string &id)
 	++iter->second.size;
 }
 
+void Burst::Performance::addValue(const std::string &id, double value)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto iter = probes_.find(id);
+
+	// if it dont exist, create it
+	if (iter == probes_.end())
+	{
+		probes_.emplace(id, Probe());
+		iter = probes_.find(id);
+	}
+
+	iter->second.sumValue += value;
+}
+
 void Burst::Performance::print(std::ostream& stream) const
 {
 	std::lock_guard<std::mutex> lock(mutex_);
@@ -83,6 +99,7 @@ void Burst::Performance::print(std::ostream& stream) const
 		<< delimiter << "highest time"
 		<< delimiter << "sum time"
 		<< delimiter << "probes"
+		<< delimiter << "sum value"
 		<< std::endl;
 
 	for (auto& probe : probes_)
@@ -93,6 +110,7 @@ void Burst::Performance::print(std::ostream& stream) const
 			<< delimiter << probe.second.highestToSeconds()
 			<< delimiter << probe.second.sumToSeconds()
 			<< delimiter << probe.second.size
+			<< delimiter << probe.second.sumValue
 			<< std::endl;
 }
 
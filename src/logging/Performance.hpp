@@ -49,6 +49,15 @@ namespace Burst
 		 * \param id The id of the measurement.
 		 */
 		void takeProbe(const std::string &id);
+
+		/**
+		 * \brief Adds a value (e.g. an amount of bytes) to a measurement.
+		 * Together with the sum time it gives the throughput of the measurement.
+		 * Creates the measurement, if it does not exist.
+		 * \param id The id of the measurement.
+		 * \param value The value, that is added.
+		 */
+		void addValue(const std::string &id, double value);
 	
 		/**
 		 * \brief Prints the whole measurements into a output stream.
@@ -78,6 +87,7 @@ namespace Burst
 			std::chrono::high_resolution_clock::duration lowestTime;
 			std::chrono::high_resolution_clock::duration highestTime;
 			size_t size;
+			double sumValue;
 
 			/**
 			 * \brief Returns the average duration of the probes.
@@ -139,6 +149,21 @@ namespace Burst
  */
 #define TAKE_PROBE_DOMAIN(name, domain) if TEST_PROBE { TAKE_PROBE(name) TAKE_PROBE(std::string(name) + "." + domain); }
 
+/**
+ * \brief Adds a value to a probe with a specific name.
+ * \param name The name of the probe.
+ * \param value The value.
+ */
+#define ADD_PROBE_VALUE(name, value) if TEST_PROBE Burst::Performance::instance().addValue(name, static_cast<double>(value));
+
+/**
+ * \brief Adds a value to a probe with a specific name and also to a probe for a specific domain.
+ * \param name The name of the probe.
+ * \param domain The domain of the probe.
+ * \param value The value.
+ */
+#define ADD_PROBE_VALUE_DOMAIN(name, domain, value) if TEST_PROBE { ADD_PROBE_VALUE(name, value) ADD_PROBE_VALUE(std::string(name) + "." + domain, value); }
+
 /**
  * \brief Removes all probes.
  */
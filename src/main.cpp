@@ -47,6 +47,15 @@
 #include <regex>
 #include <Poco/Data/SQLite/Connector.h>
 #include "MinerUtil.hpp"
+#include "plots/PlotVerifier.hpp"
+#include "plots/PlotOptimizer.hpp"
+#include "plots/Plotter.hpp"
+#include "plots/PlotGenerator.hpp"
+#include "plots/Plot.hpp"
+#include "plots/PlotChecksums.hpp"
+#include "network/AsyncHttpClient.hpp"
+#include <atomic>
+#include <thread>
 
 class SslInitializer
 {
@@ -69,11 +78,32 @@ struct Arguments
 	bool process(int argc, const char* argv[]);
 
 	bool helpRequested = false;
+	bool kernelBenchmark = false;
+	bool schedulerBenchmark = false;
 	std::string confPath = "mining.conf";
+	bool plotBenchmark = false;
+	bool selfTest = false;
+	std::vector<std::string> optimizeFiles;
+	std::vector<std::string> checksumFiles;
+	bool plot = false;
+	Poco::UInt64 plotAccount = 0, plotStartNonce = 0, plotNonces = 0;
+	std::string outputDir;
+	bool poc2 = false;
+	Poco::UInt64 bufferMemory = 1024;
 
 private:
 	void displayHelp(const std::string& name, const std::string& value);
 	void setConfPath(const std::string& name, const std::string& value);
+	void setKernelBenchmark(const std::string& name, const std::string& value);
+	void setSchedulerBenchmark(const std::string& name, const std::string& value);
+	void setPlotBenchmark(const std::string& name, const std::string& value);
+	void setSelfTest(const std::string& name, const std::string& value);
+	void addOptimizeFile(const std::string& name, const std::string& value);
+	void addChecksumFile(const std::string& name, const std::string& value);
+	void setPlot(const std::string& name, const std::string& value);
+	void setOutputDir(const std::string& name, const std::string& value);
+	void setPoc2(const std::string& name, const std::string& value);
+	void setBufferMemory(const std::string& name, const std::string& value);
 
 private:
 	Poco::Util::OptionSet options_;
@@ -116,9 +146,11 @@ int main(const int argc, const char* argv[])
 
 	checkAndPrint(Cuda, "CUDA");
 	checkAndPrint(OpenCl, "OpenCL");
+	checkAndPrint(Sse2, "SSE2");
 	checkAndPrint(Sse4, "SSE4");
 	checkAndPrint(Avx, "AVX");
 	checkAndPrint(Avx2, "AVX2");
+	checkAndPrint(Avx512, "AVX512");
 
 	log_information(general, Burst::Settings::Project.nameAndVersionVerbose);
 	log_information(general, "%s mode%s", mode, sstream.str());
@@ -128,6 +160,56 @@ int main(const int argc, const char* argv[])
 	log_information(general, "Burst :   BURST-JBKL-ZUAV-UXMB-2G795");
 	log_information(general, "----------------------------------------------");
 
+	if (arguments.kernelBenchmark)
+	{
+		Burst::benchmarkVerifierAlgorithms(1024 * 1024, 10);
+		return EXIT_SUCCESS;
+	}
+
+	if (arguments.schedulerBenchmark)
+	{
+		Burst::benchmarkVerificationScheduler(64, 200000, 64);
+		return EXIT_SUCCESS;
+	}
+
+	if (arguments.plotBenchmark)
+	{
+		Burst::Plotter::benchmark(1024);
+		return EXIT_SUCCESS;
+	}
+
+	if (arguments.selfTest)
+		return Burst::PlotGenerator::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	if (arguments.plot)
+	{
+		Burst::Plotter plotter{arguments.plotAccount, arguments.plotStartNonce, arguments.plotNonces,
+			arguments.outputDir.empty() ? "." : arguments.outputDir, arguments.poc2, arguments.bufferMemory * 1024 * 1024, 0};
+
+		return plotter.run([]() { return false; }) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (!arguments.checksumFiles.empty())
+	{
+		auto success = true;
+
+		for (const auto& path : arguments.checksumFiles)
+		{
+			if (Burst::isValidPlotFile(path) != Burst::PlotCheckResult::Ok)
+			{
+				log_error(general, "%s is not a valid plot file", path);
+				success = false;
+				continue;
+			}
+
+			const Burst::PlotFile plotFile{std::string(path), Poco::File{path}.getSize()};
+			success = Burst::PlotChecksums::build(plotFile, arguments.bufferMemory * 1024 * 1024,
+				[]() { return false; }) && success;
+		}
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	try
 	{
 		using namespace Poco;
@@ -240,8 +322,35 @@ int main(const int argc, const char* argv[])
 				Burst::MinerLogger::setChannelMinerData(&miner.getData());
 				Burst::MinerConfig::getConfig().checkPlotOverlaps();
 
+				// the plot files are optimized while the miner is running and idle
+				std::atomic<bool> stopOptimizer{false};
+				std::thread optimizer;
+
+				if (!arguments.optimizeFiles.empty())
+					optimizer = std::thread([&]()
+					{
+						try
+						{
+							Burst::PlotOptimizer plotOptimizer{arguments.optimizeFiles, arguments.outputDir,
+								arguments.poc2, arguments.bufferMemory * 1024 * 1024};
+
+							plotOptimizer.run([&miner]() { return miner.isProcessing(); },
+								[&stopOptimizer]() { return stopOptimizer.load(); });
+						}
+						catch (Poco::Exception& exc)
+						{
+							log_error(general, "Could not optimize the plot files: %s", exc.displayText());
+						}
+					});
+
 				miner.run();
 				server.stop();
+				Burst::AsyncHttpClient::instance().stop();
+
+				stopOptimizer = true;
+
+				if (optimizer.joinable())
+					optimizer.join();
 
 				running = miner.wantRestart();
 				Burst::MinerLogger::setChannelMinerData(nullptr);
@@ -303,6 +412,70 @@ Arguments::Arguments()
 		.repeatable(false)
 		.argument("path")
 		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setConfPath)));
+
+	options_.addOption(Option("kernel-benchmark", "k", "Measures the speed of all CPU verification kernels and exits")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setKernelBenchmark)));
+
+	options_.addOption(Option("scheduler-benchmark", "s", "Measures how the verification scales from 1 to 64 verifiers and exits")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setSchedulerBenchmark)));
+
+	options_.addOption(Option("plot-benchmark", "", "Measures the speed of the plotter against the integrity check generator and exits")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotBenchmark)));
+
+	options_.addOption(Option("selftest", "", "Checks the PoC1 and PoC2 plot formats against golden vectors and exits\n"
+		"The exit code is not 0, if a check failed")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setSelfTest)));
+
+	options_.addOption(Option("plot", "p", "Plots an optimized plot file with all cores and exits\n"
+		"e.g. --plot=12345_0_4096 for 4096 nonces of the account 12345, starting at nonce 0\n"
+		"The number of nonces is rounded down to a multiple of 64\n"
+		"An interrupted plot file is resumed on the next start")
+		.required(false)
+		.repeatable(false)
+		.argument("account_startnonce_nonces")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlot)));
+
+	options_.addOption(Option("optimize", "o", "Rewrites the plot file into one stagger while the miner is idle\n"
+		"Repeat it to merge plot files with consecutive nonces into one file\n"
+		"The progress is kept, an interrupted optimization is resumed on the next start")
+		.required(false)
+		.repeatable(true)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::addOptimizeFile)));
+
+	options_.addOption(Option("checksum", "", "Verifies every nonce of the plot file and creates its checksum index and exits\n"
+		"With the index, the plot readers detect corrupted scoops while mining\n"
+		"Repeat it for multiple plot files")
+		.required(false)
+		.repeatable(true)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::addChecksumFile)));
+
+	options_.addOption(Option("output-dir", "", "The dir of the plotted or optimized plot file\n"
+		"(default: the current dir or the dir of the first optimized plot file)")
+		.required(false)
+		.repeatable(false)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setOutputDir)));
+
+	options_.addOption(Option("poc2", "", "Writes the plotted or optimized plot file in the PoC2 format")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPoc2)));
+
+	options_.addOption(Option("buffer-memory", "", "The memory in MB, that is used to plot, optimize or create checksum indexes (default: 1024)")
+		.required(false)
+		.repeatable(false)
+		.argument("MB")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setBufferMemory)));
 }
 
 bool Arguments::process(const int argc, const char* argv[])
@@ -361,6 +534,64 @@ void Arguments::setConfPath(const std::string& name, const std::string& value)
 	confPath = value;
 }
 
+void Arguments::setKernelBenchmark(const std::string& name, const std::string& value)
+{
+	kernelBenchmark = true;
+}
+
+void Arguments::setSchedulerBenchmark(const std::string& name, const std::string& value)
+{
+	schedulerBenchmark = true;
+}
+
+void Arguments::setPlotBenchmark(const std::string& name, const std::string& value)
+{
+	plotBenchmark = true;
+}
+
+void Arguments::setSelfTest(const std::string& name, const std::string& value)
+{
+	selfTest = true;
+}
+
+void Arguments::addOptimizeFile(const std::string& name, const std::string& value)
+{
+	optimizeFiles.emplace_back(value);
+}
+
+void Arguments::addChecksumFile(const std::string& name, const std::string& value)
+{
+	checksumFiles.emplace_back(value);
+}
+
+void Arguments::setPlot(const std::string& name, const std::string& value)
+{
+	const auto parts = Burst::splitStr(value, '_');
+
+	if (parts.size() != 3)
+		throw std::invalid_argument(value);
+
+	plotAccount = std::stoull(parts[0]);
+	plotStartNonce = std::stoull(parts[1]);
+	plotNonces = std::stoull(parts[2]);
+	plot = true;
+}
+
+void Arguments::setOutputDir(const std::string& name, const std::string& value)
+{
+	outputDir = value;
+}
+
+void Arguments::setPoc2(const std::string& name, const std::string& value)
+{
+	poc2 = true;
+}
+
+void Arguments::setBufferMemory(const std::string& name, const std::string& value)
+{
+	bufferMemory = std::stoull(value);
+}
+
 KeyConfigHandler::KeyConfigHandler(bool server)
 	: PrivateKeyPassphraseHandler{server}
 {}
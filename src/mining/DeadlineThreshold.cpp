@@ -0,0 +1,59 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "DeadlineThreshold.hpp"
+#include <limits>
+
+Burst::DeadlineThreshold::DeadlineThreshold(const Poco::UInt64 targetDeadline)
+	: bound_{targetDeadline > 0 && targetDeadline < std::numeric_limits<Poco::UInt64>::max()
+		? targetDeadline + 1 : std::numeric_limits<Poco::UInt64>::max()}
+{
+}
+
+bool Burst::DeadlineThreshold::isImproving(const Poco::UInt64 deadline) const
+{
+	return deadline < bound_.load(std::memory_order_relaxed);
+}
+
+bool Burst::DeadlineThreshold::improve(const Poco::UInt64 deadline)
+{
+	auto bound = bound_.load(std::memory_order_relaxed);
+
+	while (deadline < bound)
+		if (bound_.compare_exchange_weak(bound, deadline, std::memory_order_relaxed))
+			return true;
+
+	return false;
+}
+
+Poco::UInt64 Burst::DeadlineThreshold::getTargetLimit(const Poco::UInt64 baseTarget) const
+{
+	return toTargetLimit(bound_.load(std::memory_order_relaxed), baseTarget);
+}
+
+Poco::UInt64 Burst::DeadlineThreshold::toTargetLimit(const Poco::UInt64 deadline, const Poco::UInt64 baseTarget)
+{
+	// deadline = target / baseTarget < bound <=> target < bound * baseTarget
+	if (baseTarget == 0 || deadline > std::numeric_limits<Poco::UInt64>::max() / baseTarget)
+		return std::numeric_limits<Poco::UInt64>::max();
+
+	return deadline * baseTarget;
+}
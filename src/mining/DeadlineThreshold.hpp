@@ -0,0 +1,77 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <atomic>
+#include <Poco/Types.h>
+
+namespace Burst
+{
+	/**
+	 * \brief The deadline, that a new deadline of an account has to beat in the current round.
+	 * It starts at the target deadline and is lowered by every found deadline.
+	 * All functions are lock-free, so the verifiers can ask it for every nonce.
+	 */
+	class DeadlineThreshold
+	{
+	public:
+		/**
+		 * \brief Constructor.
+		 * \param targetDeadline The max. deadline, that is accepted, 0 if there is no limit.
+		 */
+		explicit DeadlineThreshold(Poco::UInt64 targetDeadline = 0);
+
+		/**
+		 * \brief Checks if a deadline would be an improvement.
+		 * \param deadline The deadline.
+		 * \return true, if the deadline is lower than the best one and not above the target deadline.
+		 */
+		bool isImproving(Poco::UInt64 deadline) const;
+
+		/**
+		 * \brief Lowers the threshold to the deadline, if it is an improvement.
+		 * \param deadline The deadline.
+		 * \return true, if the deadline was an improvement, false otherwise.
+		 */
+		bool improve(Poco::UInt64 deadline);
+
+		/**
+		 * \brief Returns the threshold as a limit for the raw 64 bit hash target (deadline = target / base target).
+		 * A target is only improving, when it is lower than the limit.
+		 * \param baseTarget The base target of the round.
+		 * \return The target limit.
+		 */
+		Poco::UInt64 getTargetLimit(Poco::UInt64 baseTarget) const;
+
+		/**
+		 * \brief Converts a deadline bound to a limit for the raw 64 bit hash target.
+		 * \param deadline Every deadline lower than this one passes the limit.
+		 * \param baseTarget The base target of the round.
+		 * \return The target limit.
+		 */
+		static Poco::UInt64 toTargetLimit(Poco::UInt64 deadline, Poco::UInt64 baseTarget);
+
+	private:
+		// every deadline has to be lower than this value
+		std::atomic<Poco::UInt64> bound_;
+	};
+}
@@ -26,7 +26,7 @@
 #include "MinerUtil.hpp"
 #include "network/Request.hpp"
 #include <Poco/Net/HTTPRequest.h>
-#include "network/NonceSubmitter.hpp"
+#include "network/AsyncHttpClient.hpp"
 #include <Poco/JSON/Parser.h>
 #include "plots/PlotSizes.hpp"
 #include "logging/Performance.hpp"
@@ -35,28 +35,57 @@
 #include <Poco/File.h>
 #include <Poco/Delegate.h>
 #include "plots/PlotVerifier.hpp"
+#include "plots/PlotDevice.hpp"
+#include "plots/PlotThroughput.hpp"
 #include "MinerCL.hpp"
+#include <numeric>
+#include <algorithm>
+#include <sstream>
 
 namespace Burst
 {
 	namespace MinerHelper
 	{
+		inline SubmitFunction create_submit_function(Miner& miner)
+		{
+			return [&miner](Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
+			                Poco::UInt64 blockheight, const std::string& plotFile,
+			                bool ownAccount)
+			{
+				miner.submitNonceAsync(nonce, accountId, deadline, blockheight, plotFile, ownAccount);
+			};
+		}
+
 		template <typename T>
 		void create_worker_default(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
-			const size_t size, Miner& miner, Poco::NotificationQueue& queue, std::shared_ptr<PlotReadProgress> progress)
+			const size_t size, Miner& miner, VerificationScheduler& scheduler, std::shared_ptr<PlotReadProgress> progress)
 		{
 			thread_pool = std::make_unique<Poco::ThreadPool>(1, static_cast<int>(size));
 			task_manager = std::make_unique<Poco::TaskManager>(*thread_pool);
 
-			auto submitFunction = [&miner](Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
-			                               Poco::UInt64 blockheight, const std::string& plotFile,
-			                               bool ownAccount)
-			{
-				miner.submitNonceAsync(make_tuple(nonce, accountId, deadline, blockheight, plotFile, ownAccount));
-			};
+			const auto submitFunction = create_submit_function(miner);
 
 			for (size_t i = 0; i < size; ++i)
-				task_manager->start(new T(miner.getData(), queue, progress, submitFunction));
+				task_manager->start(new T(miner.getData(), scheduler, progress, submitFunction));
+		}
+
+		template <typename T>
+		void create_worker_cpu(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
+			const size_t size, Miner& miner, VerificationScheduler& scheduler, std::shared_ptr<PlotReadProgress> progress)
+		{
+			create_worker_default<T>(thread_pool, task_manager, size, miner, scheduler, progress);
+
+			// the readers can verify their chunks with the same algorithm (the cpu algorithms need no stream)
+			if (MinerConfig::getConfig().isUsingFusedVerification())
+			{
+				const auto submitFunction = create_submit_function(miner);
+
+				scheduler.setFusedVerifier([&miner, progress, submitFunction](VerifyNotification::Ptr notification,
+					const std::function<bool()>& cancelled)
+				{
+					T::verify(notification, miner.getData(), progress.get(), submitFunction, cancelled, nullptr);
+				});
+			}
 		}
 
 		template <typename T, typename ...Args>
@@ -73,7 +102,7 @@ namespace Burst
 }
 
 Burst::Miner::Miner()
-	: submitNonceAsync{this, &Miner::submitNonceAsyncImpl}
+	: submissionScheduler_{*this}
 {}
 
 Burst::Miner::~Miner() = default;
@@ -89,7 +118,6 @@ void Burst::Miner::run()
 	progressVerify_->progressChanged.add(Poco::delegate(this, &Miner::progressChanged));
 
 	auto& config = MinerConfig::getConfig();
-	auto errors = 0u;
 
 	if (config.getPoolUrl().empty() &&
 		config.getMiningInfoUrl().empty() &&
@@ -106,12 +134,12 @@ void Burst::Miner::run()
 	// only create the thread pools and manager for mining if there is work to do (plot files)
 	if (!config.getPlotFiles().empty())
 	{
-		// manager
-		nonceSubmitterManager_ = std::make_unique<Poco::TaskManager>();
+		// the readers and verifiers are not running yet, so the queues can be switched
+		verificationScheduler_.setWorkStealing(config.isUsingWorkStealing());
 
 		// create the plot readers
 		MinerHelper::create_worker<PlotReader>(plot_reader_pool_, plot_reader_, MinerConfig::getConfig().getMaxPlotReaders(),
-			data_, progressRead_, verificationQueue_, plotReadQueue_);
+			data_, progressRead_, verificationScheduler_, plotReadQueue_);
 
 		// create the plot verifiers
 		createPlotVerifiers();
@@ -147,38 +175,48 @@ void Burst::Miner::run()
 
 	running_ = true;
 
-	miningInfoSession_ = MinerConfig::getConfig().createSession(HostType::MiningInfo);
-	miningInfoSession_->setKeepAlive(true);
+	submissionScheduler_.start(config.getMaxSubmissionsInFlight());
+
+	miningInfoSources_.clear();
+
+	for (const auto& url : config.getMiningInfoUrls())
+		miningInfoSources_.emplace_back(new MiningInfoSource(url));
+
+	if (!config.getMiningInfoPushUrl().empty())
+	{
+		miningInfoPush_ = std::make_unique<MiningInfoPush>(config.getMiningInfoPushUrl(), [this](const std::string& miningInfo)
+		{
+			Poco::UInt64 blockheight;
+			bool started;
+			processMiningInfo(miningInfo, "push", blockheight, started);
+		});
+
+		miningInfoPush_->start();
+	}
 
 	// TODO REWORK
 	//wallet_.getLastBlock(currentBlockHeight_);
 
 	log_information(MinerLogger::miner, "Looking for mining info...");
 
-	while (running_)
-	{
-		if (getMiningInfo())
-			errors = 0;
-		else
-		{
-			++errors;
-			log_debug(MinerLogger::miner, "Could not get mining infos %u/5 times...", errors);
-		}
+	// all sources race each other, the first one with a new block starts it
+	std::vector<std::thread> miningInfoPollers;
 
-		// we have a tollerance of 5 times of not being able to fetch mining infos, before its a real error
-		if (errors >= 5)
-		{
-			// reset error-counter and show error-message in console
-			log_error(MinerLogger::miner, "Could not get block infos!");
-			errors = 0;
-		}
+	for (size_t i = 1; i < miningInfoSources_.size(); ++i)
+		miningInfoPollers.emplace_back(&Miner::pollMiningInfo, this, std::ref(*miningInfoSources_[i]));
 
-		std::this_thread::sleep_for(std::chrono::seconds(MinerConfig::getConfig().getMiningInfoInterval()));
-	}
+	pollMiningInfo(*miningInfoSources_.front());
+
+	for (auto& poller : miningInfoPollers)
+		poller.join();
+
+	if (miningInfoPush_ != nullptr)
+		miningInfoPush_->stop();
 
 	if (wakeUpTime > 0)
 		wake_up_timer_.stop();
 
+	submissionScheduler_.stop();
 	running_ = false;
 }
 
@@ -192,9 +230,15 @@ void Burst::Miner::stop()
 
 	// stop verifier
 	if (verifier_ != nullptr)
-		shut_down_worker(*verifier_pool_, *verifier_, verificationQueue_);
-	
-	running_ = false;
+		shut_down_worker(*verifier_pool_, *verifier_, verificationScheduler_);
+
+	// under the wait mutex, so a poller can not miss the wake up between its check and its wait
+	{
+		std::lock_guard<std::mutex> lock(miningInfoWaitMutex_);
+		running_ = false;
+	}
+
+	miningInfoWakeUp_.notify_all();
 }
 
 void Burst::Miner::restart()
@@ -204,6 +248,23 @@ void Burst::Miner::restart()
 }
 
 void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
+{
+	std::vector<PlotReadNotification::Ptr> notifications;
+
+	if (MinerConfig::getConfig().getPlotReaderScheduling() == PlotReaderScheduling::Device)
+		createPlotReadNotificationsByDevice(wakeUpCall, notifications);
+	else
+		createPlotReadNotificationsByDir(wakeUpCall, notifications);
+
+	// a wake up call reads only some bytes, there is nothing to schedule
+	if (!wakeUpCall)
+		schedulePlotReadNotifications(notifications);
+
+	for (auto& notification : notifications)
+		plotReadQueue_.enqueueNotification(notification);
+}
+
+void Burst::Miner::createPlotReadNotificationsByDir(bool wakeUpCall, std::vector<PlotReadNotification::Ptr>& notifications)
 {
 	const auto initPlotReadNotification = [this, wakeUpCall](PlotDir& plotDir)
 	{
@@ -222,14 +283,14 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 		return notification;
 	};
 
-	const auto addParallel = [this, &initPlotReadNotification](PlotDir& plotDir, std::shared_ptr<PlotFile> plotFile)
+	const auto addParallel = [&notifications, &initPlotReadNotification](PlotDir& plotDir, std::shared_ptr<PlotFile> plotFile)
 	{
 		auto plotRead = initPlotReadNotification(plotDir);
 		plotRead->plotList.emplace_back(plotFile);
-		plotReadQueue_.enqueueNotification(plotRead);
+		notifications.emplace_back(plotRead);
 	};
 
-	MinerConfig::getConfig().forPlotDirs([this, &addParallel, &initPlotReadNotification](PlotDir& plotDir)
+	MinerConfig::getConfig().forPlotDirs([&notifications, &addParallel, &initPlotReadNotification](PlotDir& plotDir)
 	{
 		if (plotDir.getType() == PlotDir::Type::Parallel)
 		{
@@ -248,13 +309,152 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 			for (const auto& relatedPlotDir : plotDir.getRelatedDirs())
 				plotRead->relatedPlotLists.emplace_back(relatedPlotDir->getPath(), relatedPlotDir->getPlotfiles());
 
-			plotReadQueue_.enqueueNotification(plotRead);
+			notifications.emplace_back(plotRead);
 		}
 
 		return true;
 	});
 }
 
+void Burst::Miner::createPlotReadNotificationsByDevice(bool wakeUpCall, std::vector<PlotReadNotification::Ptr>& notifications)
+{
+	std::vector<PlotDevice> devices;
+
+	MinerConfig::getConfig().forPlotDirs([&devices](PlotDir& plotDir)
+	{
+		PlotDevice::addPlotDir(devices, plotDir);
+		return true;
+	});
+
+	const auto nonRotationalReaders = MinerConfig::getConfig().getNonRotationalReaders();
+	const auto dirProgress = std::make_shared<PlotDirProgress>();
+	std::stringstream devicesInfo;
+
+	for (const auto& device : devices)
+	{
+		const auto readers = std::min<size_t>(device.getMaxReaders(nonRotationalReaders), device.plotFiles.size());
+
+		devicesInfo << "\n\t" << device.name << " (" << (device.rotational ? "rotational" : "non-rotational");
+
+		if (device.disks > 1)
+			devicesInfo << ", " << device.disks << " disks";
+
+		devicesInfo << "): " << device.plotFiles.size() << " files, " << readers << (readers == 1 ? " reader" : " readers");
+
+		if (readers == 0)
+			continue;
+
+		std::vector<PlotReadNotification::Ptr> deviceNotifications;
+		std::vector<Poco::UInt64> notificationBytes(readers, 0);
+
+		for (size_t i = 0; i < readers; ++i)
+		{
+			PlotReadNotification::Ptr notification = new PlotReadNotification;
+			notification->dir = device.name;
+			notification->gensig = getGensig();
+			notification->scoopNum = getScoopNum();
+			notification->blockheight = getBlockheight();
+			notification->baseTarget = getBaseTarget();
+			notification->type = PlotDir::Type::Sequential;
+			notification->wakeUpCall = wakeUpCall;
+			notification->dirProgress = dirProgress;
+			deviceNotifications.emplace_back(notification);
+		}
+
+		// the biggest plot files first, always to the reader with the fewest bytes to read,
+		// so all readers of a device are done at the same time
+		std::vector<size_t> order(device.plotFiles.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&device](const size_t lhs, const size_t rhs)
+		{
+			return device.plotFiles[lhs]->getSize() > device.plotFiles[rhs]->getSize();
+		});
+
+		for (const auto index : order)
+		{
+			const auto& plotFile = device.plotFiles[index];
+			const auto reader = std::distance(notificationBytes.begin(),
+				std::min_element(notificationBytes.begin(), notificationBytes.end()));
+
+			deviceNotifications[reader]->plotList.emplace_back(plotFile);
+			notificationBytes[reader] += plotFile->getSize();
+			dirProgress->addPlotFile(device.plotFileDirs[index], plotFile->getPath());
+			accounts_.getAccount(plotFile->getAccountId(), wallet_, true);
+		}
+
+		notifications.insert(notifications.end(), deviceNotifications.begin(), deviceNotifications.end());
+	}
+
+	// the devices are only logged, when they changed (e.g. after a rescan)
+	if (devicesInfo.str() != plotDevices_)
+	{
+		plotDevices_ = devicesInfo.str();
+		log_system(MinerLogger::miner, "Plot devices:%s", plotDevices_);
+	}
+}
+
+void Burst::Miner::schedulePlotReadNotifications(std::vector<PlotReadNotification::Ptr>& notifications)
+{
+	// dirs and devices without a history are assumed to be as slow as the slowest known one
+	const auto slowest = PlotThroughput::getSlowest();
+	std::vector<std::pair<double, PlotReadNotification::Ptr>> expected;
+	auto predictable = slowest > 0;
+
+	for (auto& notification : notifications)
+	{
+		Poco::UInt64 bytes = 0;
+
+		for (const auto& plotFile : notification->plotList)
+			bytes += plotFile->getSize();
+
+		for (const auto& relatedPlotList : notification->relatedPlotLists)
+			for (const auto& plotFile : relatedPlotList.second)
+				bytes += plotFile->getSize();
+
+		const auto scoopBytes = static_cast<double>(bytes / Settings::PlotSize * Settings::ScoopSize);
+		auto bytesPerSecond = PlotThroughput::get(notification->dir);
+
+		if (bytesPerSecond <= 0)
+			bytesPerSecond = slowest;
+
+		// without any history, the biggest dirs are read first
+		expected.emplace_back(predictable ? scoopBytes / bytesPerSecond : scoopBytes, notification);
+	}
+
+	// the longest expected read time first, so the slowest dirs and devices don't delay the end of the round
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const std::pair<double, PlotReadNotification::Ptr>& lhs, const std::pair<double, PlotReadNotification::Ptr>& rhs)
+		{
+			return lhs.first > rhs.first;
+		});
+
+	for (size_t i = 0; i < expected.size(); ++i)
+		notifications[i] = expected[i].second;
+
+	if (!predictable || expected.empty())
+		return;
+
+	// the predicted round time is the time, until the last reader is done
+	// (every reader takes the next notification, when it is done with the current one)
+	size_t readers = MinerConfig::getConfig().getMaxPlotReaders(true);
+
+	if (readers == 0 || readers > expected.size())
+		readers = expected.size();
+
+	std::vector<double> readerTimes(readers, 0);
+
+	for (const auto& notification : expected)
+		*std::min_element(readerTimes.begin(), readerTimes.end()) += notification.first;
+
+	const auto predicted = *std::max_element(readerTimes.begin(), readerTimes.end());
+	const auto block = data_.getBlockData();
+
+	if (block != nullptr)
+		block->setPredictedRoundTime(predicted);
+
+	log_debug(MinerLogger::miner, "Predicted round time: %ss", Poco::NumberFormatter::format(predicted, 3));
+}
+
 bool Burst::Miner::wantRestart() const
 {
 	return restart_;
@@ -271,11 +471,11 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 	if (!MinerConfig::getConfig().getPlotFiles().empty())
 	{
 		log_debug(MinerLogger::miner, "Plot-read-queue: %d (%d reader), verification-queue: %d (%d verifier)",
-			plotReadQueue_.size(), plot_reader_->count(), verificationQueue_.size(), verifier_->count());
+			plotReadQueue_.size(), plot_reader_->count(), verificationScheduler_.size(), verifier_->count());
 		log_debug(MinerLogger::miner, "Allocated memory: %s", memToString(PlotReader::globalBufferSize.getSize(), 1));
 	
 		START_PROBE("Miner.SetBuffersize")
-		PlotReader::globalBufferSize.setMax(MinerConfig::getConfig().getMaxBufferSize());
+		allocateBuffers();
 		TAKE_PROBE("Miner.SetBuffersize")
 	}
 	
@@ -301,9 +501,9 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 	}
 
 	// Set total run time of previous block
-	if (startPoint_.time_since_epoch().count() > 0)
+	if (startPoint_ > 0)
 	{
-		const auto timeDiff = std::chrono::high_resolution_clock::now() - startPoint_;
+		const auto timeDiff = std::chrono::high_resolution_clock::now() - getStartPoint();
 		const auto timeDiffSeconds = std::chrono::duration_cast<std::chrono::seconds>(timeDiff);
 		log_unimportant(MinerLogger::miner, "Block %s ended in %s", numberToString(blockHeight - 1),
 			deadlineFormat(timeDiffSeconds.count()));
@@ -315,6 +515,28 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 	block->refreshBlockEntry();
 	setIsProcessing(true);
 
+	// deadlines of the last block are not sent anymore
+	submissionScheduler_.cancel(blockHeight);
+
+	// the mining info is polled faster, when the next block is expected
+	{
+		auto blockTimes = 0.0;
+		auto blocks = 0u;
+
+		for (const auto& historicalBlock : data_.getAllHistoricalBlockData())
+			if (historicalBlock->getBlockTime() > 0)
+			{
+				blockTimes += historicalBlock->getBlockTime();
+				++blocks;
+			}
+
+		// without a history the target block time of the network (4 minutes) is expected
+		expectedBlockTime_ = blocks > 0 ? blockTimes / blocks : 240;
+	}
+
+	// the connection for the first deadline of the round is opened while the plot files are read
+	AsyncHttpClient::instance().warmUp(MinerConfig::getConfig().getPoolUrl());
+
 	// printing block info and transfer it to local server
 	{
 		const auto difficulty = block->getDifficulty();
@@ -353,7 +575,7 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 
 	PlotSizes::nextRound();
 	PlotSizes::refresh(Poco::Net::IPAddress{"127.0.0.1"});
-	startPoint_ = std::chrono::high_resolution_clock::now();
+	startPoint_ = std::chrono::high_resolution_clock::now().time_since_epoch().count();
 
 	addPlotReadNotifications();
 
@@ -469,6 +691,18 @@ Burst::SubmitResponse Burst::Miner::addNewDeadline(Poco::UInt64 nonce, Poco::UIn
 
 Burst::NonceConfirmation Burst::Miner::submitNonce(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline, Poco::UInt64 blockheight, const std::string& plotFile,
 	bool ownAccount, const std::string& minerName, Poco::UInt64 plotsize)
+{
+	return queueNonce(nonce, accountId, deadline, blockheight, plotFile, ownAccount, minerName, plotsize).get();
+}
+
+void Burst::Miner::submitNonceAsync(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline, Poco::UInt64 blockheight,
+	const std::string& plotFile, bool ownAccount)
+{
+	queueNonce(nonce, accountId, deadline, blockheight, plotFile, ownAccount);
+}
+
+std::future<Burst::NonceConfirmation> Burst::Miner::queueNonce(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
+	Poco::UInt64 blockheight, const std::string& plotFile, bool ownAccount, const std::string& minerName, Poco::UInt64 plotsize)
 {
 	std::shared_ptr<Deadline> newDeadline;
 
@@ -484,7 +718,7 @@ Burst::NonceConfirmation Burst::Miner::submitNonce(Poco::UInt64 nonce, Poco::UIn
 			newDeadline->setTotalPlotsize(plotsize);
 
 		newDeadline->onTheWay();
-		return NonceSubmitter{ *this, newDeadline }.submit();
+		return submissionScheduler_.submit(newDeadline);
 	}
 
 	NonceConfirmation nonceConfirmation;
@@ -494,126 +728,232 @@ Burst::NonceConfirmation Burst::Miner::submitNonce(Poco::UInt64 nonce, Poco::UIn
 		deadlineFormat(deadline), deadlineFormat(deadline));
 	nonceConfirmation.errorCode = result;
 
-	return nonceConfirmation;
+	std::promise<NonceConfirmation> promise;
+	promise.set_value(nonceConfirmation);
+	return promise.get_future();
+}
+
+void Burst::Miner::pollMiningInfo(MiningInfoSource& source)
+{
+	const auto& config = MinerConfig::getConfig();
+	auto errors = 0u;
+
+	while (running_)
+	{
+		const auto requestStart = std::chrono::steady_clock::now();
+
+		if (getMiningInfo(source))
+		{
+			errors = 0;
+
+			// a long poll that was held by the pool is followed by the next one immediately
+			if (config.isMiningInfoLongPoll() &&
+				std::chrono::steady_clock::now() - requestStart >= std::chrono::milliseconds{config.getMiningInfoMinInterval()})
+				continue;
+		}
+		else
+		{
+			++errors;
+			log_debug(MinerLogger::miner, "Could not get mining infos from %s %u/5 times...", source.getUrl().getCanonical(true), errors);
+		}
+
+		// we have a tollerance of 5 times of not being able to fetch mining infos, before its a real error
+		if (errors >= 5)
+		{
+			// reset error-counter and show error-message in console
+			log_error(MinerLogger::miner, "Could not get block infos from %s!", source.getUrl().getCanonical(true));
+			errors = 0;
+		}
+
+		auto wait = getMiningInfoWait();
+
+		// a failing or lagging source is only a fallback for the others
+		if (miningInfoSources_.size() > 1 && source.isDemoted())
+			wait = std::max(wait, std::chrono::milliseconds{config.getMiningInfoInterval() * 4000ull});
+
+		std::unique_lock<std::mutex> lock(miningInfoWaitMutex_);
+		miningInfoWakeUp_.wait_for(lock, wait, [this]() { return !running_; });
+	}
 }
 
-bool Burst::Miner::getMiningInfo()
+bool Burst::Miner::getMiningInfo(MiningInfoSource& source)
 {
-	using namespace Poco::Net;
 	poco_ndc(Miner::getMiningInfo);
 
-	if (miningInfoSession_ == nullptr && !MinerConfig::getConfig().getMiningInfoUrl().empty())
-		miningInfoSession_ = MinerConfig::getConfig().getMiningInfoUrl().createSession();
+	std::string miningInfo;
+	const auto result = source.request(getBlockheight(), miningInfo);
 
-	Request request(std::move(miningInfoSession_));
+	if (result == MiningInfoSource::Result::Error)
+		return false;
 
-	HTTPRequest requestData { HTTPRequest::HTTP_GET, "/burst?requestType=getMiningInfo", HTTPRequest::HTTP_1_1 };
-	requestData.setKeepAlive(true);
+	if (result == MiningInfoSource::Result::Unchanged)
+		return true;
 
-	auto response = request.send(requestData);
-	std::string responseData;
+	Poco::UInt64 blockheight;
+	bool started;
 
-	if (response.receive(responseData))
+	if (!processMiningInfo(miningInfo, source.getUrl().getCanonical(true), blockheight, started))
 	{
+		source.onError();
+		return false;
+	}
+
+	// the lag is measured from the time the block was started by another source
+	if (blockheight > 0 && blockheight == getBlockheight())
+		source.onBlock(blockheight, started, getStartPoint());
+
+	return true;
+}
+
+bool Burst::Miner::processMiningInfo(const std::string& miningInfo, const std::string& source, Poco::UInt64& blockheight,
+	bool& started)
+{
+	poco_ndc(Miner::processMiningInfo);
+
+	// all sources can deliver a new block at the same time, only the first one starts it
+	std::lock_guard<std::mutex> lock(miningInfoMutex_);
+
+	blockheight = 0;
+	started = false;
+
+	try
+	{
+		Poco::JSON::Parser parser;
+		Poco::JSON::Object::Ptr root;
+
 		try
 		{
-			if (responseData.empty())
-				return false;
+			root = parser.parse(miningInfo).extract<Poco::JSON::Object::Ptr>();
+		}
+		catch (...)
+		{
+			return false;
+		}
 
-			HttpResponse httpResponse(responseData);
-			Poco::JSON::Parser parser;
-			Poco::JSON::Object::Ptr root;
+		std::string gensig;
 
-			try
-			{
-				root = parser.parse(httpResponse.getMessage()).extract<Poco::JSON::Object::Ptr>();
-			}
-			catch (...)
+		if (root->has("height"))
+		{
+			const std::string newBlockHeightStr = root->get("height");
+			const auto newBlockHeight = std::stoull(newBlockHeightStr);
+			blockheight = newBlockHeight;
+
+			if (data_.getBlockData() == nullptr ||
+				newBlockHeight > data_.getBlockData()->getBlockheight())
 			{
-				return false;
-			}
+				std::string baseTargetStr;
 
-			std::string gensig;
+				if (root->has("baseTarget"))
+					baseTargetStr = root->get("baseTarget").convert<std::string>();
 
-			if (root->has("height"))
-			{
-				const std::string newBlockHeightStr = root->get("height");
-				const auto newBlockHeight = std::stoull(newBlockHeightStr);
+				// parsed before anything is changed, an invalid base target throws
+				const auto baseTarget = std::stoull(baseTargetStr);
+
+				if (root->has("generationSignature"))
+					gensig = root->get("generationSignature").convert<std::string>();
 
-				if (data_.getBlockData() == nullptr ||
-					newBlockHeight > data_.getBlockData()->getBlockheight())
+				if (root->has("targetDeadline"))
 				{
-					std::string baseTargetStr;
+					// remember the current pool target deadline
+					auto target_deadline_pool_before = MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool);
 
-					if (root->has("baseTarget"))
-						baseTargetStr = root->get("baseTarget").convert<std::string>();
+					// get the target deadline from pool
+					auto target_deadline_pool_json = root->get("targetDeadline");
+					Poco::UInt64 target_deadline_pool = 0;
+					
+					// update the new pool target deadline
+					if (!target_deadline_pool_json.isEmpty())
+						target_deadline_pool = target_deadline_pool_json.convert<Poco::UInt64>();
 
-					if (root->has("generationSignature"))
-						gensig = root->get("generationSignature").convert<std::string>();
+					MinerConfig::getConfig().setTargetDeadline(target_deadline_pool, TargetDeadlineType::Pool);
 
-					if (root->has("targetDeadline"))
+					// if its changed, print it
+					if (MinerConfig::getConfig().getSubmitProbability() == 0.)
 					{
-						// remember the current pool target deadline
-						auto target_deadline_pool_before = MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool);
-
-						// get the target deadline from pool
-						auto target_deadline_pool_json = root->get("targetDeadline");
-						Poco::UInt64 target_deadline_pool = 0;
-						
-						// update the new pool target deadline
-						if (!target_deadline_pool_json.isEmpty())
-							target_deadline_pool = target_deadline_pool_json.convert<Poco::UInt64>();
-
-						MinerConfig::getConfig().setTargetDeadline(target_deadline_pool, TargetDeadlineType::Pool);
-
-						// if its changed, print it
-						if (MinerConfig::getConfig().getSubmitProbability() == 0.)
-						{
-							if (target_deadline_pool_before != MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool))
-								log_system(MinerLogger::config,
-									"got new target deadline from pool\n"
-									"\told pool target deadline:    %s\n"
-									"\tnew pool target deadline:    %s\n"
-									"\ttarget deadline from config: %s\n"
-									"\tlowest target deadline:      %s",
-									deadlineFormat(target_deadline_pool_before),
-									deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool)),
-									deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Local)),
-									deadlineFormat(MinerConfig::getConfig().getTargetDeadline()));
-						}
-						else {
-							if (target_deadline_pool_before != MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool))
-								log_system(MinerLogger::config,
-									"got new target deadline from pool\n"
-									"\told pool target deadline:    %s\n"
-									"\tnew pool target deadline:    %s",
-									deadlineFormat(target_deadline_pool_before),
-									deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool)));
-						}
+						if (target_deadline_pool_before != MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool))
+							log_system(MinerLogger::config,
+								"got new target deadline from pool\n"
+								"\told pool target deadline:    %s\n"
+								"\tnew pool target deadline:    %s\n"
+								"\ttarget deadline from config: %s\n"
+								"\tlowest target deadline:      %s",
+								deadlineFormat(target_deadline_pool_before),
+								deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool)),
+								deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Local)),
+								deadlineFormat(MinerConfig::getConfig().getTargetDeadline()));
 					}
+					else {
+						if (target_deadline_pool_before != MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool))
+							log_system(MinerLogger::config,
+								"got new target deadline from pool\n"
+								"\told pool target deadline:    %s\n"
+								"\tnew pool target deadline:    %s",
+								deadlineFormat(target_deadline_pool_before),
+								deadlineFormat(MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool)));
+					}
+				}
+
+				log_debug(MinerLogger::miner, "Block %s detected by %s", numberToString(newBlockHeight), source);
+				updateGensig(gensig, newBlockHeight, baseTarget);
+				started = true;
+
+				if (miningInfoSources_.size() > 1)
+				{
+					std::string statistics;
 
-					updateGensig(gensig, newBlockHeight, std::stoull(baseTargetStr));
+					for (const auto& miningInfoSource : miningInfoSources_)
+						statistics += "\n\t" + miningInfoSource->getStatistics();
+
+					log_unimportant(MinerLogger::miner, "Mining info sources:%s", statistics);
 				}
 			}
-
-			transferSession(response, miningInfoSession_);
-			return true;
-		}
-		catch (Poco::Exception& exc)
-		{
-			log_error(MinerLogger::miner, "Error on getting new block-info!\n\t%s", exc.displayText());
-			// because the full response may be too long, we only log the it in the logfile
-			log_file_only(MinerLogger::miner, Poco::Message::PRIO_ERROR, TextType::Error, "Block-info full response:\n%s", responseData);
-			log_current_stackframe(MinerLogger::miner);
 		}
-	}
 
-	transferSession(request, miningInfoSession_);
-	transferSession(response, miningInfoSession_);
+		return true;
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::miner, "Error on getting new block-info!\n\t%s", exc.displayText());
+		// because the full response may be too long, we only log the it in the logfile
+		log_file_only(MinerLogger::miner, Poco::Message::PRIO_ERROR, TextType::Error, "Block-info full response:\n%s", miningInfo);
+		log_current_stackframe(MinerLogger::miner);
+	}
+	// std::stoull throws on an empty or non-numeric height or base target
+	catch (std::exception& exc)
+	{
+		log_error(MinerLogger::miner, "Error on getting new block-info!\n\t%s", std::string(exc.what()));
+		log_file_only(MinerLogger::miner, Poco::Message::PRIO_ERROR, TextType::Error, "Block-info full response:\n%s", miningInfo);
+	}
 
 	return false;
 }
 
+std::chrono::high_resolution_clock::time_point Burst::Miner::getStartPoint() const
+{
+	return std::chrono::high_resolution_clock::time_point{std::chrono::high_resolution_clock::duration{startPoint_.load()}};
+}
+
+std::chrono::milliseconds Burst::Miner::getMiningInfoWait() const
+{
+	const auto& config = MinerConfig::getConfig();
+	const std::chrono::milliseconds maxWait{config.getMiningInfoInterval() * 1000ull};
+	const auto minWait = std::min(std::chrono::milliseconds{config.getMiningInfoMinInterval()}, maxWait);
+
+	// the push delivers the blocks, the poll is only the fallback
+	if (miningInfoPush_ != nullptr && miningInfoPush_->isConnected())
+		return maxWait;
+
+	if (expectedBlockTime_ <= 0 || startPoint_ == 0)
+		return maxWait;
+
+	// the first half of the expected block time is polled with the normal interval, then the
+	// interval shrinks down to the min. interval, which is kept until the block arrives
+	const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - getStartPoint()).count();
+	const auto progress = std::max(0.0, std::min(1.0, 2.0 * elapsed / expectedBlockTime_ - 1.0));
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(maxWait - (maxWait - minWait) * progress);
+}
+
 void Burst::Miner::shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager, Poco::NotificationQueue& queue) const
 {
 	Poco::Mutex::ScopedLock lock(worker_mutex_);
@@ -623,13 +963,23 @@ void Burst::Miner::shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskMan
 	thread_pool.joinAll();
 }
 
+void Burst::Miner::shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
+	VerificationScheduler& scheduler) const
+{
+	Poco::Mutex::ScopedLock lock(worker_mutex_);
+	scheduler.wakeUpAll();
+	task_manager.cancelAll();
+	thread_pool.stopAll();
+	thread_pool.joinAll();
+}
+
 namespace Burst
 {
 	std::mutex progressMutex_;
 	Progress progress_;
 
 	void showProgress(PlotReadProgress& progressRead, PlotReadProgress& progressVerify, MinerData& data, Poco::UInt64 blockheight,
-		std::chrono::high_resolution_clock::time_point& startPoint, std::function<void(Poco::UInt64, double)> blockProcessed)
+		const std::chrono::high_resolution_clock::time_point& startPoint, std::function<void(Poco::UInt64, double)> blockProcessed)
 	{
 		std::lock_guard<std::mutex> lock(progressMutex_);
 
@@ -666,7 +1016,7 @@ namespace Burst
 
 void Burst::Miner::progressChanged(float &progress)
 {
-	showProgress(*progressRead_, *progressVerify_, getData(), getBlockheight(), startPoint_,
+	showProgress(*progressRead_, *progressVerify_, getData(), getBlockheight(), getStartPoint(),
 	             [this](Poco::UInt64 blockHeight, double roundTime) { onRoundProcessed(blockHeight, roundTime); });
 }
 
@@ -699,25 +1049,17 @@ void Burst::Miner::onRoundProcessed(Poco::UInt64 blockHeight, double roundTime)
 
 	block->setRoundTime(roundTime);
 	const auto bestDeadline = block->getBestDeadline(BlockData::DeadlineSearchType::Found);
+	const auto predictedRoundTime = block->getPredictedRoundTime();
 
 	log_information(MinerLogger::miner, "Processed block %s\n"
-		"\tround time:     %ss\n"
+		"\tround time:     %ss (predicted: %s)\n"
 		"\tbest deadline:  %s",
 		numberToString(block->getBlockheight()),
 		Poco::NumberFormatter::format(roundTime, 3),
+		predictedRoundTime > 0 ? Poco::NumberFormatter::format(predictedRoundTime, 3) + "s" : std::string("unknown"),
 		bestDeadline == nullptr ? "none" : deadlineFormat(bestDeadline->getDeadline()));
-}
 
-Burst::NonceConfirmation Burst::Miner::submitNonceAsyncImpl(const std::tuple<Poco::UInt64, Poco::UInt64, Poco::UInt64, Poco::UInt64, std::string, bool>& data)
-{
-	const auto nonce = std::get<0>(data);
-	const auto accountId = std::get<1>(data);
-	const auto deadline = std::get<2>(data);
-	const auto blockheight = std::get<3>(data);
-	const auto& plotFile = std::get<4>(data);
-	const auto ownAccount = std::get<5>(data);
-
-	return submitNonce(nonce, accountId, deadline, blockheight, plotFile, ownAccount);
+	PlotThroughput::save();
 }
 
 std::shared_ptr<Burst::Deadline> Burst::Miner::getBestSent(Poco::UInt64 accountId, Poco::UInt64 blockHeight)
@@ -762,12 +1104,15 @@ void Burst::Miner::createPlotVerifiers()
 	auto cpuInstructionSet = MinerConfig::getConfig().getCpuInstructionSet();
 	auto forceCpu = false, fallback = false;
 	auto createWorker = [this](std::function<void(std::unique_ptr<Poco::ThreadPool>&, std::unique_ptr<Poco::TaskManager>&,
-	                                              size_t, Miner&, Poco::NotificationQueue&,
+	                                              size_t, Miner&, VerificationScheduler&,
 	                                              std::shared_ptr<PlotReadProgress>)> function) {
-		function(verifier_pool_, verifier_, MinerConfig::getConfig().getMiningIntensity(), *this, verificationQueue_,
+		function(verifier_pool_, verifier_, MinerConfig::getConfig().getMiningIntensity(), *this, verificationScheduler_,
 		         progressVerify_);
 	};
 
+	// only the cpu verifiers set a new fused verifier
+	verificationScheduler_.setFusedVerifier(nullptr);
+
 	if (processorType == "CUDA")
 	{
 		if (Settings::Cuda)
@@ -785,14 +1130,23 @@ void Burst::Miner::createPlotVerifiers()
 
 	if (processorType == "CPU" || forceCpu)
 	{
+		// run the fastest kernel, that is supported by the build and the cpu
+		if (cpuInstructionSet == "AUTO")
+		{
+			cpuInstructionSet = getCalibratedCpuInstructionSet();
+			Settings::setCpuInstructionSet(cpuInstructionSet);
+		}
+
 		if (cpuInstructionSet == "SSE4" && Settings::Sse4)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_sse4>);
+			createWorker(MinerHelper::create_worker_cpu<PlotVerifier_sse4>);
 		else if (cpuInstructionSet == "AVX" && Settings::Avx)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_avx>);
+			createWorker(MinerHelper::create_worker_cpu<PlotVerifier_avx>);
 		else if (cpuInstructionSet == "AVX2" && Settings::Avx2)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_avx2>);
+			createWorker(MinerHelper::create_worker_cpu<PlotVerifier_avx2>);
+		else if (cpuInstructionSet == "AVX512" && Settings::Avx512)
+			createWorker(MinerHelper::create_worker_cpu<PlotVerifier_avx512>);
 		else if (cpuInstructionSet == "SSE2")
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_sse2>);
+			createWorker(MinerHelper::create_worker_cpu<PlotVerifier_sse2>);
 		else
 			fallback = true;
 	}
@@ -807,7 +1161,7 @@ void Burst::Miner::createPlotVerifiers()
 			"As a fallback solution your CPU with the instruction set %s is used.", processorType, MinerConfig::getConfig().
 			getCpuInstructionSet(), cpuInstructionSet);
 		
-		createWorker(MinerHelper::create_worker_default<PlotVerifier_sse2>);
+		createWorker(MinerHelper::create_worker_cpu<PlotVerifier_sse2>);
 	}
 }
 
@@ -820,7 +1174,7 @@ void Burst::Miner::setMiningIntensity(unsigned intensity)
 	if (MinerConfig::getConfig().getMiningIntensity() == intensity)
 		return;
 
-	shut_down_worker(*verifier_pool_, *verifier_, verificationQueue_);
+	shut_down_worker(*verifier_pool_, *verifier_, verificationScheduler_);
 	MinerConfig::getConfig().setMininigIntensity(intensity);
 	createPlotVerifiers();
 }
@@ -837,13 +1191,29 @@ void Burst::Miner::setMaxPlotReader(unsigned max_reader)
 	shut_down_worker(*plot_reader_pool_, *plot_reader_, plotReadQueue_);
 	MinerConfig::getConfig().setMaxPlotReaders(max_reader);
 	MinerHelper::create_worker<PlotReader>(plot_reader_pool_, plot_reader_, MinerConfig::getConfig().getMaxPlotReaders(),
-		data_, progressRead_, verificationQueue_, plotReadQueue_);
+		data_, progressRead_, verificationScheduler_, plotReadQueue_);
 }
 
 void Burst::Miner::setMaxBufferSize(Poco::UInt64 size)
 {
 	MinerConfig::getConfig().setBufferSize(size);
-	PlotReader::globalBufferSize.setMax(size);
+	allocateBuffers();
+}
+
+void Burst::Miner::allocateBuffers()
+{
+	const auto maxBufferSize = MinerConfig::getConfig().getMaxBufferSize();
+	const auto bufferChunkCount = MinerConfig::getConfig().getBufferChunkCount();
+	Poco::UInt64 noncesPerChunk = 0;
+
+	// only a fixed buffer size is allocated in advance, an automatic one
+	// (depending on the plot size) grows with the first rounds
+	if (MinerConfig::getConfig().getMaxBufferSizeRaw() > 0 && bufferChunkCount > 0)
+		noncesPerChunk = maxBufferSize / bufferChunkCount / Settings::ScoopSize;
+
+	VerifyNotificationPool::instance().preallocate(bufferChunkCount, noncesPerChunk,
+		MinerConfig::getConfig().isUsingHugePages());
+	PlotReader::globalBufferSize.setMax(maxBufferSize);
 }
 
 void Burst::Miner::rescanPlotfiles()
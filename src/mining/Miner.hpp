@@ -24,13 +24,21 @@
 #include "Declarations.hpp"
 #include "Deadline.hpp"
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "wallet/Account.hpp"
 #include "wallet/Wallet.hpp"
 #include <Poco/TaskManager.h>
 #include "MinerData.hpp"
 #include <Poco/NotificationQueue.h>
 #include "WorkerList.hpp"
+#include "plots/VerificationScheduler.hpp"
+#include "plots/PlotReader.hpp"
 #include "network/Response.hpp"
+#include "network/SubmissionScheduler.hpp"
+#include "network/MiningInfoPush.hpp"
+#include "network/MiningInfoSource.hpp"
 #include <Poco/Timer.h>
 
 namespace Poco
@@ -72,9 +80,11 @@ namespace Burst
 		                              Poco::UInt64 blockheight, const std::string& plotFile,
 		                              bool ownAccount, const std::string& minerName = "", Poco::UInt64 plotsize = 0);
 
-		Poco::ActiveMethod<NonceConfirmation,
-		                   std::tuple<Poco::UInt64, Poco::UInt64, Poco::UInt64, Poco::UInt64, std::string, bool>,
-		                   Miner> submitNonceAsync;
+		/**
+		 * \brief Queues a found nonce for submission without waiting for the confirmation.
+		 */
+		void submitNonceAsync(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
+		                      Poco::UInt64 blockheight, const std::string& plotFile, bool ownAccount);
 
 		std::shared_ptr<Deadline> getBestSent(Poco::UInt64 accountId, Poco::UInt64 blockHeight);
 		std::shared_ptr<Deadline> getBestConfirmed(Poco::UInt64 accountId, Poco::UInt64 blockHeight);
@@ -90,31 +100,94 @@ namespace Burst
 		void setIsProcessing(bool isProc);
 
 	private:
-		bool getMiningInfo();
-		NonceConfirmation submitNonceAsyncImpl(
-			const std::tuple<Poco::UInt64, Poco::UInt64, Poco::UInt64, Poco::UInt64, std::string, bool>& data);
+		/**
+		 * \brief Polls a mining info source, until the miner stops.
+		 * \param source The source.
+		 */
+		void pollMiningInfo(MiningInfoSource& source);
+		bool getMiningInfo(MiningInfoSource& source);
+
+		/**
+		 * \brief Processes a mining info and starts a new block, if it is newer than the current one.
+		 * \param miningInfo The mining info (json).
+		 * \param source The source of the mining info (only for logging).
+		 * \param blockheight The height of the block in the mining info, 0 if there is none.
+		 * \param started true, if the block was started because of this mining info.
+		 * \return true, if the mining info was valid.
+		 */
+		bool processMiningInfo(const std::string& miningInfo, const std::string& source, Poco::UInt64& blockheight,
+		                       bool& started);
+
+		/**
+		 * \brief Returns the time until the next mining info request.
+		 * The closer the round gets to the expected block time, the shorter the time.
+		 */
+		std::chrono::milliseconds getMiningInfoWait() const;
+
+		/**
+		 * \brief Returns the time point, at which the current block was started.
+		 * The time point is zero, if no block was started yet.
+		 */
+		std::chrono::high_resolution_clock::time_point getStartPoint() const;
+
+		/**
+		 * \brief Creates one plot read notification per plot dir (or per plot file for parallel dirs).
+		 * \param wakeUpCall If true, the readers only wake up the dirs.
+		 * \param notifications The created notifications are appended here.
+		 */
+		void createPlotReadNotificationsByDir(bool wakeUpCall, std::vector<PlotReadNotification::Ptr>& notifications);
+
+		/**
+		 * \brief Groups all plot files by their physical device and creates one plot read notification
+		 * per reader of a device (one per disk for spinning disks, a fixed number for SSD and NVMe).
+		 * \param wakeUpCall If true, the readers only wake up the devices.
+		 * \param notifications The created notifications are appended here.
+		 */
+		void createPlotReadNotificationsByDevice(bool wakeUpCall, std::vector<PlotReadNotification::Ptr>& notifications);
+
+		/**
+		 * \brief Orders the plot read notifications by their expected read time (the longest first),
+		 * based on the throughput history of the dirs and devices, and predicts the round time.
+		 * \param notifications The notifications, that are ordered in place.
+		 */
+		void schedulePlotReadNotifications(std::vector<PlotReadNotification::Ptr>& notifications);
+		std::future<NonceConfirmation> queueNonce(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
+		                                          Poco::UInt64 blockheight, const std::string& plotFile,
+		                                          bool ownAccount, const std::string& minerName = "", Poco::UInt64 plotsize = 0);
 		SubmitResponse addNewDeadline(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
 		                              Poco::UInt64 blockheight, std::string plotFile,
 		                              bool ownAccount, std::shared_ptr<Deadline>& newDeadline);
 		void shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
 		                      Poco::NotificationQueue& queue) const;
+		void shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
+		                      VerificationScheduler& scheduler) const;
 		void progressChanged(float& progress);
 		void on_wake_up(Poco::Timer& timer);
 		void onBenchmark(Poco::Timer& timer);
 		void onRoundProcessed(Poco::UInt64 blockHeight, double roundTime);
+		static void allocateBuffers();
 
-		bool running_ = false, restart_ = false, isProcessing_ = false;
+		// read by the mining info pollers and the push thread
+		std::atomic<bool> running_{false};
+		bool restart_ = false, isProcessing_ = false;
 		MinerData data_;
 		std::shared_ptr<PlotReadProgress> progressRead_, progressVerify_;
-		std::unique_ptr<Poco::Net::HTTPClientSession> miningInfoSession_;
+		std::vector<std::unique_ptr<MiningInfoSource>> miningInfoSources_;
+		std::unique_ptr<MiningInfoPush> miningInfoPush_;
+		std::mutex miningInfoMutex_, miningInfoWaitMutex_;
+		std::condition_variable miningInfoWakeUp_;
+		std::atomic<double> expectedBlockTime_{0};
 		Accounts accounts_;
 		Wallet wallet_;
-		std::unique_ptr<Poco::TaskManager> nonceSubmitterManager_, plot_reader_, verifier_;
+		std::unique_ptr<Poco::TaskManager> plot_reader_, verifier_;
 		Poco::NotificationQueue plotReadQueue_;
-		Poco::NotificationQueue verificationQueue_;
+		VerificationScheduler verificationScheduler_;
+		SubmissionScheduler submissionScheduler_;
 		std::unique_ptr<Poco::ThreadPool> verifier_pool_, plot_reader_pool_;
 		Poco::Timer wake_up_timer_, benchmark_timer_;
 		mutable Poco::Mutex worker_mutex_;
-		std::chrono::high_resolution_clock::time_point startPoint_;
+		// the start of the current block as ticks since epoch, read by the mining info threads
+		std::atomic<std::chrono::high_resolution_clock::rep> startPoint_{0};
+		std::string plotDevices_;
 	};
 }
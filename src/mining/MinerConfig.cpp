@@ -149,7 +149,14 @@ void Burst::MinerConfig::printConsole() const
 
 	printConsolePlots();
 
-	log_system(MinerLogger::config, "Get mining info interval : %u seconds", getConfig().getMiningInfoInterval());
+	log_system(MinerLogger::config, "Get mining info interval : %u seconds (min. %u ms)", getConfig().getMiningInfoInterval(),
+		getConfig().getMiningInfoMinInterval());
+
+	for (const auto& url : urlMiningInfoSources_)
+		log_system(MinerLogger::config, "Mininginfo URL : %s", url.getUri().toString());
+
+	if (!urlMiningInfoPush_.empty())
+		log_system(MinerLogger::config, "Mininginfo push URL : %s", urlMiningInfoPush_.getUri().toString());
 
 	log_system(MinerLogger::config, "Processor type : %s", getConfig().getProcessorType());
 
@@ -476,34 +483,62 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 
 		walletRequestTries_ = getOrAdd(miningObj, "walletRequestTries", 5);
 		walletRequestRetryWaitTime_ = getOrAdd(miningObj, "walletRequestRetryWaitTime", 3);
+		connectionPoolSize_ = getOrAdd(miningObj, "connectionPoolSize", 4);
+		keepAliveTimeout_ = getOrAdd(miningObj, "keepAliveTimeout", 15);
+		maxSubmissionsInFlight_ = getOrAdd(miningObj, "maxSubmissionsInFlight", 4);
 
 		// use insecure plotfiles
 		useInsecurePlotfiles_ = getOrAdd(miningObj, "useInsecurePlotfiles", false);
 		getMiningInfoInterval_ = getOrAdd(miningObj, "getMiningInfoInterval", 3);
+		miningInfoMinInterval_ = getOrAdd(miningObj, "miningInfoMinInterval", 250);
+		miningInfoLongPoll_ = getOrAdd(miningObj, "miningInfoLongPoll", false);
 		rescanEveryBlock_ = getOrAdd(miningObj, "rescanEveryBlock", false);
 		
 		bufferChunkCount_ = getOrAdd(miningObj, "bufferChunkCount", 8);
+
+		const auto readerEngine = Poco::toLower(getOrAdd(miningObj, "readerEngine", std::string("stream")));
+
+		if (readerEngine == "io_uring")
+			plotReaderEngine_ = PlotReaderEngine::IoUring;
+		else
+			plotReaderEngine_ = PlotReaderEngine::Stream;
+
+		ioQueueDepth_ = getOrAdd(miningObj, "ioQueueDepth", 64);
+
+		// a chunk of a plot file in the other PoC format needs two reads at once (the scoop and the mirrored scoop)
+		if (ioQueueDepth_ < 2)
+			ioQueueDepth_ = 2;
+
+		const auto readerScheduling = Poco::toLower(getOrAdd(miningObj, "readerScheduling", std::string("device")));
+
+		if (readerScheduling == "dir")
+			plotReaderScheduling_ = PlotReaderScheduling::Dir;
+		else
+			plotReaderScheduling_ = PlotReaderScheduling::Device;
+
+		nonRotationalReaders_ = getOrAdd(miningObj, "nonRotationalReaders", 4);
+
+		if (nonRotationalReaders_ == 0)
+			nonRotationalReaders_ = 1;
+
+		directIo_ = getOrAdd(miningObj, "directIo", false);
+		hugePages_ = getOrAdd(miningObj, "hugePages", false);
+		fusedVerification_ = getOrAdd(miningObj, "fusedVerification", false);
+		workStealing_ = getOrAdd(miningObj, "workStealing", false);
+		extentOrder_ = getOrAdd(miningObj, "extentOrder", false);
+		coalescedReads_ = getOrAdd(miningObj, "coalescedReads", false);
+		verifyChecksums_ = getOrAdd(miningObj, "verifyChecksums", true);
+		poc2StartBlock_ = getOrAdd(miningObj, "poc2StartBlock", Poco::UInt64{502000});
 		wakeUpTime_ = getOrAdd(miningObj, "wakeUpTime", 0);
 
-		cpuInstructionSet_ = Poco::toUpper(getOrAdd(miningObj, "cpuInstructionSet", std::string("SSE2")));
+		cpuInstructionSet_ = Poco::toUpper(getOrAdd(miningObj, "cpuInstructionSet", std::string("AUTO")));
 		cpuInstructionSet_ = Poco::trim(cpuInstructionSet_);
 
 		databasePath_ = getOrAdd(miningObj, "databasePath", std::string("data.db"));
 
-		// auto detect the max. cpu instruction set
-		if (cpuInstructionSet_ == "AUTO")
-		{
-			if (cpuHasInstructionSet(CpuInstructionSet::avx2))
-				cpuInstructionSet_ = "AVX2";
-			else if (cpuHasInstructionSet(CpuInstructionSet::avx))
-				cpuInstructionSet_ = "AVX";
-			else if (cpuHasInstructionSet(CpuInstructionSet::sse4))
-				cpuInstructionSet_ = "SSE4";
-			else
-				cpuInstructionSet_ = "SSE2";
-		}
-
-		Settings::setCpuInstructionSet(cpuInstructionSet_);
+		// AUTO is resolved by a calibration, when the verifiers are created
+		if (cpuInstructionSet_ != "AUTO")
+			Settings::setCpuInstructionSet(cpuInstructionSet_);
 
 		processorType_ = getOrAdd(miningObj, "processorType", std::string("CPU"));
 
@@ -537,6 +572,24 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 			checkCreateUrlFunc(urlsObj, "submission", urlPool_, "http", 8080, "http://pool.burstcoin.ro:8080");
 			checkCreateUrlFunc(urlsObj, "miningInfo", urlMiningInfo_, "http", 8080, "http://pool.burstcoin.ro:8080");
 			checkCreateUrlFunc(urlsObj, "wallet", urlWallet_, "https", 443, "https://wallet.burstcoin.ro:443");
+			checkCreateUrlFunc(urlsObj, "miningInfoPush", urlMiningInfoPush_, "ws", 80, "");
+
+			// more mining info urls, that are polled at the same time as the main one
+			urlMiningInfoSources_.clear();
+
+			if (!urlsObj->has("miningInfoSources"))
+				urlsObj->set("miningInfoSources", Poco::JSON::Array::Ptr(new Poco::JSON::Array));
+
+			auto sourcesDyn = urlsObj->get("miningInfoSources");
+
+			if (sourcesDyn.type() == typeid(Poco::JSON::Array::Ptr))
+				for (auto& source : *sourcesDyn.extract<Poco::JSON::Array::Ptr>())
+				{
+					const Url url{source.convert<std::string>(), "http", 8080};
+
+					if (!url.empty())
+						urlMiningInfoSources_.emplace_back(url);
+				}
 
 			if (urlMiningInfo_.empty() && !urlPool_.empty())
 			{
@@ -1007,6 +1060,25 @@ Burst::Url Burst::MinerConfig::getMiningInfoUrl() const
 	return urlMiningInfo_;
 }
 
+std::vector<Burst::Url> Burst::MinerConfig::getMiningInfoUrls() const
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+
+	std::vector<Url> urls{urlMiningInfo_};
+
+	for (const auto& url : urlMiningInfoSources_)
+		if (url.getUri() != urlMiningInfo_.getUri())
+			urls.emplace_back(url);
+
+	return urls;
+}
+
+Burst::Url Burst::MinerConfig::getMiningInfoPushUrl() const
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+	return urlMiningInfoPush_;
+}
+
 Burst::Url Burst::MinerConfig::getWalletUrl() const
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
@@ -1362,6 +1434,21 @@ unsigned Burst::MinerConfig::getWalletRequestRetryWaitTime() const
 	return walletRequestRetryWaitTime_;
 }
 
+unsigned Burst::MinerConfig::getConnectionPoolSize() const
+{
+	return connectionPoolSize_;
+}
+
+unsigned Burst::MinerConfig::getKeepAliveTimeout() const
+{
+	return keepAliveTimeout_;
+}
+
+unsigned Burst::MinerConfig::getMaxSubmissionsInFlight() const
+{
+	return maxSubmissionsInFlight_;
+}
+
 unsigned Burst::MinerConfig::getWakeUpTime() const
 {
 	return wakeUpTime_;
@@ -1464,6 +1551,8 @@ bool Burst::MinerConfig::save(const std::string& path) const
 
 		// miningInfoInterval
 		mining.set("getMiningInfoInterval", getMiningInfoInterval());
+		mining.set("miningInfoMinInterval", getMiningInfoMinInterval());
+		mining.set("miningInfoLongPoll", isMiningInfoLongPoll());
 		mining.set("intensity", miningIntensity_);
 		mining.set("maxBufferSizeMB", maxBufferSizeMB_);
 		mining.set("maxPlotReaders", maxPlotReaders_);
@@ -1474,9 +1563,24 @@ bool Burst::MinerConfig::save(const std::string& path) const
 		mining.set("timeout", static_cast<Poco::UInt64>(timeout_));
 		mining.set("walletRequestRetryWaitTime", walletRequestRetryWaitTime_);
 		mining.set("walletRequestTries", walletRequestTries_);
+		mining.set("connectionPoolSize", getConnectionPoolSize());
+		mining.set("keepAliveTimeout", getKeepAliveTimeout());
+		mining.set("maxSubmissionsInFlight", getMaxSubmissionsInFlight());
 		mining.set("useInsecurePlotfiles", useInsecurePlotfiles());
 		mining.set("rescanEveryBlock", isRescanningEveryBlock());
 		mining.set("bufferChunkCount", getBufferChunkCount());
+		mining.set("readerEngine", getPlotReaderEngine() == PlotReaderEngine::IoUring ? "io_uring" : "stream");
+		mining.set("ioQueueDepth", getIoQueueDepth());
+		mining.set("readerScheduling", getPlotReaderScheduling() == PlotReaderScheduling::Dir ? "dir" : "device");
+		mining.set("nonRotationalReaders", getNonRotationalReaders());
+		mining.set("directIo", isUsingDirectIo());
+		mining.set("hugePages", isUsingHugePages());
+		mining.set("fusedVerification", isUsingFusedVerification());
+		mining.set("workStealing", isUsingWorkStealing());
+		mining.set("extentOrder", isUsingExtentOrder());
+		mining.set("coalescedReads", isUsingCoalescedReads());
+		mining.set("verifyChecksums", isVerifyingChecksums());
+		mining.set("poc2StartBlock", getPoc2StartBlock());
 		mining.set("wakeUpTime", getWakeUpTime());
 		mining.set("cpuInstructionSet", getCpuInstructionSet());
 		mining.set("processorType", getProcessorType());
@@ -1520,6 +1624,12 @@ bool Burst::MinerConfig::save(const std::string& path) const
 			urls.set("miningInfo", urlMiningInfo_.getUri().toString());
 			urls.set("submission", urlPool_.getUri().toString());
 			urls.set("wallet", urlWallet_.getUri().toString());
+			urls.set("miningInfoPush", urlMiningInfoPush_.empty() ? "" : urlMiningInfoPush_.getUri().toString());
+
+			Poco::JSON::Array miningInfoSources;
+			for (const auto& url : urlMiningInfoSources_)
+				miningInfoSources.add(url.getUri().toString());
+			urls.set("miningInfoSources", miningInfoSources);
 			mining.set("urls", urls);
 		}
 
@@ -1819,6 +1929,16 @@ unsigned Burst::MinerConfig::getMiningInfoInterval() const
 	return getMiningInfoInterval_;
 }
 
+unsigned Burst::MinerConfig::getMiningInfoMinInterval() const
+{
+	return miningInfoMinInterval_;
+}
+
+bool Burst::MinerConfig::isMiningInfoLongPoll() const
+{
+	return miningInfoLongPoll_;
+}
+
 bool Burst::MinerConfig::isRescanningEveryBlock() const
 {
 	return rescanEveryBlock_;
@@ -1849,6 +1969,71 @@ unsigned Burst::MinerConfig::getBufferChunkCount() const
 	return bufferChunkCount_;
 }
 
+Burst::PlotReaderEngine Burst::MinerConfig::getPlotReaderEngine() const
+{
+	return plotReaderEngine_;
+}
+
+unsigned Burst::MinerConfig::getIoQueueDepth() const
+{
+	return ioQueueDepth_;
+}
+
+Burst::PlotReaderScheduling Burst::MinerConfig::getPlotReaderScheduling() const
+{
+	return plotReaderScheduling_;
+}
+
+unsigned Burst::MinerConfig::getNonRotationalReaders() const
+{
+	return nonRotationalReaders_;
+}
+
+bool Burst::MinerConfig::isUsingDirectIo() const
+{
+	return directIo_;
+}
+
+bool Burst::MinerConfig::isUsingHugePages() const
+{
+	return hugePages_;
+}
+
+bool Burst::MinerConfig::isUsingFusedVerification() const
+{
+	return fusedVerification_;
+}
+
+bool Burst::MinerConfig::isUsingWorkStealing() const
+{
+	return workStealing_;
+}
+
+bool Burst::MinerConfig::isUsingExtentOrder() const
+{
+	return extentOrder_;
+}
+
+bool Burst::MinerConfig::isUsingCoalescedReads() const
+{
+	return coalescedReads_;
+}
+
+bool Burst::MinerConfig::isVerifyingChecksums() const
+{
+	return verifyChecksums_;
+}
+
+Poco::UInt64 Burst::MinerConfig::getPoc2StartBlock() const
+{
+	return poc2StartBlock_;
+}
+
+bool Burst::MinerConfig::isPoc2Block(const Poco::UInt64 blockheight) const
+{
+	return blockheight >= getPoc2StartBlock();
+}
+
 void Burst::MinerConfig::useLogfile(bool use)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
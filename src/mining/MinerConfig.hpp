@@ -57,6 +57,28 @@ namespace Burst
 		Combined
 	};
 
+	enum class PlotReaderEngine
+	{
+		Stream,
+		IoUring
+	};
+
+	/**
+	 * \brief How the plot files are distributed to the plot readers.
+	 */
+	enum class PlotReaderScheduling
+	{
+		/**
+		 * \brief The plot files are grouped by their physical device, every device is read
+		 * by max. one reader per disk (spinning disks) or a fixed number of readers (SSD, NVMe).
+		 */
+		Device,
+		/**
+		 * \brief The plot files are grouped by the configured plot dirs and their types (sequential, parallel).
+		 */
+		Dir
+	};
+
 	/**
 	 * \brief Represents a passphrase, used for solo-mining.
 	 * Includes informations for en-/decrypting a passphrase.
@@ -154,6 +176,17 @@ namespace Burst
 		float getTimeout() const;
 		Url getPoolUrl() const;
 		Url getMiningInfoUrl() const;
+
+		/**
+		 * \brief Returns all mining info urls, that are polled at the same time (the main one first).
+		 */
+		std::vector<Url> getMiningInfoUrls() const;
+
+		/**
+		 * \brief Returns the url, the pool pushes new mining infos to (ws(s):// or server-sent events over http(s)://).
+		 * Empty, if the pool is only polled.
+		 */
+		Url getMiningInfoPushUrl() const;
 		Url getWalletUrl() const;
 
 		unsigned getReceiveMaxRetry() const;
@@ -178,6 +211,17 @@ namespace Burst
 		bool useInsecurePlotfiles() const;
 		bool isLogfileUsed() const;
 		unsigned getMiningInfoInterval() const;
+
+		/**
+		 * \brief Returns the shortest interval in milliseconds between two mining info requests.
+		 * It is used when the next block is expected, based on the block times so far.
+		 */
+		unsigned getMiningInfoMinInterval() const;
+
+		/**
+		 * \brief Checks if the mining info host holds the request until a new block arrives.
+		 */
+		bool isMiningInfoLongPoll() const;
 		bool isRescanningEveryBlock() const;
 		LogOutputType getLogOutputType() const;
 		bool isUsingLogColors() const;
@@ -185,6 +229,58 @@ namespace Burst
 		bool isFancyProgressBar() const;
 		unsigned getBufferChunkCount() const;
 		bool isCalculatingEveryDeadline() const;
+		PlotReaderEngine getPlotReaderEngine() const;
+		unsigned getIoQueueDepth() const;
+		PlotReaderScheduling getPlotReaderScheduling() const;
+		unsigned getNonRotationalReaders() const;
+		bool isUsingDirectIo() const;
+		bool isUsingHugePages() const;
+
+		/**
+		 * \brief Returns true, if the plot readers verify their chunks themselves,
+		 * instead of giving them to the verifiers (only with a CPU verifier).
+		 * This saves the hand-over between two cores on fast drives (SSD, NVMe).
+		 */
+		bool isUsingFusedVerification() const;
+
+		/**
+		 * \brief Returns true, if every plot reader hands its chunks to the verifiers over a queue of its own,
+		 * that the idle verifiers steal from, instead of the single shared queue.
+		 */
+		bool isUsingWorkStealing() const;
+
+		/**
+		 * \brief Returns true, if the plot readers read the scoops of all plot files of a dir or device
+		 * in the order of their address on the device (by the extent maps of the plot files),
+		 * instead of file by file.
+		 */
+		bool isUsingExtentOrder() const;
+
+		/**
+		 * \brief Returns true, if the scoops of multiple whole staggers of a plot file are read into
+		 * one buffer (up to the size of a buffer chunk), instead of one buffer per stagger.
+		 * This saves verifications and (with io_uring) syscalls for plot files with small staggers.
+		 */
+		bool isUsingCoalescedReads() const;
+
+		/**
+		 * \brief Returns true, if the read scoops are checked against the checksum index of their plot file.
+		 * Corrupted chunks are skipped. Plot files without an index are not checked.
+		 */
+		bool isVerifyingChecksums() const;
+
+		/**
+		 * \brief Returns the first block, that is mined with the PoC2 format.
+		 * Plot files in the other format are read with the mirrored scoop halves.
+		 */
+		Poco::UInt64 getPoc2StartBlock() const;
+
+		/**
+		 * \brief Checks, if a block is mined with the PoC2 format.
+		 * \param blockheight The height of the block.
+		 * \return true, if the block needs PoC2 scoops, false for PoC1 scoops.
+		 */
+		bool isPoc2Block(Poco::UInt64 blockheight) const;
 
 		/**
 		 * \brief Returns the maximal amount of simultane plot reader.
@@ -199,6 +295,22 @@ namespace Burst
 		std::string getServerPass() const;
 		unsigned getWalletRequestTries() const;
 		unsigned getWalletRequestRetryWaitTime() const;
+
+		/**
+		 * \brief Returns the max. number of idle keep-alive connections per host (pool, wallet, mining info).
+		 * 0 disables the connection pool, every request opens a new connection.
+		 */
+		unsigned getConnectionPoolSize() const;
+
+		/**
+		 * \brief Returns the time in seconds, after which an idle connection is not used anymore.
+		 */
+		unsigned getKeepAliveTimeout() const;
+
+		/**
+		 * \brief Returns the max. number of deadlines, that are sent to the pool at the same time.
+		 */
+		unsigned getMaxSubmissionsInFlight() const;
 		unsigned getWakeUpTime() const;
 		const std::string& getCpuInstructionSet() const;
 		const std::string& getProcessorType() const;
@@ -287,6 +399,8 @@ namespace Burst
 		std::string confirmedDeadlinesPath_ = "";
 		Url urlPool_;
 		Url urlMiningInfo_;
+		Url urlMiningInfoPush_;
+		std::vector<Url> urlMiningInfoSources_;
 		Url urlWallet_;
 		bool startServer_ = true;
 		Url serverUrl_{"http://0.0.0.0:8124"};
@@ -302,12 +416,29 @@ namespace Burst
 		Poco::UInt64 maxBufferSizeMB_ = 0;
 		Poco::UInt64 maxHistoricalBlocks_ = 0;
 		unsigned bufferChunkCount_ = 16;
+		PlotReaderEngine plotReaderEngine_ = PlotReaderEngine::Stream;
+		unsigned ioQueueDepth_ = 64;
+		PlotReaderScheduling plotReaderScheduling_ = PlotReaderScheduling::Device;
+		unsigned nonRotationalReaders_ = 4;
+		bool directIo_ = false;
+		bool hugePages_ = false;
+		bool fusedVerification_ = false;
+		bool workStealing_ = false;
+		bool extentOrder_ = false;
+		bool coalescedReads_ = false;
+		bool verifyChecksums_ = true;
+		Poco::UInt64 poc2StartBlock_ = 502000;
 		unsigned walletRequestTries_ = 3;
 		unsigned walletRequestRetryWaitTime_ = 3;
+		unsigned connectionPoolSize_ = 4;
+		unsigned keepAliveTimeout_ = 15;
+		unsigned maxSubmissionsInFlight_ = 4;
 		Passphrase passphrase_ = {};
 		bool useInsecurePlotfiles_ = false;
 		bool logfile_ = false;
 		unsigned getMiningInfoInterval_ = 3;
+		unsigned miningInfoMinInterval_ = 250;
+		bool miningInfoLongPoll_ = false;
 		bool rescanEveryBlock_ = false;
 		LogOutputType logOutputType_ = LogOutputType::Terminal;
 		bool logUseColors_ = true;
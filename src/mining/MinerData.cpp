@@ -66,6 +66,12 @@ std::shared_ptr<Burst::Deadline> Burst::BlockData::addDeadlineUnlocked(const Poc
 		return nullptr;
 
 	auto accountId = account->getId();
+
+	// deadlines, that were not found by the own verifiers, lower the threshold too
+	const auto threshold = thresholds_.find(accountId);
+
+	if (threshold != thresholds_.end())
+		threshold->second->improve(deadline);
 	
 	auto iter = deadlines_.find(accountId);
 
@@ -235,6 +241,11 @@ void Burst::BlockData::setRoundTime(double rTime)
 	roundTime_ = rTime;
 }
 
+void Burst::BlockData::setPredictedRoundTime(double rTime)
+{
+	predictedRoundTime_ = rTime;
+}
+
 void Burst::BlockData::addBlockEntry(Poco::JSON::Object entry) const
 {
 	{
@@ -271,6 +282,11 @@ double Burst::BlockData::getRoundTime() const
 	return roundTime_;
 }
 
+double Burst::BlockData::getPredictedRoundTime() const
+{
+	return predictedRoundTime_.load();
+}
+
 Poco::UInt64 Burst::BlockData::getBlockTargetDeadline() const
 {
 	return blockTargetDeadline_.load();
@@ -388,6 +404,28 @@ std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(Poco::UInt64
 	return getBestDeadlineUnlocked(accountId, searchType);
 }
 
+std::shared_ptr<Burst::DeadlineThreshold> Burst::BlockData::getDeadlineThreshold(const Poco::UInt64 accountId)
+{
+	std::lock_guard<std::mutex> lock{ mutex_ };
+
+	const auto iter = thresholds_.find(accountId);
+
+	if (iter != thresholds_.end())
+		return iter->second;
+
+	// too high deadlines are needed for the output, so the target deadline can not sort them out
+	const auto targetDeadline = MinerLogger::hasOutput(NonceFoundTooHigh) ? 0 : MinerConfig::getConfig().getTargetDeadline();
+	auto threshold = std::make_shared<DeadlineThreshold>(targetDeadline);
+
+	const auto bestDeadline = getBestDeadlineUnlocked(accountId, DeadlineSearchType::Found);
+
+	if (bestDeadline != nullptr)
+		threshold->improve(bestDeadline->getDeadline());
+
+	thresholds_.emplace(accountId, threshold);
+	return threshold;
+}
+
 Poco::ActiveResult<std::shared_ptr<Burst::Account>> Burst::BlockData::getLastWinnerAsync(const Wallet& wallet, Accounts& accounts)
 {
 	return DataLoader::getInstance().getLastWinner(make_tuple(std::cref(wallet), std::ref(accounts), std::ref(*this)));
@@ -886,6 +924,22 @@ Poco::UInt64 Burst::MinerData::getCurrentBlockheight() const
 	return blockData_ == nullptr ? 0 : blockData_->getBlockheight();
 }
 
+std::shared_ptr<Burst::DeadlineThreshold> Burst::MinerData::getDeadlineThreshold(const Poco::UInt64 blockheight,
+	const Poco::UInt64 accountId) const
+{
+	std::shared_ptr<BlockData> blockData;
+
+	{
+		std::lock_guard<std::mutex> lock {mutex_};
+		blockData = blockData_;
+	}
+
+	if (blockData == nullptr || blockData->getBlockheight() != blockheight)
+		return nullptr;
+
+	return blockData->getDeadlineThreshold(accountId);
+}
+
 Poco::UInt64 Burst::MinerData::getCurrentBasetarget() const
 {
 		std::lock_guard<std::mutex> lock {mutex_};
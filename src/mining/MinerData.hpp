@@ -22,6 +22,7 @@
 #pragma once
 
 #include "Deadline.hpp"
+#include "DeadlineThreshold.hpp"
 #include <Poco/Timestamp.h>
 #include <Poco/Timespan.h>
 #include <Poco/JSON/Object.h>
@@ -61,6 +62,7 @@ namespace Burst
 		void setBaseTarget(Poco::UInt64 baseTarget);
 		void setLastWinner(std::shared_ptr<Account> account);
 		void setRoundTime(double rTime);
+		void setPredictedRoundTime(double rTime);
 		
 		void refreshBlockEntry() const;
 		void refreshConfig() const;
@@ -76,6 +78,7 @@ namespace Burst
 		Poco::UInt64 getBlockTargetDeadline() const;
 		std::shared_ptr<Account> getLastWinner() const;
 		double getRoundTime() const;
+		double getPredictedRoundTime() const;
 		Poco::UInt64 getBlockTime() const;
 		
 		const GensigData& getGensig() const;
@@ -86,6 +89,15 @@ namespace Burst
 		bool forEntries(std::function<bool(const Poco::JSON::Object&)> traverseFunction) const;
 		//const std::unordered_map<AccountId, Deadlines>& getDeadlines() const;
 		std::shared_ptr<Deadline> getBestDeadline(Poco::UInt64 accountId, DeadlineSearchType searchType);
+
+		/**
+		 * \brief Returns the deadline threshold of an account, that is shared by all verifiers.
+		 * The threshold is created on the first call and starts at the target deadline
+		 * (or the best deadline, that was already found for the account).
+		 * \param accountId The numeric id of the account.
+		 * \return The threshold.
+		 */
+		std::shared_ptr<DeadlineThreshold> getDeadlineThreshold(Poco::UInt64 accountId);
 		Poco::ActiveResult<std::shared_ptr<Account>> getLastWinnerAsync(const Wallet& wallet, Accounts& accounts);
 
 		std::shared_ptr<Deadline> addDeadlineIfBest(Poco::UInt64 nonce, Poco::UInt64 deadline,
@@ -131,10 +143,12 @@ namespace Burst
 		GensigData genSig_{};
 		std::string genSigStr_ = "";
 		double roundTime_;
+		std::atomic<double> predictedRoundTime_{0};
 		Poco::UInt64 blockTime_{};
 		std::shared_ptr<std::vector<Poco::JSON::Object>> entries_;
 		std::shared_ptr<Account> lastWinner_ = nullptr;
 		std::unordered_map<AccountId, std::shared_ptr<Deadlines>> deadlines_;
+		std::unordered_map<AccountId, std::shared_ptr<DeadlineThreshold>> thresholds_;
 		std::shared_ptr<Deadline> bestDeadline_;
 		MinerData* parent_;
 		Poco::JSON::Object::Ptr jsonProgress_;
@@ -178,6 +192,14 @@ namespace Burst
 		Poco::UInt64 getCurrentBlockheight() const;
 		Poco::UInt64 getCurrentBasetarget() const;
 		Poco::UInt64 getCurrentScoopNum() const;
+
+		/**
+		 * \brief Returns the deadline threshold of an account in the current block.
+		 * \param blockheight The height of the block, the threshold is used for.
+		 * \param accountId The numeric id of the account.
+		 * \return The threshold, nullptr if the block is not the current one.
+		 */
+		std::shared_ptr<DeadlineThreshold> getDeadlineThreshold(Poco::UInt64 blockheight, Poco::UInt64 accountId) const;
 		Poco::ActiveResult<Poco::UInt64> getWonBlocksAsync(const Wallet& wallet, const Accounts& accounts);
 
 		Poco::BasicEvent<const Poco::JSON::Object> blockDataChangedEvent;
@@ -0,0 +1,970 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "AsyncHttpClient.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/Error.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/SecureStreamSocket.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SSLManager.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/String.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \brief Parses a http response, while it is received.
+	 */
+	class ResponseParser
+	{
+	public:
+		/**
+		 * \brief Parses the next received bytes.
+		 * \param data The bytes.
+		 * \param size The number of bytes.
+		 * \return true, if the response is complete.
+		 */
+		bool feed(const char* data, size_t size);
+
+		/**
+		 * \brief Called, when the host closed the connection.
+		 * \return true, if the response is complete (a body without length ends with the connection).
+		 */
+		bool close();
+
+		bool hasData() const;
+		bool isKeepAlive() const;
+		Poco::Net::HTTPResponse& getHeader();
+		std::string& getBody();
+
+	private:
+		enum class State
+		{
+			Header,
+			Body,
+			BodyUntilClose,
+			ChunkSize,
+			ChunkData,
+			ChunkEnd,
+			Trailer,
+			Complete
+		};
+
+		bool consume(State next);
+
+		State state_ = State::Header;
+		std::string buffer_;
+		Poco::Net::HTTPResponse header_;
+		std::string body_;
+		Poco::UInt64 remaining_ = 0;
+		bool received_ = false;
+	};
+
+	bool ResponseParser::feed(const char* data, const size_t size)
+	{
+		received_ = true;
+		buffer_.append(data, size);
+
+		while (true)
+		{
+			switch (state_)
+			{
+			case State::Header:
+			{
+				const auto end = buffer_.find("\r\n\r\n");
+
+				if (end == std::string::npos)
+					return false;
+
+				std::istringstream stream{buffer_.substr(0, end + 4)};
+				header_.clear();
+				header_.read(stream);
+				buffer_.erase(0, end + 4);
+
+				// an informational response (100 continue) is followed by the real one
+				if (header_.getStatus() / 100 == 1)
+					break;
+
+				if (header_.getStatus() == Poco::Net::HTTPResponse::HTTP_NO_CONTENT ||
+					header_.getStatus() == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
+					state_ = State::Complete;
+				else if (header_.getChunkedTransferEncoding())
+					state_ = State::ChunkSize;
+				else if (header_.hasContentLength())
+				{
+					remaining_ = header_.getContentLength64();
+					state_ = State::Body;
+				}
+				else
+					state_ = State::BodyUntilClose;
+
+				break;
+			}
+			case State::Body:
+				if (!consume(State::Complete))
+					return false;
+				break;
+			case State::BodyUntilClose:
+				body_ += buffer_;
+				buffer_.clear();
+				return false;
+			case State::ChunkSize:
+			{
+				const auto end = buffer_.find("\r\n");
+
+				if (end == std::string::npos)
+					return false;
+
+				// chunk extensions behind the size are ignored
+				remaining_ = std::stoull(buffer_.substr(0, end), nullptr, 16);
+				buffer_.erase(0, end + 2);
+				state_ = remaining_ == 0 ? State::Trailer : State::ChunkData;
+				break;
+			}
+			case State::ChunkData:
+				if (!consume(State::ChunkEnd))
+					return false;
+				break;
+			case State::ChunkEnd:
+				if (buffer_.size() < 2)
+					return false;
+
+				buffer_.erase(0, 2);
+				state_ = State::ChunkSize;
+				break;
+			case State::Trailer:
+			{
+				const auto end = buffer_.find("\r\n");
+
+				if (end == std::string::npos)
+					return false;
+
+				buffer_.erase(0, end + 2);
+
+				// the trailer ends with an empty line
+				if (end == 0)
+					state_ = State::Complete;
+
+				break;
+			}
+			case State::Complete:
+				return true;
+			}
+		}
+	}
+
+	bool ResponseParser::close()
+	{
+		if (state_ == State::BodyUntilClose)
+			state_ = State::Complete;
+
+		return state_ == State::Complete;
+	}
+
+	bool ResponseParser::hasData() const
+	{
+		return received_;
+	}
+
+	bool ResponseParser::isKeepAlive() const
+	{
+		return state_ == State::Complete && header_.getKeepAlive();
+	}
+
+	Poco::Net::HTTPResponse& ResponseParser::getHeader()
+	{
+		return header_;
+	}
+
+	std::string& ResponseParser::getBody()
+	{
+		return body_;
+	}
+
+	bool ResponseParser::consume(const State next)
+	{
+		const auto bytes = static_cast<size_t>(std::min<Poco::UInt64>(remaining_, buffer_.size()));
+
+		body_.append(buffer_, 0, bytes);
+		buffer_.erase(0, bytes);
+		remaining_ -= bytes;
+
+		if (remaining_ > 0)
+			return false;
+
+		state_ = next;
+		return true;
+	}
+}
+
+struct Burst::AsyncHttpClient::Connection
+{
+	enum class State
+	{
+		Connecting,
+		Sending,
+		Receiving,
+		Idle
+	};
+
+	std::string key;
+	Poco::Net::StreamSocket socket;
+	bool secure = false;
+	State state = State::Connecting;
+	Job job;
+	bool hasJob = false;
+	bool reused = false;
+	size_t sent = 0;
+	std::unique_ptr<ResponseParser> parser;
+	Clock::time_point expires;
+	bool watched = false;
+	bool watchRead = false;
+	bool watchWrite = false;
+	bool closed = false;
+};
+
+bool Burst::AsyncHttpResponse::isOk() const
+{
+	return received && status == Poco::Net::HTTPResponse::HTTP_OK;
+}
+
+Burst::AsyncHttpClient::AsyncHttpClient() = default;
+
+Burst::AsyncHttpClient::~AsyncHttpClient()
+{
+	stop();
+}
+
+Burst::AsyncHttpClient& Burst::AsyncHttpClient::instance()
+{
+	static AsyncHttpClient client;
+	return client;
+}
+
+void Burst::AsyncHttpClient::send(const Url& url, Poco::Net::HTTPRequest& request, const std::string& body,
+	Callback callback)
+{
+	Job job;
+	job.callback = std::move(callback);
+
+	if (url.empty())
+		return fail(job, "No url");
+
+	const auto scheme = Poco::toLower(url.getUri().getScheme());
+
+	if (scheme != "http" && scheme != "https")
+		return fail(job, "Unsupported scheme " + scheme);
+
+	job.key = getKey(url);
+	job.url = url;
+
+	if (!url.resolve(job.address))
+		return fail(job, "Could not resolve " + url.getUri().getHost());
+
+	if (!request.has(Poco::Net::HTTPRequest::HOST))
+		request.setHost(url.getUri().getHost(), url.getPort());
+
+	// the body is always sent at once
+	request.setChunkedTransferEncoding(false);
+
+	if (!body.empty() || request.hasContentLength())
+		request.setContentLength(body.size());
+
+	std::ostringstream stream;
+	request.write(stream);
+	stream << body;
+
+	job.request = stream.str();
+	job.deadline = Clock::now() + std::chrono::milliseconds{
+		static_cast<long long>(MinerConfig::getConfig().getTimeout() * 1000)};
+
+	enqueue(std::move(job));
+}
+
+std::future<Burst::AsyncHttpResponse> Burst::AsyncHttpClient::send(const Url& url, Poco::Net::HTTPRequest& request,
+	const std::string& body)
+{
+	auto promise = std::make_shared<std::promise<AsyncHttpResponse>>();
+	auto future = promise->get_future();
+
+	send(url, request, body, [promise](AsyncHttpResponse& response)
+	{
+		promise->set_value(std::move(response));
+	});
+
+	return future;
+}
+
+void Burst::AsyncHttpClient::warmUp(const Url& url)
+{
+	if (url.empty() || MinerConfig::getConfig().getConnectionPoolSize() == 0)
+		return;
+
+	// a job without request only opens the connection
+	Job job;
+	job.key = getKey(url);
+	job.url = url;
+	job.deadline = Clock::now() + std::chrono::milliseconds{
+		static_cast<long long>(MinerConfig::getConfig().getTimeout() * 1000)};
+
+	if (url.resolve(job.address))
+		enqueue(std::move(job));
+}
+
+void Burst::AsyncHttpClient::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+
+		if (!running_)
+			return;
+
+		running_ = false;
+		stopping_ = true;
+		wakeUp();
+	}
+
+	thread_.join();
+
+	std::deque<Job> jobs;
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		jobs.swap(queue_);
+		stopping_ = false;
+
+#ifdef __linux__
+		::close(wakeUp_);
+		::close(poller_);
+		wakeUp_ = poller_ = -1;
+#else
+		wakeUpReader_.close();
+		wakeUpWriter_.close();
+#endif
+	}
+
+	for (auto& job : jobs)
+		fail(job, "The http client was stopped");
+}
+
+void Burst::AsyncHttpClient::start()
+{
+#ifdef __linux__
+	poller_ = epoll_create1(EPOLL_CLOEXEC);
+	wakeUp_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (poller_ < 0 || wakeUp_ < 0)
+		log_error(MinerLogger::session, "Could not create the event loop: %s", Poco::Error::getMessage(Poco::Error::last()));
+
+	// the wake up has no connection
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.ptr = nullptr;
+	epoll_ctl(poller_, EPOLL_CTL_ADD, wakeUp_, &event);
+#else
+	try
+	{
+		Poco::Net::ServerSocket server{Poco::Net::SocketAddress{"127.0.0.1", 0}};
+		wakeUpWriter_ = Poco::Net::StreamSocket{};
+		wakeUpWriter_.connect(server.address());
+		wakeUpReader_ = server.acceptConnection();
+		wakeUpReader_.setBlocking(false);
+		wakeUpWriter_.setBlocking(false);
+		wakeUpWriter_.setNoDelay(true);
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::session, "Could not create the event loop: %s", exc.displayText());
+	}
+#endif
+
+	running_ = true;
+	thread_ = std::thread{&AsyncHttpClient::run, this};
+}
+
+void Burst::AsyncHttpClient::enqueue(Job job)
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+
+		if (!running_ && !stopping_)
+			start();
+
+		if (running_)
+		{
+			queue_.push_back(std::move(job));
+			wakeUp();
+			return;
+		}
+	}
+
+	fail(job, "The http client was stopped");
+}
+
+void Burst::AsyncHttpClient::wakeUp()
+{
+#ifdef __linux__
+	const Poco::UInt64 value = 1;
+
+	if (::write(wakeUp_, &value, sizeof value) < 0)
+		log_debug(MinerLogger::session, "Could not wake up the event loop: %s", Poco::Error::getMessage(Poco::Error::last()));
+#else
+	// a full buffer is not an error, the event loop wakes up anyway
+	try
+	{
+		const char value = 1;
+		wakeUpWriter_.sendBytes(&value, sizeof value);
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::session, "Could not wake up the event loop: %s", exc.displayText());
+	}
+#endif
+}
+
+void Burst::AsyncHttpClient::run()
+{
+	while (running_)
+	{
+		std::deque<Job> jobs;
+
+		{
+			std::lock_guard<std::mutex> lock{mutex_};
+			jobs.swap(queue_);
+		}
+
+		for (auto& job : jobs)
+			dispatch(std::move(job));
+
+		// wait until the next connection times out
+		auto now = Clock::now();
+		std::chrono::milliseconds timeout{1000};
+
+		for (const auto& connection : connections_)
+			if (!connection->closed)
+				timeout = std::min(timeout, std::max(std::chrono::milliseconds{0},
+					std::chrono::duration_cast<std::chrono::milliseconds>(connection->expires - now) +
+					std::chrono::milliseconds{1}));
+
+		poll(timeout);
+
+		now = Clock::now();
+
+		// a request can open a new connection, while the old ones are checked
+		for (size_t i = 0; i < connections_.size(); ++i)
+		{
+			auto& connection = *connections_[i];
+
+			if (connection.closed || connection.expires > now)
+				continue;
+
+			if (connection.hasJob)
+				finish(connection, false, "Timeout");
+			else
+				close(connection);
+		}
+
+		connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+			[](const std::unique_ptr<Connection>& connection)
+			{
+				return connection->closed;
+			}), connections_.end());
+	}
+
+	for (auto& connection : connections_)
+	{
+		close(*connection);
+
+		if (connection->hasJob)
+		{
+			connection->hasJob = false;
+			fail(connection->job, "The http client was stopped");
+		}
+	}
+
+	connections_.clear();
+}
+
+void Burst::AsyncHttpClient::dispatch(Job job)
+{
+	const auto warmUp = job.request.empty();
+
+	if (MinerConfig::getConfig().getConnectionPoolSize() > 0)
+	{
+		Connection* idle = nullptr;
+
+		for (auto& connection : connections_)
+		{
+			if (connection->closed || connection->key != job.key)
+				continue;
+
+			// there is already a connection, that is idle or connecting for a warm up
+			if (warmUp && !connection->hasJob)
+				return;
+
+			// the connection, that was idle the shortest time, is most likely still open
+			if (connection->state == Connection::State::Idle && (idle == nullptr || connection->expires > idle->expires))
+				idle = connection.get();
+		}
+
+		// a request, that failed on a reused connection, is sent on a new one
+		if (idle != nullptr && !warmUp && !job.retried)
+		{
+			idle->reused = true;
+			idle->state = Connection::State::Sending;
+			assign(*idle, std::move(job));
+
+			try
+			{
+				watch(*idle, false, true);
+			}
+			catch (Poco::Exception& exc)
+			{
+				finish(*idle, false, exc.displayText());
+			}
+
+			return;
+		}
+	}
+	else if (warmUp)
+		return;
+
+	std::unique_ptr<Connection> connection{new Connection};
+	connection->key = job.key;
+
+	try
+	{
+		if (Poco::icompare(job.url.getUri().getScheme(), "https") == 0)
+		{
+			Poco::Net::SecureStreamSocket socket{Poco::Net::SSLManager::instance().defaultClientContext()};
+			socket.setPeerHostName(job.url.getUri().getHost());
+			socket.connectNB(job.address);
+			connection->socket = socket;
+			connection->secure = true;
+		}
+		else
+			connection->socket.connectNB(job.address);
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::session, "Could not connect to %s: %s", job.url.getCanonical(), exc.displayText());
+
+		if (!warmUp)
+			fail(job, exc.displayText());
+
+		return;
+	}
+
+	if (warmUp)
+		connection->expires = job.deadline;
+	else
+		assign(*connection, std::move(job));
+
+	try
+	{
+		watch(*connection, false, true);
+	}
+	catch (Poco::Exception& exc)
+	{
+		close(*connection);
+
+		if (connection->hasJob)
+			fail(connection->job, exc.displayText());
+
+		return;
+	}
+
+	connections_.emplace_back(std::move(connection));
+}
+
+void Burst::AsyncHttpClient::assign(Connection& connection, Job job)
+{
+	connection.job = std::move(job);
+	connection.hasJob = true;
+	connection.sent = 0;
+	connection.parser.reset(new ResponseParser);
+	connection.expires = connection.job.deadline;
+}
+
+void Burst::AsyncHttpClient::poll(const std::chrono::milliseconds timeout)
+{
+#ifdef __linux__
+	std::array<epoll_event, 64> events;
+	const auto count = epoll_wait(poller_, events.data(), static_cast<int>(events.size()), static_cast<int>(timeout.count()));
+
+	if (count < 0 && errno != EINTR)
+	{
+		log_debug(MinerLogger::session, "Could not poll the connections: %s", Poco::Error::getMessage(Poco::Error::last()));
+		std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	}
+
+	for (auto i = 0; i < count; ++i)
+	{
+		// the wake up only interrupts the wait
+		if (events[i].data.ptr == nullptr)
+		{
+			Poco::UInt64 value;
+
+			if (::read(wakeUp_, &value, sizeof value) < 0)
+				log_debug(MinerLogger::session, "Could not reset the wake up: %s", Poco::Error::getMessage(Poco::Error::last()));
+
+			continue;
+		}
+
+		auto& connection = *static_cast<Connection*>(events[i].data.ptr);
+
+		// the connection was closed by an earlier event
+		if (connection.closed)
+			continue;
+
+		const auto failed = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+
+		onReady(connection, failed || (events[i].events & EPOLLIN) != 0, failed || (events[i].events & EPOLLOUT) != 0);
+	}
+#else
+	Poco::Net::Socket::SocketList readable, writable, failed;
+
+	for (const auto& connection : connections_)
+	{
+		if (connection->closed || !connection->watched)
+			continue;
+
+		if (connection->watchRead)
+			readable.push_back(connection->socket);
+
+		if (connection->watchWrite)
+			writable.push_back(connection->socket);
+
+		failed.push_back(connection->socket);
+	}
+
+	// new requests interrupt the select with the wake up
+	const auto hasWakeUp = wakeUpReader_.impl()->sockfd() != POCO_INVALID_SOCKET;
+
+	if (hasWakeUp)
+		readable.push_back(wakeUpReader_);
+	else if (failed.empty())
+		return std::this_thread::sleep_for(std::min(timeout, std::chrono::milliseconds{20}));
+
+	try
+	{
+		Poco::Net::Socket::select(readable, writable, failed, Poco::Timespan{
+			static_cast<Poco::Timespan::TimeDiff>(timeout.count()) * 1000});
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::session, "Could not poll the connections: %s", exc.displayText());
+		return;
+	}
+
+	const auto contains = [](const Poco::Net::Socket::SocketList& sockets, const Poco::Net::Socket& socket)
+	{
+		return std::find(sockets.begin(), sockets.end(), socket) != sockets.end();
+	};
+
+	// the wake up only interrupts the wait
+	if (hasWakeUp && contains(readable, wakeUpReader_))
+	{
+		std::array<char, 64> buffer;
+
+		try
+		{
+			while (wakeUpReader_.receiveBytes(buffer.data(), static_cast<int>(buffer.size())) > 0)
+				;
+		}
+		catch (Poco::Exception&)
+		{
+			// nothing left to read
+		}
+	}
+
+	for (size_t i = 0; i < connections_.size(); ++i)
+	{
+		auto& connection = *connections_[i];
+
+		if (connection.closed)
+			continue;
+
+		const auto error = contains(failed, connection.socket);
+		const auto read = error || contains(readable, connection.socket);
+		const auto write = error || contains(writable, connection.socket);
+
+		if (read || write)
+			onReady(connection, read, write);
+	}
+#endif
+}
+
+void Burst::AsyncHttpClient::onReady(Connection& connection, const bool readable, const bool writable)
+{
+	try
+	{
+		switch (connection.state)
+		{
+		case Connection::State::Connecting:
+			if (writable)
+				connected(connection);
+			break;
+		case Connection::State::Sending:
+			sendRequest(connection);
+			break;
+		case Connection::State::Receiving:
+			receiveResponse(connection);
+			break;
+		case Connection::State::Idle:
+			// an idle connection has nothing to read, except the host closed it
+			if (readable)
+				close(connection);
+			break;
+		}
+	}
+	catch (std::exception& exc)
+	{
+		const auto* pocoException = dynamic_cast<Poco::Exception*>(&exc);
+		const auto error = pocoException != nullptr ? pocoException->displayText() : std::string{exc.what()};
+
+		if (connection.hasJob)
+			finish(connection, false, error);
+		else
+			close(connection);
+	}
+}
+
+void Burst::AsyncHttpClient::connected(Connection& connection)
+{
+	const auto error = connection.socket.impl()->socketError();
+
+	if (error != 0)
+		throw Poco::Net::ConnectionRefusedException{connection.key, Poco::Error::getMessage(error), error};
+
+	connection.socket.setNoDelay(true);
+
+	if (!connection.hasJob)
+		return park(connection);
+
+	// the tls handshake is done by the first send
+	connection.state = Connection::State::Sending;
+	sendRequest(connection);
+}
+
+void Burst::AsyncHttpClient::sendRequest(Connection& connection)
+{
+	const auto& request = connection.job.request;
+
+	while (connection.sent < request.size())
+	{
+		const auto sent = connection.socket.sendBytes(request.data() + connection.sent,
+			static_cast<int>(request.size() - connection.sent));
+
+		// the socket buffer is full or the tls layer waits for the host
+		if (sent < 0)
+		{
+			const auto wantRead = connection.secure && sent == Poco::Net::SecureStreamSocket::ERR_SSL_WANT_READ;
+			return watch(connection, wantRead, !wantRead);
+		}
+
+		connection.sent += sent;
+	}
+
+	connection.state = Connection::State::Receiving;
+	watch(connection, true, false);
+}
+
+void Burst::AsyncHttpClient::receiveResponse(Connection& connection)
+{
+	std::array<char, 16 * 1024> buffer;
+
+	while (true)
+	{
+		const auto received = connection.socket.receiveBytes(buffer.data(), static_cast<int>(buffer.size()));
+
+		if (received < 0)
+		{
+			const auto wantWrite = connection.secure && received == Poco::Net::SecureStreamSocket::ERR_SSL_WANT_WRITE;
+			return watch(connection, !wantWrite, wantWrite);
+		}
+
+		if (received == 0)
+		{
+			const auto complete = connection.parser->close();
+			return finish(connection, complete, complete ? "" : "The connection was closed by the host");
+		}
+
+		if (connection.parser->feed(buffer.data(), static_cast<size_t>(received)))
+			return finish(connection, true, "");
+	}
+}
+
+void Burst::AsyncHttpClient::finish(Connection& connection, const bool received, const std::string& error)
+{
+	auto job = std::move(connection.job);
+	connection.hasJob = false;
+
+	// the host can close an idle connection, just before it is reused
+	if (!received && connection.reused && !connection.parser->hasData() && !job.retried)
+	{
+		log_debug(MinerLogger::session, "Reused connection to %s failed, sending the request again: %s",
+			job.url.getCanonical(), error);
+
+		close(connection);
+		job.retried = true;
+		return dispatch(std::move(job));
+	}
+
+	AsyncHttpResponse response;
+	response.sent = connection.sent == job.request.size();
+	response.received = received;
+	response.error = error;
+
+	if (received)
+	{
+		const auto& header = connection.parser->getHeader();
+
+		response.status = header.getStatus();
+
+		for (const auto& field : header)
+			response.headers.add(field.first, field.second);
+
+		response.body = std::move(connection.parser->getBody());
+	}
+	else
+		log_debug(MinerLogger::session, "Request to %s failed: %s", job.url.getCanonical(), error);
+
+	const auto idle = std::count_if(connections_.begin(), connections_.end(),
+		[&connection](const std::unique_ptr<Connection>& other)
+		{
+			return !other->closed && other->key == connection.key && other->state == Connection::State::Idle;
+		});
+
+	if (received && connection.parser->isKeepAlive() &&
+		static_cast<size_t>(idle) < MinerConfig::getConfig().getConnectionPoolSize())
+		park(connection);
+	else
+		close(connection);
+
+	if (!job.callback)
+		return;
+
+	try
+	{
+		job.callback(response);
+	}
+	catch (std::exception& exc)
+	{
+		log_error(MinerLogger::session, "Error in the callback of a request to %s: %s", job.url.getCanonical(),
+			std::string{exc.what()});
+	}
+}
+
+void Burst::AsyncHttpClient::fail(Job& job, const std::string& error)
+{
+	if (!job.callback)
+		return;
+
+	AsyncHttpResponse response;
+	response.error = error;
+
+	try
+	{
+		job.callback(response);
+	}
+	catch (std::exception& exc)
+	{
+		log_error(MinerLogger::session, "Error in the callback of a request to %s: %s", job.url.getCanonical(),
+			std::string{exc.what()});
+	}
+}
+
+void Burst::AsyncHttpClient::park(Connection& connection)
+{
+	connection.state = Connection::State::Idle;
+	connection.expires = Clock::now() + std::chrono::seconds{MinerConfig::getConfig().getKeepAliveTimeout()};
+
+	try
+	{
+		watch(connection, true, false);
+	}
+	catch (Poco::Exception&)
+	{
+		close(connection);
+	}
+}
+
+void Burst::AsyncHttpClient::close(Connection& connection)
+{
+	if (connection.closed)
+		return;
+
+#ifdef __linux__
+	if (connection.watched)
+		epoll_ctl(poller_, EPOLL_CTL_DEL, connection.socket.impl()->sockfd(), nullptr);
+#endif
+
+	try
+	{
+		connection.socket.close();
+	}
+	catch (Poco::Exception&)
+	{
+		// the connection is dropped anyway
+	}
+
+	connection.closed = true;
+}
+
+void Burst::AsyncHttpClient::watch(Connection& connection, const bool read, const bool write)
+{
+	if (connection.watched && connection.watchRead == read && connection.watchWrite == write)
+		return;
+
+#ifdef __linux__
+	epoll_event event{};
+	event.events = (read ? EPOLLIN : 0u) | (write ? EPOLLOUT : 0u);
+	event.data.ptr = &connection;
+
+	if (epoll_ctl(poller_, connection.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, connection.socket.impl()->sockfd(), &event) < 0)
+		throw Poco::Net::NetException{"Could not watch the connection", Poco::Error::getMessage(Poco::Error::last())};
+#endif
+
+	connection.watched = true;
+	connection.watchRead = read;
+	connection.watchWrite = write;
+}
+
+std::string Burst::AsyncHttpClient::getKey(const Url& url)
+{
+	return url.getCanonical(true) + ':' + std::to_string(url.getPort());
+}
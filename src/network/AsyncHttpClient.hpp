@@ -0,0 +1,172 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Url.hpp"
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/NameValueCollection.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Poco
+{
+	namespace Net
+	{
+		class HTTPRequest;
+	}
+}
+
+namespace Burst
+{
+	/**
+	 * \brief The response of an asynchronous http request.
+	 */
+	struct AsyncHttpResponse
+	{
+		/**
+		 * \brief true, if the request was sent completely.
+		 */
+		bool sent = false;
+
+		/**
+		 * \brief true, if a complete response was received.
+		 */
+		bool received = false;
+		Poco::Net::HTTPResponse::HTTPStatus status = Poco::Net::HTTPResponse::HTTP_OK;
+		Poco::Net::NameValueCollection headers;
+		std::string body;
+
+		/**
+		 * \brief The reason, why no response was received.
+		 */
+		std::string error;
+
+		bool isOk() const;
+	};
+
+	/**
+	 * \brief A http(s) client, that handles all requests in one event loop.
+	 * The sockets are non-blocking and polled with epoll (select on other platforms),
+	 * so a stalled host does not block a thread per request. Connections are kept alive
+	 * and reused (see MinerConfig::getConnectionPoolSize and MinerConfig::getKeepAliveTimeout).
+	 */
+	class AsyncHttpClient
+	{
+	public:
+		/**
+		 * \brief Called by the event loop, when a request is finished. It must not block.
+		 */
+		using Callback = std::function<void(AsyncHttpResponse& response)>;
+
+		~AsyncHttpClient();
+
+		/**
+		 * \brief Returns the global instance. The event loop is started by the first request.
+		 * \return The client.
+		 */
+		static AsyncHttpClient& instance();
+
+		/**
+		 * \brief Sends a request.
+		 * \param url The url of the host (the path and query are taken from the request).
+		 * \param request The request. The content length is set by the client.
+		 * \param body The body of the request.
+		 * \param callback Called with the response, when the request is finished.
+		 */
+		void send(const Url& url, Poco::Net::HTTPRequest& request, const std::string& body, Callback callback);
+
+		/**
+		 * \brief Sends a request.
+		 * \param url The url of the host (the path and query are taken from the request).
+		 * \param request The request. The content length is set by the client.
+		 * \param body The body of the request.
+		 * \return The response, when the request is finished.
+		 */
+		std::future<AsyncHttpResponse> send(const Url& url, Poco::Net::HTTPRequest& request, const std::string& body = "");
+
+		/**
+		 * \brief Opens a connection to a host in the background, if there is no idle one.
+		 * \param url The url of the host.
+		 */
+		void warmUp(const Url& url);
+
+		/**
+		 * \brief Stops the event loop. All pending requests are finished with an error.
+		 */
+		void stop();
+
+	private:
+		struct Connection;
+
+		struct Job
+		{
+			std::string key;
+			Url url;
+			Poco::Net::SocketAddress address;
+			std::string request;
+			Callback callback;
+			std::chrono::steady_clock::time_point deadline;
+			bool retried = false;
+		};
+
+		AsyncHttpClient();
+		void start();
+		void enqueue(Job job);
+		void wakeUp();
+		void run();
+		void dispatch(Job job);
+		void assign(Connection& connection, Job job);
+		void poll(std::chrono::milliseconds timeout);
+		void onReady(Connection& connection, bool readable, bool writable);
+		void connected(Connection& connection);
+		void sendRequest(Connection& connection);
+		void receiveResponse(Connection& connection);
+		void finish(Connection& connection, bool received, const std::string& error);
+		static void fail(Job& job, const std::string& error);
+		void park(Connection& connection);
+		void close(Connection& connection);
+		void watch(Connection& connection, bool read, bool write);
+		static std::string getKey(const Url& url);
+
+		std::atomic<bool> running_{false};
+		bool stopping_ = false;
+		std::thread thread_;
+		std::mutex mutex_;
+		std::deque<Job> queue_;
+		std::vector<std::unique_ptr<Connection>> connections_;
+		int poller_ = -1, wakeUp_ = -1;
+#ifndef __linux__
+		// select can only be interrupted by a socket, so the wake up is a loopback connection
+		Poco::Net::StreamSocket wakeUpReader_, wakeUpWriter_;
+#endif
+	};
+}
@@ -0,0 +1,278 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "MiningInfoPush.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/WebSocket.h>
+#include <algorithm>
+#include <array>
+
+Burst::MiningInfoPush::MiningInfoPush(Url url, Callback callback)
+	: url_(std::move(url)),
+	  callback_(std::move(callback))
+{}
+
+Burst::MiningInfoPush::~MiningInfoPush()
+{
+	stop();
+}
+
+void Burst::MiningInfoPush::start()
+{
+	if (running_.exchange(true))
+		return;
+
+	thread_ = std::thread(&MiningInfoPush::run, this);
+}
+
+void Burst::MiningInfoPush::stop()
+{
+	if (!running_.exchange(false))
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		// wakes up a reader, that is blocked in the event stream
+		if (session_ != nullptr)
+			session_->abort();
+	}
+
+	stopped_.notify_all();
+
+	if (thread_.joinable())
+		thread_.join();
+}
+
+bool Burst::MiningInfoPush::isConnected() const
+{
+	return connected_;
+}
+
+void Burst::MiningInfoPush::run()
+{
+	auto wait = 1u;
+
+	while (running_)
+	{
+		try
+		{
+			if (isWebSocket())
+				listenWebSocket();
+			else
+				listenEventStream();
+		}
+		catch (Poco::Exception& exc)
+		{
+			if (running_)
+				log_debug(MinerLogger::miner, "Mining info push %s failed: %s", url_.getCanonical(true), exc.displayText());
+		}
+
+		// after a working connection is lost, the first reconnect is immediate
+		if (connected_)
+		{
+			log_debug(MinerLogger::miner, "Mining info push %s disconnected", url_.getCanonical(true));
+			wait = 1;
+		}
+
+		connected_ = false;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		stopped_.wait_for(lock, std::chrono::seconds(wait), [this]() { return !running_; });
+		wait = std::min(wait * 2, 60u);
+	}
+}
+
+void Burst::MiningInfoPush::listenWebSocket()
+{
+	using namespace Poco::Net;
+
+	auto session = createSession();
+
+	if (session == nullptr)
+		return;
+
+	const auto path = url_.getUri().getPathAndQuery();
+	HTTPRequest request{HTTPRequest::HTTP_GET, path.empty() ? "/" : path, HTTPRequest::HTTP_1_1};
+	HTTPResponse response;
+	WebSocket webSocket{*session, request, response};
+
+	// the socket is polled, so that the listener can be stopped
+	webSocket.setReceiveTimeout(Poco::Timespan{1, 0});
+	connected_ = true;
+
+	log_information(MinerLogger::miner, "Listening for mining infos pushed by %s", url_.getCanonical(true));
+
+	std::array<char, 16 * 1024> buffer;
+	std::string message;
+	auto flags = 0;
+
+	while (running_)
+	{
+		int bytes;
+
+		try
+		{
+			bytes = webSocket.receiveFrame(buffer.data(), static_cast<int>(buffer.size()), flags);
+		}
+		catch (Poco::TimeoutException&)
+		{
+			continue;
+		}
+
+		const auto opcode = flags & WebSocket::FRAME_OP_BITMASK;
+
+		if ((bytes == 0 && flags == 0) || opcode == WebSocket::FRAME_OP_CLOSE)
+			break;
+
+		if (opcode == WebSocket::FRAME_OP_PING)
+		{
+			webSocket.sendFrame(buffer.data(), bytes, WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_PONG);
+			continue;
+		}
+
+		if (opcode == WebSocket::FRAME_OP_PONG)
+			continue;
+
+		message.append(buffer.data(), bytes);
+
+		if ((flags & WebSocket::FRAME_FLAG_FIN) != 0)
+		{
+			callback_(message);
+			message.clear();
+		}
+	}
+
+	webSocket.shutdown();
+}
+
+void Burst::MiningInfoPush::listenEventStream()
+{
+	using namespace Poco::Net;
+
+	auto session = createSession();
+
+	if (session == nullptr)
+		return;
+
+	// a pool can be silent for a whole block, so only a long silence is treated as a broken connection
+	session->setTimeout(Poco::Timespan{10 * 60, 0});
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (!running_)
+			return;
+
+		session_ = session.get();
+	}
+
+	const auto unregister = [this]()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		session_ = nullptr;
+	};
+
+	try
+	{
+		const auto path = url_.getUri().getPathAndQuery();
+		HTTPRequest request{HTTPRequest::HTTP_GET, path.empty() ? "/" : path, HTTPRequest::HTTP_1_1};
+		request.set("Accept", "text/event-stream");
+		request.set("Cache-Control", "no-cache");
+		session->sendRequest(request);
+
+		HTTPResponse response;
+		auto& stream = session->receiveResponse(response);
+
+		if (response.getStatus() != HTTPResponse::HTTP_OK)
+		{
+			log_debug(MinerLogger::miner, "Mining info push %s answered with %s", url_.getCanonical(true),
+				std::to_string(static_cast<int>(response.getStatus())));
+			unregister();
+			return;
+		}
+
+		connected_ = true;
+
+		log_information(MinerLogger::miner, "Listening for mining infos pushed by %s", url_.getCanonical(true));
+
+		std::string line, data;
+
+		while (running_ && std::getline(stream, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			// an empty line dispatches the event
+			if (line.empty())
+			{
+				if (!data.empty())
+					callback_(data);
+
+				data.clear();
+			}
+			else if (line.compare(0, 5, "data:") == 0)
+			{
+				if (!data.empty())
+					data += '\n';
+
+				data.append(line, line.size() > 5 && line[5] == ' ' ? 6 : 5, std::string::npos);
+			}
+			// comments (heartbeats), event names and ids are not needed
+		}
+	}
+	catch (...)
+	{
+		unregister();
+		throw;
+	}
+
+	unregister();
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> Burst::MiningInfoPush::createSession() const
+{
+	auto uri = url_.getUri();
+
+	// the websocket handshake is a normal http(s) request
+	if (uri.getScheme() == "ws")
+		uri.setScheme("http");
+	else if (uri.getScheme() == "wss")
+		uri.setScheme("https");
+
+	auto session = Url{uri.toString()}.createSession();
+
+	if (session != nullptr)
+		session->setTimeout(Poco::Timespan{static_cast<long>(MinerConfig::getConfig().getTimeout()), 0});
+
+	return session;
+}
+
+bool Burst::MiningInfoPush::isWebSocket() const
+{
+	const auto& scheme = url_.getUri().getScheme();
+	return scheme == "ws" || scheme == "wss";
+}
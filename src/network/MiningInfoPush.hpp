@@ -0,0 +1,86 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Url.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Poco
+{
+	namespace Net
+	{
+		class HTTPClientSession;
+	}
+}
+
+namespace Burst
+{
+	/**
+	 * \brief Listens for mining infos, that are pushed by the pool.
+	 * ws:// and wss:// urls are read as websocket (one mining info per text frame),
+	 * http:// and https:// urls as server-sent events (one mining info per "data:" event).
+	 * The connection is reopened automatically, until the listener is stopped.
+	 */
+	class MiningInfoPush
+	{
+	public:
+		using Callback = std::function<void(const std::string& miningInfo)>;
+
+		MiningInfoPush(Url url, Callback callback);
+		~MiningInfoPush();
+
+		/**
+		 * \brief Starts listening in the background.
+		 */
+		void start();
+
+		/**
+		 * \brief Closes the connection and waits for the listener.
+		 */
+		void stop();
+
+		/**
+		 * \brief Checks if the listener is connected to the pool at the moment.
+		 */
+		bool isConnected() const;
+
+	private:
+		void run();
+		void listenWebSocket();
+		void listenEventStream();
+		std::unique_ptr<Poco::Net::HTTPClientSession> createSession() const;
+		bool isWebSocket() const;
+
+		Url url_;
+		Callback callback_;
+		std::thread thread_;
+		std::atomic<bool> running_{false}, connected_{false};
+		mutable std::mutex mutex_;
+		std::condition_variable stopped_;
+		Poco::Net::HTTPClientSession* session_ = nullptr;
+	};
+}
@@ -0,0 +1,172 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "MiningInfoSource.hpp"
+#include "MinerUtil.hpp"
+#include "Request.hpp"
+#include "Response.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/Format.h>
+#include <Poco/NestedDiagnosticContext.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <algorithm>
+#include <chrono>
+
+Burst::MiningInfoSource::MiningInfoSource(Url url)
+	: url_(std::move(url))
+{}
+
+Burst::MiningInfoSource::~MiningInfoSource() = default;
+
+const Burst::Url& Burst::MiningInfoSource::getUrl() const
+{
+	return url_;
+}
+
+Burst::MiningInfoSource::Result Burst::MiningInfoSource::request(const Poco::UInt64 blockheight, std::string& miningInfo)
+{
+	using namespace Poco::Net;
+	poco_ndc(MiningInfoSource::request);
+
+	if (session_ == nullptr && !url_.empty())
+	{
+		session_ = url_.createSession();
+
+		if (session_ != nullptr)
+		{
+			session_->setTimeout(secondsToTimespan(MinerConfig::getConfig().getTimeout()));
+			session_->setKeepAlive(true);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (blockheight != requestBlock_)
+		{
+			requestBlock_ = blockheight;
+			requestBlockStart_ = std::chrono::high_resolution_clock::now();
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	Request request(std::move(session_));
+
+	HTTPRequest requestData { HTTPRequest::HTTP_GET, "/burst?requestType=getMiningInfo", HTTPRequest::HTTP_1_1 };
+	requestData.setKeepAlive(true);
+
+	// the pool can hold the request, until there is a block newer than ours
+	if (MinerConfig::getConfig().isMiningInfoLongPoll())
+		requestData.set(X_LongPoll, std::to_string(blockheight));
+
+	auto response = request.send(requestData);
+	std::string responseData;
+	const auto received = response.receive(responseData) && !responseData.empty();
+	const auto roundTrip = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// a broken connection is reconnected by the next request
+	transferSession(request, session_);
+	transferSession(response, session_);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!received)
+	{
+		++errors_;
+		++failures_;
+		return Result::Error;
+	}
+
+	++responses_;
+	failures_ = 0;
+	roundTripSum_ += roundTrip;
+
+	auto message = HttpResponse{responseData}.getMessage();
+
+	if (message == lastMiningInfo_)
+		return Result::Unchanged;
+
+	lastMiningInfo_ = message;
+	miningInfo = std::move(message);
+	return Result::Changed;
+}
+
+void Burst::MiningInfoSource::onBlock(const Poco::UInt64 blockheight, const bool first,
+                                      const std::chrono::high_resolution_clock::time_point blockStart)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// every block is counted only once
+	if (blockheight <= lastBlock_)
+		return;
+
+	lastBlock_ = blockheight;
+
+	if (first)
+		++blocksFirst_;
+	else
+		++blocksLate_;
+
+	// a request, that was in flight before the block started, lags since the block start;
+	// otherwise the time until this source was asked again is its poll phase and not a lag
+	const auto lagStart = requestBlock_ == blockheight ? std::max(blockStart, requestBlockStart_) : blockStart;
+	const auto lag = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - lagStart).count();
+
+	// the lag is smoothed, so that a single slow block does not demote the source;
+	// a demoted source is polled less often, so its lag is not measured, but decays until it is promoted again
+	if (first || lag_ > 2.0)
+		lag_ *= 0.7;
+	else
+		lag_ = 0.7 * lag_ + 0.3 * lag;
+}
+
+void Burst::MiningInfoSource::onError()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	++errors_;
+	++failures_;
+
+	// the same invalid mining info is processed (and reported) again
+	lastMiningInfo_.clear();
+}
+
+bool Burst::MiningInfoSource::isDemoted() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return failures_ >= 3 || lag_ > 2.0;
+}
+
+std::string Burst::MiningInfoSource::getStatistics() const
+{
+	const auto demoted = isDemoted();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return Poco::format("%s: first with %s of %s blocks, lag %sms, round trip %sms, errors %s%s",
+		url_.getCanonical(true),
+		std::to_string(blocksFirst_),
+		std::to_string(blocksFirst_ + blocksLate_),
+		std::to_string(static_cast<Poco::UInt64>(lag_ * 1000)),
+		std::to_string(static_cast<Poco::UInt64>(responses_ > 0 ? roundTripSum_ / responses_ * 1000 : 0)),
+		std::to_string(errors_),
+		std::string(demoted ? " (demoted)" : ""));
+}
@@ -0,0 +1,108 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Url.hpp"
+#include <Poco/Types.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Poco
+{
+	namespace Net
+	{
+		class HTTPClientSession;
+	}
+}
+
+namespace Burst
+{
+	/**
+	 * \brief A host, that is polled for the mining info.
+	 * Several sources can be polled at the same time; every source keeps statistics about
+	 * how often it was the first one with a new block and how far it lagged behind otherwise.
+	 */
+	class MiningInfoSource
+	{
+	public:
+		enum class Result
+		{
+			Error,
+			Unchanged,
+			Changed
+		};
+
+		explicit MiningInfoSource(Url url);
+		~MiningInfoSource();
+
+		const Url& getUrl() const;
+
+		/**
+		 * \brief Requests the mining info.
+		 * \param blockheight The current block height (sent with long polls).
+		 * \param miningInfo The mining info, if it changed since the last request.
+		 * \return Error, if the request failed, Unchanged, if the mining info is byte-identical
+		 * to the last one.
+		 */
+		Result request(Poco::UInt64 blockheight, std::string& miningInfo);
+
+		/**
+		 * \brief Records, that the source reported a block.
+		 * \param blockheight The height of the block.
+		 * \param first true, if the block was started because of this source.
+		 * \param blockStart The time point, at which another source reported the block.
+		 * The lag is measured from there or from the first request of this source after it,
+		 * so that the poll interval of this source does not count as lag.
+		 */
+		void onBlock(Poco::UInt64 blockheight, bool first, std::chrono::high_resolution_clock::time_point blockStart);
+
+		/**
+		 * \brief Records, that the mining info of the source was invalid.
+		 */
+		void onError();
+
+		/**
+		 * \brief Checks if the source fails or usually lags behind the others.
+		 * Such a source is polled less often.
+		 */
+		bool isDemoted() const;
+
+		/**
+		 * \brief Returns the statistics of the source as a readable line.
+		 */
+		std::string getStatistics() const;
+
+	private:
+		Url url_;
+		std::unique_ptr<Poco::Net::HTTPClientSession> session_;
+		std::string lastMiningInfo_;
+		mutable std::mutex mutex_;
+		Poco::UInt64 responses_ = 0, errors_ = 0, blocksFirst_ = 0, blocksLate_ = 0, lastBlock_ = 0;
+		unsigned failures_ = 0;
+		double roundTripSum_ = 0, lag_ = 0;
+		// the block height sent with the last requests and when the first of them was sent
+		Poco::UInt64 requestBlock_ = 0;
+		std::chrono::high_resolution_clock::time_point requestBlockStart_;
+	};
+}
@@ -28,98 +28,55 @@
 #include "mining/Miner.hpp"
 #include <fstream>
 #include "logging/Output.hpp"
-#include <chrono>
-#include <thread>
 
 Burst::NonceSubmitter::NonceSubmitter(Miner& miner, std::shared_ptr<Deadline> deadline)
-	: Task(serializeDeadline(*deadline)),
-	  submitAsync(this, &NonceSubmitter::submit),
-	  miner(miner),
-	  deadline(deadline)
+	: miner(miner),
+	  deadline(std::move(deadline))
 {}
 
-void Burst::NonceSubmitter::runTask()
+bool Burst::NonceSubmitter::isSuperseded() const
 {
-	submit();
+	const auto bestSent = miner.getBestSent(deadline->getAccountId(), deadline->getBlock());
+	return bestSent != nullptr && bestSent->getDeadline() < deadline->getDeadline();
 }
 
-Burst::NonceConfirmation Burst::NonceSubmitter::submit()
+void Burst::NonceSubmitter::send(AsyncHttpClient::Callback callback)
 {
-	auto accountName = deadline->getAccountName();
-	auto betterDeadlineInPipeline = false;
+	NonceRequest request{MinerConfig::getConfig().getPoolUrl()};
 
-	auto loopConditionHelper = [this, &betterDeadlineInPipeline](unsigned tryCount, unsigned maxTryCount, SubmitResponse response)
-	{
-		if ((maxTryCount > 0 && tryCount >= maxTryCount) ||
-			response == SubmitResponse::Error ||
-			response == SubmitResponse::Confirmed ||
-			deadline->getBlock() != miner.getBlockheight() ||
-			betterDeadlineInPipeline)
-			return false;
-
-		auto bestSent = miner.getBestSent(deadline->getAccountId(), deadline->getBlock());
-		betterDeadlineInPipeline = false;
-
-		if (bestSent != nullptr)
-		{
-			betterDeadlineInPipeline = bestSent->getDeadline() < deadline->getDeadline();
-			//MinerLogger::write("Best sent nonce so far: " + bestSent->deadlineToReadableString() + " vs. this deadline: "
-			//+ deadlineFormat(deadline->getDeadline()), TextType::Debug);
-		}
-
-		if (betterDeadlineInPipeline)
-			return false;
-
-		return true;
-	};
-
-	//MinerLogger::write("sending nonce from thread, " + deadlineFormat(deadlineValue), TextType::System);
+	// the event loop of the http client finishes the request at the latest after the timeout
+	request.submit(*deadline, std::move(callback));
+}
 
+Burst::NonceConfirmation Burst::NonceSubmitter::getConfirmation(AsyncHttpResponse response)
+{
 	NonceConfirmation confirmation { 0, SubmitResponse::None };
-	unsigned submitTryCount = 0;
-	auto firstSendAttempt = true;
 
-	// submit-loop
-	while (loopConditionHelper(submitTryCount,
-		MinerConfig::getConfig().getSubmissionMaxRetry(),
-		confirmation.errorCode))
-	{
-		log_debug(MinerLogger::nonceSubmitter, "Submit-loop %u (%s)", submitTryCount + 1, deadline->deadlineToReadableString());
-
-		if (submitTryCount)
-		{
-			log_debug(MinerLogger::nonceSubmitter,"WAITING......................");
-			std::this_thread::sleep_for(std::chrono::seconds(5));
-		}
+	if (!response.sent)
+		return confirmation;
 
-		NonceRequest request{MinerConfig::getConfig().createSession(HostType::Pool)};
+	if (!deadline->isSent())
+	{
+		deadline->send();
+		log_ok_if(MinerLogger::nonceSubmitter, MinerLogger::hasOutput(NonceSent), "%s: nonce submitted (%s)\n"
+			"\tnonce: %s\n"
+			"\tin:    %s",
+			deadline->getAccountName(), deadlineFormat(deadline->getDeadline()),
+			numberToString(deadline->getNonce()),
+			deadline->getPlotFile());
+	}
 
-		auto response = request.submit(*deadline);
-		auto receiveTryCount = 0u;
+	confirmation = NonceResponse{std::move(response)}.getConfirmation();
 
-		if (response.canReceive() && firstSendAttempt)
-		{
-			deadline->send();
-			confirmation.errorCode = SubmitResponse::Submitted;
-			log_ok_if(MinerLogger::nonceSubmitter, MinerLogger::hasOutput(NonceSent), "%s: nonce submitted (%s)\n"
-				"\tnonce: %s\n"
-				"\tin:    %s",
-				accountName, deadlineFormat(deadline->getDeadline()),
-				numberToString(deadline->getNonce()),
-				deadline->getPlotFile());
-			firstSendAttempt = false;
-		}
+	if (confirmation.errorCode != SubmitResponse::Confirmed && confirmation.errorCode != SubmitResponse::Error)
+		confirmation.errorCode = SubmitResponse::Submitted;
 
-		while (loopConditionHelper(receiveTryCount,
-			MinerConfig::getConfig().getReceiveMaxRetry(),
-			confirmation.errorCode))
-		{
-			confirmation = response.getConfirmation();
-			++receiveTryCount;
-		}
+	return confirmation;
+}
 
-		++submitTryCount;
-	}
+void Burst::NonceSubmitter::finish(const NonceConfirmation& confirmation)
+{
+	const auto accountName = deadline->getAccountName();
 
 	log_debug(MinerLogger::nonceSubmitter, "JSON confirmation (%s)\n\t%s", deadline->deadlineToReadableString(), confirmation.json);
 
@@ -187,12 +144,10 @@ Burst::NonceConfirmation Burst::NonceSubmitter::submit()
 				deadline->confirm();
 			}
 		}
-		else if (betterDeadlineInPipeline)
-			log_debug(MinerLogger::nonceSubmitter, "Better deadline in pipeline, stop submitting! (%s)", deadlineFormat(deadline->getDeadline()));
 		else
 		{
 			// sent, but not confirmed
-			if (firstSendAttempt)
+			if (!deadline->isSent())
 				log_warning(MinerLogger::nonceSubmitter, "%s: could not submit nonce! This is probably a network issue. (%s)",
 					accountName, deadlineFormat(deadline->getDeadline()));
 			else if (confirmation.errorCode == SubmitResponse::Error)
@@ -208,6 +163,4 @@ Burst::NonceConfirmation Burst::NonceSubmitter::submit()
 		log_debug(MinerLogger::nonceSubmitter, "Found nonce was for the last block, stopped submitting! (%s)",
 			deadlineFormat(deadline->getDeadline()));
 	}
-
-	return confirmation;
 }
@@ -22,7 +22,6 @@
 #pragma once
 
 #include <memory>
-#include <Poco/Task.h>
 #include "Response.hpp"
 
 namespace Burst
@@ -30,16 +29,40 @@ namespace Burst
 	class Miner;
 	class Deadline;
 
-	class NonceSubmitter : public Poco::Task
+	/**
+	 * \brief Submits a single deadline to the pool.
+	 * Retries and their timing are up to the caller (see SubmissionScheduler).
+	 */
+	class NonceSubmitter
 	{
 	public:
 		NonceSubmitter(Miner& miner, std::shared_ptr<Deadline> deadline);
-		~NonceSubmitter() override = default;
 
-		Poco::ActiveMethod<NonceConfirmation, void, NonceSubmitter> submitAsync;
-		NonceConfirmation submit();
+		/**
+		 * \brief Makes one submission attempt without waiting for the confirmation.
+		 * \param callback Called by the event loop of the AsyncHttpClient with the response of the pool.
+		 */
+		void send(AsyncHttpClient::Callback callback);
 
-		void runTask() override;
+		/**
+		 * \brief Processes the response of a submission attempt.
+		 * \param response The response passed to the callback of send().
+		 * \return The confirmation of the pool; Submitted if the nonce was sent but
+		 * not confirmed, None if it could not be sent at all.
+		 */
+		NonceConfirmation getConfirmation(AsyncHttpResponse response);
+
+		/**
+		 * \brief Checks if a better deadline for the same account and block was already sent.
+		 * \return true, if this deadline does not need to be submitted anymore.
+		 */
+		bool isSuperseded() const;
+
+		/**
+		 * \brief Processes the final result of the submission (logging, confirmed deadlines file).
+		 * \param confirmation The last confirmation returned by getConfirmation().
+		 */
+		void finish(const NonceConfirmation& confirmation);
 
 	private:
 		Miner& miner;
@@ -21,6 +21,7 @@
 
 #include "Request.hpp"
 #include "Response.hpp"
+#include "AsyncHttpClient.hpp"
 #include "nxt/nxt_address.h"
 #include "logging/MinerLogger.hpp"
 #include "mining/MinerConfig.hpp"
@@ -79,11 +80,11 @@ std::unique_ptr<Poco::Net::HTTPClientSession> Burst::Request::transferSession()
 	return std::move(session_);
 }
 
-Burst::NonceRequest::NonceRequest(std::unique_ptr<Poco::Net::HTTPClientSession> socket)
-	: request_(std::move(socket))
+Burst::NonceRequest::NonceRequest(Url url)
+	: url_(std::move(url))
 {}
 
-Burst::NonceResponse Burst::NonceRequest::submit(const Deadline& deadline)
+void Burst::NonceRequest::submit(const Deadline& deadline, AsyncHttpClient::Callback callback)
 {
 	poco_ndc(NonceRequest::submit);
 
@@ -108,18 +109,8 @@ Burst::NonceResponse Burst::NonceRequest::submit(const Deadline& deadline)
 	request.set(X_Miner, deadline.getMiner());
 	request.set(X_Deadline, std::to_string(deadline.getDeadline()));
 	request.set(X_Plotfile, plotFileStr);
-	request.setKeepAlive(false);
+	request.setKeepAlive(true);
 	request.setContentLength(0);
 
-	auto response = request_.send(request);
-
-	if (response.canReceive())
-		return{ response.transferSession() };
-
-	return{ nullptr };
-}
-
-std::unique_ptr<Poco::Net::HTTPClientSession> Burst::NonceRequest::transferSession()
-{
-	return request_.transferSession();
+	AsyncHttpClient::instance().send(url_, request, "", std::move(callback));
 }
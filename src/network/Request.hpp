@@ -21,9 +21,11 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 #include "Response.hpp"
+#include "Url.hpp"
 #include <Poco/Net/HTTPClientSession.h>
 
 namespace Poco {namespace Net {
@@ -36,6 +38,7 @@ namespace Burst
 	const std::string X_Deadline = "X-Deadline";
 	const std::string X_Capacity = "X-Capacity";
 	const std::string X_Miner = "X-Miner";
+	const std::string X_LongPoll = "X-LongPoll";
 
 	class Deadline;
 
@@ -62,13 +65,16 @@ namespace Burst
 	class NonceRequest
 	{
 	public:
-		NonceRequest(std::unique_ptr<Poco::Net::HTTPClientSession> socket);
+		NonceRequest(Url url);
 
-		NonceResponse submit(const Deadline& deadline);
-
-		std::unique_ptr<Poco::Net::HTTPClientSession> transferSession();
+		/**
+		 * \brief Submits a nonce with the AsyncHttpClient.
+		 * \param deadline The deadline of the nonce.
+		 * \param callback Called with the response of the pool, when the request is finished.
+		 */
+		void submit(const Deadline& deadline, AsyncHttpClient::Callback callback);
 
 	private:
-		Request request_;
+		Url url_;
 	};
 }
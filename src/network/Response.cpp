@@ -88,23 +88,21 @@ bool Burst::Response::isDataThere() const
 		Poco::Net::Socket::SELECT_READ);
 }
 
-Burst::NonceResponse::NonceResponse(std::unique_ptr<Poco::Net::HTTPClientSession> session)
-	: response_(std::move(session))
+Burst::NonceResponse::NonceResponse(AsyncHttpResponse response)
+	: response_(std::move(response))
 {}
 
-bool Burst::NonceResponse::canReceive() const
-{
-	return response_.canReceive();
-}
-
-Burst::NonceConfirmation Burst::NonceResponse::getConfirmation()
+Burst::NonceConfirmation Burst::NonceResponse::getConfirmation() const
 {
 	poco_ndc(NonceResponse::getConfirmation);
 	
-	std::string response;
+	const auto& response = response_.body;
 	NonceConfirmation confirmation{ 0, SubmitResponse::None };
 
-	if (response_.receive(response))
+	if (!response_.received)
+		log_error(MinerLogger::socket, "Error on receiving response!\n%s", response_.error);
+
+	if (response_.isOk())
 	{
 		try
 		{
@@ -151,21 +149,6 @@ Burst::NonceConfirmation Burst::NonceResponse::getConfirmation()
 	return confirmation;
 }
 
-bool Burst::NonceResponse::isDataThere()
-{
-	return response_.isDataThere();
-}
-
-std::unique_ptr<Poco::Net::HTTPClientSession> Burst::NonceResponse::transferSession()
-{
-	return response_.transferSession();
-}
-
-const Poco::Exception* Burst::NonceResponse::getLastError() const
-{
-	return response_.getLastError();
-}
-
 Burst::HttpResponse::HttpResponse(const std::string& response)
 {
 	setResponse(response);
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <Poco/Net/HTTPClientSession.h>
+#include "AsyncHttpClient.hpp"
 
 namespace Burst
 {
@@ -72,17 +73,12 @@ namespace Burst
 	class NonceResponse
 	{
 	public:
-		NonceResponse(std::unique_ptr<Poco::Net::HTTPClientSession> session);
+		NonceResponse(AsyncHttpResponse response);
 
-		bool canReceive() const;
-		NonceConfirmation getConfirmation();
-		bool isDataThere();
-
-		std::unique_ptr<Poco::Net::HTTPClientSession> transferSession();
-		const Poco::Exception* getLastError() const;
+		NonceConfirmation getConfirmation() const;
 
 	private:
-		Response response_;
+		AsyncHttpResponse response_;
 	};
 
 	class HttpResponse
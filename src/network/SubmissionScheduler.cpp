@@ -0,0 +1,381 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "SubmissionScheduler.hpp"
+#include "NonceSubmitter.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/Deadline.hpp"
+#include "mining/Miner.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/Format.h>
+#include <algorithm>
+
+Burst::SubmissionScheduler::SubmissionScheduler(Miner& miner)
+	: miner_(miner),
+	  random_(std::random_device{}())
+{}
+
+Burst::SubmissionScheduler::~SubmissionScheduler()
+{
+	stop();
+}
+
+void Burst::SubmissionScheduler::start(const unsigned maxInFlight)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (running_)
+		return;
+
+	running_ = true;
+	maxInFlight_ = std::max(maxInFlight, 1u);
+	worker_ = std::thread(&SubmissionScheduler::work, this);
+}
+
+void Burst::SubmissionScheduler::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (!running_)
+			return;
+
+		running_ = false;
+
+		for (auto& pending : pending_)
+			resolve(*pending.second, SubmitResponse::None);
+
+		pending_.clear();
+	}
+
+	condition_.notify_all();
+
+	// the worker exits, when the submissions in flight are finished
+	if (worker_.joinable())
+		worker_.join();
+}
+
+std::future<Burst::NonceConfirmation> Burst::SubmissionScheduler::submit(std::shared_ptr<Deadline> deadline)
+{
+	auto submission = std::make_shared<Submission>();
+	submission->deadline = std::move(deadline);
+	submission->queued = submission->notBefore = Clock::now();
+
+	auto future = submission->promise.get_future();
+	const auto accountId = submission->deadline->getAccountId();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!running_)
+	{
+		resolve(*submission, SubmitResponse::None);
+		return future;
+	}
+
+	auto iter = pending_.find(accountId);
+
+	if (iter != pending_.end())
+	{
+		// only the best deadline of an account is worth sending
+		if (iter->second->deadline->getDeadline() <= submission->deadline->getDeadline())
+		{
+			++metrics_.superseded;
+			resolve(*submission, SubmitResponse::NotBest);
+			return future;
+		}
+
+		log_debug(MinerLogger::nonceSubmitter, "Pending deadline was replaced by a better one (%s)",
+			iter->second->deadline->deadlineToReadableString());
+
+		++metrics_.superseded;
+		resolve(*iter->second, SubmitResponse::NotBest);
+		iter->second = submission;
+	}
+	else
+		pending_.emplace(accountId, submission);
+
+	++metrics_.queued;
+	metrics_.maxQueueDepth = std::max(metrics_.maxQueueDepth, pending_.size());
+	condition_.notify_one();
+
+	return future;
+}
+
+void Burst::SubmissionScheduler::cancel(const Poco::UInt64 blockheight)
+{
+	Metrics metrics;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		for (auto iter = pending_.begin(); iter != pending_.end();)
+		{
+			if (iter->second->deadline->getBlock() != blockheight)
+			{
+				++metrics_.cancelled;
+				resolve(*iter->second, SubmitResponse::WrongBlock);
+				iter = pending_.erase(iter);
+			}
+			else
+				++iter;
+		}
+
+		metrics = metrics_;
+		metrics_ = {};
+	}
+
+	if (metrics.queued == 0)
+		return;
+
+	log_unimportant(MinerLogger::nonceSubmitter, "Submissions of the last round\n"
+		"\tqueued:     %s (superseded: %s, cancelled: %s)\n"
+		"\tsent:       %s (retries: %s)\n"
+		"\tconfirmed:  %s (failed: %s)\n"
+		"\tmax. queue: %s (in flight: %s)\n"
+		"\tlatency:    %sms (max: %sms)",
+		std::to_string(metrics.queued), std::to_string(metrics.superseded), std::to_string(metrics.cancelled),
+		std::to_string(metrics.sent), std::to_string(metrics.retries),
+		std::to_string(metrics.confirmed), std::to_string(metrics.failed),
+		std::to_string(metrics.maxQueueDepth), std::to_string(metrics.maxInFlight),
+		std::to_string(static_cast<Poco::UInt64>(metrics.confirmed > 0 ? metrics.latencySum / metrics.confirmed : 0)),
+		std::to_string(static_cast<Poco::UInt64>(metrics.latencyMax)));
+}
+
+Burst::SubmissionScheduler::Metrics Burst::SubmissionScheduler::getMetrics() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return metrics_;
+}
+
+void Burst::SubmissionScheduler::work()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	while (running_ || inFlight_ > 0)
+	{
+		// the responses are processed here and not in the event loop of the http client,
+		// which must not block
+		if (!finished_.empty())
+		{
+			auto submission = std::move(finished_.front());
+			finished_.pop_front();
+			--inFlight_;
+
+			lock.unlock();
+			complete(submission);
+			lock.lock();
+			continue;
+		}
+
+		auto wakeUp = Clock::time_point::max();
+
+		if (running_ && inFlight_ < maxInFlight_)
+		{
+			auto submission = next(wakeUp);
+
+			if (submission != nullptr)
+			{
+				++inFlight_;
+				metrics_.maxInFlight = std::max(metrics_.maxInFlight, inFlight_);
+
+				lock.unlock();
+				const auto sent = process(submission);
+				lock.lock();
+
+				if (!sent)
+					--inFlight_;
+
+				continue;
+			}
+		}
+
+		if (wakeUp == Clock::time_point::max())
+			condition_.wait(lock);
+		else
+			condition_.wait_until(lock, wakeUp);
+	}
+}
+
+std::shared_ptr<Burst::SubmissionScheduler::Submission> Burst::SubmissionScheduler::next(Clock::time_point& wakeUp)
+{
+	const auto now = Clock::now();
+	auto best = pending_.end();
+
+	// the lowest deadline, that is not waiting for its retry, is sent first
+	for (auto iter = pending_.begin(); iter != pending_.end(); ++iter)
+	{
+		const auto& submission = *iter->second;
+
+		if (submission.notBefore > now)
+			wakeUp = std::min(wakeUp, submission.notBefore);
+		else if (best == pending_.end() ||
+			submission.deadline->getDeadline() < best->second->deadline->getDeadline())
+			best = iter;
+	}
+
+	if (best == pending_.end())
+		return nullptr;
+
+	auto submission = best->second;
+	pending_.erase(best);
+	return submission;
+}
+
+bool Burst::SubmissionScheduler::process(std::shared_ptr<Submission> submission)
+{
+	auto& deadline = submission->deadline;
+	NonceSubmitter submitter{miner_, deadline};
+
+	if (deadline->getBlock() != miner_.getBlockheight())
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++metrics_.cancelled;
+		resolve(*submission, SubmitResponse::WrongBlock);
+		return false;
+	}
+
+	if (submitter.isSuperseded())
+	{
+		log_debug(MinerLogger::nonceSubmitter, "Better deadline in pipeline, stop submitting! (%s)", deadlineFormat(deadline->getDeadline()));
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		++metrics_.superseded;
+		resolve(*submission, SubmitResponse::NotBest);
+		return false;
+	}
+
+	log_debug(MinerLogger::nonceSubmitter, "Submit attempt %u (%s)", submission->attempts + 1, deadline->deadlineToReadableString());
+
+	submitter.send([this, submission](AsyncHttpResponse& response)
+	{
+		submission->response = std::move(response);
+
+		// notified under the lock, because the scheduler can be stopped as soon as the worker sees the response
+		std::lock_guard<std::mutex> lock(mutex_);
+		finished_.emplace_back(submission);
+		condition_.notify_all();
+	});
+
+	return true;
+}
+
+void Burst::SubmissionScheduler::complete(std::shared_ptr<Submission> submission)
+{
+	auto& deadline = submission->deadline;
+	NonceSubmitter submitter{miner_, deadline};
+
+	const auto confirmation = submitter.getConfirmation(std::move(submission->response));
+	const auto maxAttempts = MinerConfig::getConfig().getSubmissionMaxRetry();
+	const auto latency = std::chrono::duration<double, std::milli>(Clock::now() - submission->queued).count();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (confirmation.errorCode != SubmitResponse::None)
+			++metrics_.sent;
+
+		if (submission->attempts > 0)
+			++metrics_.retries;
+	}
+
+	++submission->attempts;
+
+	if (confirmation.errorCode == SubmitResponse::Confirmed ||
+		confirmation.errorCode == SubmitResponse::Error ||
+		deadline->getBlock() != miner_.getBlockheight() ||
+		(maxAttempts > 0 && submission->attempts >= maxAttempts))
+	{
+		submitter.finish(confirmation);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (confirmation.errorCode == SubmitResponse::Confirmed)
+		{
+			++metrics_.confirmed;
+			metrics_.latencySum += latency;
+			metrics_.latencyMax = std::max(metrics_.latencyMax, latency);
+		}
+		else if (deadline->getBlock() != miner_.getBlockheight())
+			++metrics_.cancelled;
+		else
+			++metrics_.failed;
+
+		submission->promise.set_value(confirmation);
+		return;
+	}
+
+	retry(submission);
+}
+
+void Burst::SubmissionScheduler::retry(std::shared_ptr<Submission> submission)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!running_)
+	{
+		resolve(*submission, SubmitResponse::None);
+		return;
+	}
+
+	// a better deadline of the same account was found in the meantime
+	if (pending_.find(submission->deadline->getAccountId()) != pending_.end())
+	{
+		++metrics_.superseded;
+		resolve(*submission, SubmitResponse::NotBest);
+		return;
+	}
+
+	const auto backoff = getBackoff(submission->attempts);
+
+	log_debug(MinerLogger::nonceSubmitter, "Retrying in %sms (%s)",
+		std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(backoff).count()),
+		submission->deadline->deadlineToReadableString());
+
+	submission->notBefore = Clock::now() + backoff;
+	pending_.emplace(submission->deadline->getAccountId(), submission);
+	condition_.notify_one();
+}
+
+void Burst::SubmissionScheduler::resolve(Submission& submission, const SubmitResponse response)
+{
+	const auto deadline = submission.deadline->getDeadline();
+
+	NonceConfirmation confirmation;
+	confirmation.deadline = 0;
+	confirmation.json = Poco::format(
+		R"({ "result" : "success", "deadline" : %Lu, "deadlineText" : "%s", "deadlineString" : "%s" })", deadline,
+		deadlineFormat(deadline), deadlineFormat(deadline));
+	confirmation.errorCode = response;
+
+	submission.promise.set_value(confirmation);
+}
+
+Burst::SubmissionScheduler::Clock::duration Burst::SubmissionScheduler::getBackoff(const unsigned attempts)
+{
+	// 1s, 2s, 4s, ... up to 30s, every delay is jittered by +-50%,
+	// so that many miners of a pool don't retry at the same time
+	const auto exponent = std::min(attempts > 0 ? attempts - 1 : 0u, 5u);
+	const auto delay = std::min(1000. * (1u << exponent), 30000.);
+	std::uniform_real_distribution<double> jitter(0.5, 1.5);
+
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(delay * jitter(random_)));
+}
@@ -0,0 +1,136 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Declarations.hpp"
+#include "Response.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace Burst
+{
+	class Miner;
+	class Deadline;
+
+	/**
+	 * \brief Schedules the submission of found deadlines to the pool.
+	 * Every account has at most one pending deadline; a better one replaces the pending one.
+	 * The pending deadlines are sent with the AsyncHttpClient, the lowest deadline first, and
+	 * the number of requests in flight to the pool is limited. One thread starts the requests
+	 * and processes the responses, so a pending request does not occupy a thread. Failed
+	 * submissions are retried with a jittered exponential backoff.
+	 */
+	class SubmissionScheduler
+	{
+	public:
+		/**
+		 * \brief The statistics of one round.
+		 */
+		struct Metrics
+		{
+			Poco::UInt64 queued = 0;
+			Poco::UInt64 superseded = 0;
+			Poco::UInt64 sent = 0;
+			Poco::UInt64 retries = 0;
+			Poco::UInt64 confirmed = 0;
+			Poco::UInt64 failed = 0;
+			Poco::UInt64 cancelled = 0;
+			size_t maxQueueDepth = 0;
+			size_t maxInFlight = 0;
+			double latencySum = 0;
+			double latencyMax = 0;
+		};
+
+		explicit SubmissionScheduler(Miner& miner);
+		~SubmissionScheduler();
+
+		/**
+		 * \brief Starts the scheduler. Does nothing, if it is already running.
+		 * \param maxInFlight The max. number of submissions, that are sent at the same time.
+		 */
+		void start(unsigned maxInFlight);
+
+		/**
+		 * \brief Drops all pending deadlines and stops the scheduler, when the submissions in flight are finished.
+		 */
+		void stop();
+
+		/**
+		 * \brief Queues a deadline for submission.
+		 * \param deadline The deadline.
+		 * \return The final confirmation of the deadline. Deadlines, that were replaced by a better one,
+		 * are resolved with NotBest, deadlines of an old block with WrongBlock.
+		 */
+		std::future<NonceConfirmation> submit(std::shared_ptr<Deadline> deadline);
+
+		/**
+		 * \brief Drops all pending deadlines, that are not for the given block, and logs the
+		 * statistics of the last round.
+		 * \param blockheight The height of the current block.
+		 */
+		void cancel(Poco::UInt64 blockheight);
+
+		/**
+		 * \brief Returns the statistics of the current round.
+		 */
+		Metrics getMetrics() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Submission
+		{
+			std::shared_ptr<Deadline> deadline;
+			std::promise<NonceConfirmation> promise;
+			unsigned attempts = 0;
+			Clock::time_point notBefore;
+			Clock::time_point queued;
+			AsyncHttpResponse response;
+		};
+
+		void work();
+		std::shared_ptr<Submission> next(Clock::time_point& wakeUp);
+		bool process(std::shared_ptr<Submission> submission);
+		void complete(std::shared_ptr<Submission> submission);
+		void retry(std::shared_ptr<Submission> submission);
+		void resolve(Submission& submission, SubmitResponse response);
+		Clock::duration getBackoff(unsigned attempts);
+
+		Miner& miner_;
+		mutable std::mutex mutex_;
+		std::condition_variable condition_;
+		std::map<AccountId, std::shared_ptr<Submission>> pending_;
+		std::deque<std::shared_ptr<Submission>> finished_;
+		std::thread worker_;
+		size_t inFlight_ = 0, maxInFlight_ = 1;
+		bool running_ = false;
+		Metrics metrics_;
+		std::mt19937 random_;
+	};
+}
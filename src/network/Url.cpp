@@ -25,6 +25,17 @@
 #include <Poco/Net/HTTPSessionFactory.h>
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/String.h>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::mutex addressesMutex;
+	std::unordered_map<std::string, std::pair<Poco::Net::SocketAddress, Clock::time_point>> addresses;
+}
 
 Burst::Url::Url(const std::string& url, const std::string& defaultScheme, unsigned short defaultPort)
 	: uri_{url}
@@ -98,3 +109,34 @@ std::unique_ptr<Poco::Net::HTTPClientSession> Burst::Url::createSession() const
 		return nullptr;
 	}
 }
+
+bool Burst::Url::resolve(Poco::Net::SocketAddress& address) const
+{
+	const auto key = getCanonical() + ':' + std::to_string(getPort());
+	const auto now = Clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock{addressesMutex};
+		const auto iter = addresses.find(key);
+
+		if (iter != addresses.end() && now - iter->second.second < std::chrono::minutes{1})
+		{
+			address = iter->second.first;
+			return true;
+		}
+	}
+
+	try
+	{
+		address = Poco::Net::SocketAddress{uri_.getHost(), getPort()};
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::session, "Could not resolve %s: %s", uri_.getHost(), exc.displayText());
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{addressesMutex};
+	addresses[key] = {address, now};
+	return true;
+}
@@ -24,6 +24,7 @@
 #include <string>
 #include <Poco/URI.h>
 #include <Poco/Net/IPAddress.h>
+#include <Poco/Net/SocketAddress.h>
 #include <memory>
 #include <functional>
 
@@ -49,6 +50,15 @@ namespace Burst
 		bool empty() const;
 		std::unique_ptr<Poco::Net::HTTPClientSession> createSession() const;
 
+		/**
+		 * \brief Resolves the host and port of the url.
+		 * The addresses are cached for a minute and shared by all urls of the same host,
+		 * so a new connection does not wait for the name resolution.
+		 * \param address The resolved address.
+		 * \return true, if the host could be resolved.
+		 */
+		bool resolve(Poco::Net::SocketAddress& address) const;
+
 	private:
 		Poco::URI uri_;
 		Poco::Net::IPAddress ip_;
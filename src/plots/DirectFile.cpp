@@ -0,0 +1,165 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "DirectFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <cerrno>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+constexpr Poco::UInt64 Burst::DirectFile::Alignment;
+
+Burst::DirectFile::DirectFile(const std::string& path, const bool writable)
+	: fd_{-1}, bytesRead_{0}, lastError_{0}
+{
+#ifdef __linux__
+	fd_ = open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_DIRECT);
+#else
+	(void)path;
+	(void)writable;
+#endif
+}
+
+Burst::DirectFile::~DirectFile()
+{
+#ifdef __linux__
+	if (fd_ >= 0)
+		close(fd_);
+#endif
+}
+
+bool Burst::DirectFile::isOpen() const
+{
+	return fd_ >= 0;
+}
+
+bool Burst::DirectFile::read(char* buffer, const Poco::UInt64 offset, const Poco::UInt64 bytes)
+{
+#ifdef __linux__
+	lastError_ = 0;
+
+	if (!isOpen())
+		return false;
+
+	// widen the read to the next aligned borders
+	const auto alignedBegin = offset / Alignment * Alignment;
+	const auto alignedEnd = (offset + bytes + Alignment - 1) / Alignment * Alignment;
+	const auto alignedSize = alignedEnd - alignedBegin;
+
+	auto alignedBuffer = getAlignedBuffer(alignedSize);
+	Poco::UInt64 bytesRead = 0;
+
+	while (bytesRead < alignedSize)
+	{
+		const auto result = pread(fd_, alignedBuffer + bytesRead, alignedSize - bytesRead,
+			static_cast<off_t>(alignedBegin + bytesRead));
+
+		if (result < 0 && errno == EINTR)
+			continue;
+
+		if (result < 0)
+		{
+			lastError_ = errno;
+			return false;
+		}
+
+		// end of file, the last block of a file may be shorter than the alignment
+		if (result == 0)
+			break;
+
+		bytesRead += result;
+	}
+
+	bytesRead_ += bytesRead;
+
+	if (alignedBegin + bytesRead < offset + bytes)
+		return false;
+
+	memcpy(buffer, alignedBuffer + (offset - alignedBegin), bytes);
+	return true;
+#else
+	(void)buffer;
+	(void)offset;
+	(void)bytes;
+	lastError_ = EINVAL;
+	return false;
+#endif
+}
+
+bool Burst::DirectFile::write(const char* buffer, const Poco::UInt64 offset, const Poco::UInt64 bytes)
+{
+#ifdef __linux__
+	if (!isOpen() ||
+		reinterpret_cast<uintptr_t>(buffer) % Alignment != 0 ||
+		offset % Alignment != 0 ||
+		bytes % Alignment != 0)
+		return false;
+
+	Poco::UInt64 bytesWritten = 0;
+
+	while (bytesWritten < bytes)
+	{
+		const auto result = pwrite(fd_, buffer + bytesWritten, bytes - bytesWritten,
+			static_cast<off_t>(offset + bytesWritten));
+
+		if (result < 0 && errno == EINTR)
+			continue;
+
+		if (result <= 0)
+			return false;
+
+		bytesWritten += result;
+	}
+
+	return true;
+#else
+	(void)buffer;
+	(void)offset;
+	(void)bytes;
+	return false;
+#endif
+}
+
+Poco::UInt64 Burst::DirectFile::getBytesRead() const
+{
+	return bytesRead_;
+}
+
+int Burst::DirectFile::getLastError() const
+{
+	return lastError_;
+}
+
+char* Burst::DirectFile::getAlignedBuffer(const Poco::UInt64 size)
+{
+	if (buffer_.size() < size + Alignment)
+		buffer_.resize(size + Alignment);
+
+	void* alignedBuffer = buffer_.data();
+	auto space = buffer_.size();
+
+	return static_cast<char*>(std::align(Alignment, size, alignedBuffer, space));
+}
@@ -0,0 +1,108 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	/**
+	 * \brief A file, that bypasses the page cache of the operating system (O_DIRECT).
+	 * Direct reads need to be aligned in offset, length and memory, so every read
+	 * is widened to the alignment, read into an internal aligned buffer and then
+	 * copied into the target buffer.
+	 * Direct writes are not widened, the caller has to align them.
+	 * On other platforms than Linux the file can never be opened.
+	 */
+	class DirectFile
+	{
+	public:
+		/**
+		 * \brief The alignment of offsets, lengths and memory of the direct reads.
+		 * 4096 bytes are a multiple of the logical block size of all common devices.
+		 */
+		static constexpr Poco::UInt64 Alignment = 4096;
+
+		/**
+		 * \brief Constructor.
+		 * Opens the file for direct reading (and writing).
+		 * \param path The path of the file.
+		 * \param writable If true, the file is opened for writing too.
+		 */
+		explicit DirectFile(const std::string& path, bool writable = false);
+		~DirectFile();
+
+		DirectFile(const DirectFile& rhs) = delete;
+		DirectFile& operator=(const DirectFile& rhs) = delete;
+
+		/**
+		 * \brief Checks, if the file could be opened with direct access.
+		 * Some filesystems (e.g. tmpfs or network filesystems) refuse it.
+		 * \return true, if the file is open, false otherwise.
+		 */
+		bool isOpen() const;
+
+		/**
+		 * \brief Reads a part of the file.
+		 * \param buffer The target buffer, it does not need to be aligned.
+		 * \param offset The offset inside the file.
+		 * \param bytes The number of bytes to read.
+		 * \return true, if all bytes were read, false otherwise.
+		 * When false is returned, getLastError() tells, if the caller should fall back to buffered reading.
+		 */
+		bool read(char* buffer, Poco::UInt64 offset, Poco::UInt64 bytes);
+
+		/**
+		 * \brief Writes a part of the file.
+		 * \param buffer The source buffer, it needs to be aligned.
+		 * \param offset The offset inside the file, it needs to be aligned.
+		 * \param bytes The number of bytes to write, it needs to be aligned.
+		 * \return true, if all bytes were written, false otherwise.
+		 * When false is returned (e.g. because of a missing alignment), the caller should fall back to buffered writing.
+		 */
+		bool write(const char* buffer, Poco::UInt64 offset, Poco::UInt64 bytes);
+
+		/**
+		 * \brief Returns the number of bytes, that were read from the device.
+		 * Because of the widening this is more than the requested amount.
+		 * \return The number of bytes read from the device.
+		 */
+		Poco::UInt64 getBytesRead() const;
+
+		/**
+		 * \brief Returns the error of the last failed read.
+		 * EINVAL means, that the filesystem refuses direct reads and buffered reading should be used.
+		 * \return The errno of the last failed read or 0, if it ended early (e.g. at the end of the file).
+		 */
+		int getLastError() const;
+
+	private:
+		char* getAlignedBuffer(Poco::UInt64 size);
+
+		int fd_;
+		std::vector<char> buffer_;
+		Poco::UInt64 bytesRead_;
+		int lastError_;
+	};
+}
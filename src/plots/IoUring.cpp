@@ -0,0 +1,335 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "IoUring.hpp"
+
+#if defined __linux__ && defined __has_include
+#if __has_include(<linux/io_uring.h>)
+#define CREEPMINER_HAS_IO_URING
+#endif
+#endif
+
+#ifdef CREEPMINER_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+struct Burst::IoUring::Ring
+{
+	int fd = -1;
+
+	// submission queue
+	void* sqMemory = MAP_FAILED;
+	size_t sqMemorySize = 0;
+	unsigned* sqHead = nullptr;
+	unsigned* sqTail = nullptr;
+	unsigned* sqMask = nullptr;
+	unsigned* sqArray = nullptr;
+	void* sqesMemory = MAP_FAILED;
+	io_uring_sqe* sqes = nullptr;
+	size_t sqesSize = 0;
+
+	// completion queue
+	void* cqMemory = MAP_FAILED;
+	size_t cqMemorySize = 0;
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned* cqMask = nullptr;
+	io_uring_cqe* cqes = nullptr;
+
+	// one iovec per submission slot, readv only needs them until the submission
+	std::vector<iovec> iovecs;
+
+	~Ring()
+	{
+		if (sqesMemory != MAP_FAILED)
+			munmap(sqesMemory, sqesSize);
+
+		if (cqMemory != MAP_FAILED && cqMemory != sqMemory)
+			munmap(cqMemory, cqMemorySize);
+
+		if (sqMemory != MAP_FAILED)
+			munmap(sqMemory, sqMemorySize);
+
+		if (fd >= 0)
+			close(fd);
+	}
+};
+
+namespace
+{
+	int sysIoUringSetup(unsigned entries, io_uring_params* params)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+	}
+
+	int sysIoUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+	}
+}
+
+Burst::IoUring::IoUring(unsigned queueDepth)
+	: ring_{nullptr}, queueDepth_{0}, pending_{0}, queued_{0}
+{
+	if (queueDepth == 0)
+		return;
+
+	io_uring_params params;
+	memset(&params, 0, sizeof params);
+
+	const auto fd = sysIoUringSetup(queueDepth, &params);
+
+	if (fd < 0)
+		return;
+
+	auto ring = new Ring;
+	ring->fd = fd;
+
+	ring->sqMemorySize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cqMemorySize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+	// since linux 5.4 both rings share one mapping
+	const auto singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+	if (singleMmap)
+	{
+		if (ring->cqMemorySize > ring->sqMemorySize)
+			ring->sqMemorySize = ring->cqMemorySize;
+
+		ring->cqMemorySize = 0;
+	}
+
+	ring->sqMemory = mmap(nullptr, ring->sqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		fd, IORING_OFF_SQ_RING);
+
+	if (ring->sqMemory == MAP_FAILED)
+	{
+		delete ring;
+		return;
+	}
+
+	if (singleMmap)
+		ring->cqMemory = ring->sqMemory;
+	else
+	{
+		ring->cqMemory = mmap(nullptr, ring->cqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			fd, IORING_OFF_CQ_RING);
+
+		if (ring->cqMemory == MAP_FAILED)
+		{
+			delete ring;
+			return;
+		}
+	}
+
+	ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+	ring->sqesMemory = mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		fd, IORING_OFF_SQES);
+
+	if (ring->sqesMemory == MAP_FAILED)
+	{
+		delete ring;
+		return;
+	}
+
+	ring->sqes = static_cast<io_uring_sqe*>(ring->sqesMemory);
+
+	const auto sq = static_cast<char*>(ring->sqMemory);
+	ring->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	ring->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	ring->sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+	ring->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+	const auto cq = static_cast<char*>(ring->cqMemory);
+	ring->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	ring->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	ring->cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+	ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+	ring->iovecs.resize(params.sq_entries);
+
+	ring_ = ring;
+	queueDepth_ = params.sq_entries;
+}
+
+Burst::IoUring::~IoUring()
+{
+	if (ring_ != nullptr)
+		delete ring_;
+}
+
+bool Burst::IoUring::isAvailable() const
+{
+	return ring_ != nullptr;
+}
+
+bool Burst::IoUring::read(int fd, void* buffer, size_t length, Poco::UInt64 offset, void* userData)
+{
+	if (ring_ == nullptr || pending_ >= queueDepth_)
+		return false;
+
+	const auto tail = *ring_->sqTail;
+	const auto head = __atomic_load_n(ring_->sqHead, __ATOMIC_ACQUIRE);
+
+	// submission queue is full
+	if (tail - head >= queueDepth_)
+		return false;
+
+	const auto index = tail & *ring_->sqMask;
+	auto& sqe = ring_->sqes[index];
+	auto& iov = ring_->iovecs[index];
+
+	iov.iov_base = buffer;
+	iov.iov_len = length;
+
+	// readv is available since the very first io_uring kernel (5.1)
+	memset(&sqe, 0, sizeof sqe);
+	sqe.opcode = IORING_OP_READV;
+	sqe.fd = fd;
+	sqe.off = offset;
+	sqe.addr = reinterpret_cast<Poco::UInt64>(&iov);
+	sqe.len = 1;
+	sqe.user_data = reinterpret_cast<Poco::UInt64>(userData);
+
+	ring_->sqArray[index] = index;
+	__atomic_store_n(ring_->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+	++pending_;
+	++queued_;
+	return true;
+}
+
+unsigned Burst::IoUring::submit()
+{
+	if (ring_ == nullptr || queued_ == 0)
+		return 0;
+
+	const auto submitted = sysIoUringEnter(ring_->fd, queued_, 0, 0);
+
+	if (submitted < 0)
+		return 0;
+
+	queued_ -= static_cast<unsigned>(submitted);
+	return static_cast<unsigned>(submitted);
+}
+
+bool Burst::IoUring::wait(Completion& completion, bool block)
+{
+	if (ring_ == nullptr || pending_ == 0)
+		return false;
+
+	while (true)
+	{
+		const auto head = *ring_->cqHead;
+		const auto tail = __atomic_load_n(ring_->cqTail, __ATOMIC_ACQUIRE);
+
+		if (head != tail)
+		{
+			const auto& cqe = ring_->cqes[head & *ring_->cqMask];
+			completion.userData = reinterpret_cast<void*>(cqe.user_data);
+			completion.result = cqe.res;
+			__atomic_store_n(ring_->cqHead, head + 1, __ATOMIC_RELEASE);
+			--pending_;
+			return true;
+		}
+
+		if (!block)
+			return false;
+
+		// hand over everything that is still queued and wait for at least one completion
+		const auto result = sysIoUringEnter(ring_->fd, queued_, 1, IORING_ENTER_GETEVENTS);
+
+		if (result < 0 && errno != EINTR)
+			return false;
+
+		if (result > 0)
+			queued_ -= static_cast<unsigned>(result);
+	}
+}
+
+unsigned Burst::IoUring::getPending() const
+{
+	return pending_;
+}
+
+unsigned Burst::IoUring::getQueueDepth() const
+{
+	return queueDepth_;
+}
+
+bool Burst::IoUring::isSupported()
+{
+	return IoUring{1}.isAvailable();
+}
+
+#else
+struct Burst::IoUring::Ring
+{
+};
+
+Burst::IoUring::IoUring(unsigned)
+	: ring_{nullptr}, queueDepth_{0}, pending_{0}, queued_{0}
+{
+}
+
+Burst::IoUring::~IoUring() = default;
+
+bool Burst::IoUring::isAvailable() const
+{
+	return false;
+}
+
+bool Burst::IoUring::read(int, void*, size_t, Poco::UInt64, void*)
+{
+	return false;
+}
+
+unsigned Burst::IoUring::submit()
+{
+	return 0;
+}
+
+bool Burst::IoUring::wait(Completion&, bool)
+{
+	return false;
+}
+
+unsigned Burst::IoUring::getPending() const
+{
+	return pending_;
+}
+
+unsigned Burst::IoUring::getQueueDepth() const
+{
+	return queueDepth_;
+}
+
+bool Burst::IoUring::isSupported()
+{
+	return false;
+}
+#endif
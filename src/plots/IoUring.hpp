@@ -0,0 +1,120 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <cstddef>
+
+namespace Burst
+{
+	/**
+	 * \brief A minimal wrapper around a Linux io_uring instance.
+	 * Reads are queued with \see read, handed to the kernel with \see submit
+	 * and collected with \see wait. On other platforms (or kernels without
+	 * io_uring support) the ring is never available.
+	 */
+	class IoUring
+	{
+	public:
+		/**
+		 * \brief A finished read request.
+		 */
+		struct Completion
+		{
+			/**
+			 * \brief The user data, that was given to \see read.
+			 */
+			void* userData = nullptr;
+
+			/**
+			 * \brief The number of read bytes or a negative errno value.
+			 */
+			Poco::Int64 result = 0;
+		};
+
+		/**
+		 * \brief Constructor.
+		 * Creates the ring with a specific queue depth.
+		 * \param queueDepth The max. number of requests in flight.
+		 */
+		explicit IoUring(unsigned queueDepth);
+		~IoUring();
+
+		IoUring(const IoUring& rhs) = delete;
+		IoUring& operator=(const IoUring& rhs) = delete;
+
+		/**
+		 * \brief Checks, if the ring could be created.
+		 * \return true, if the ring is usable, false otherwise.
+		 */
+		bool isAvailable() const;
+
+		/**
+		 * \brief Queues a read request. It is not handed to the kernel until \see submit is called.
+		 * \param fd The file descriptor to read from.
+		 * \param buffer The target buffer.
+		 * \param length The number of bytes to read.
+		 * \param offset The offset inside the file.
+		 * \param userData Data that is returned with the completion.
+		 * \return true, if the request was queued, false if the queue is full.
+		 */
+		bool read(int fd, void* buffer, size_t length, Poco::UInt64 offset, void* userData);
+
+		/**
+		 * \brief Hands all queued requests to the kernel.
+		 * \return The number of submitted requests.
+		 */
+		unsigned submit();
+
+		/**
+		 * \brief Collects one finished request.
+		 * \param completion The finished request.
+		 * \param block If true, the call waits until a request is finished.
+		 * \return true, if a request was collected, false otherwise.
+		 */
+		bool wait(Completion& completion, bool block);
+
+		/**
+		 * \brief Returns the number of requests, that are queued or in flight.
+		 * \return The number of unfinished requests.
+		 */
+		unsigned getPending() const;
+
+		/**
+		 * \brief Returns the queue depth of the ring.
+		 * \return The max. number of requests in flight.
+		 */
+		unsigned getQueueDepth() const;
+
+		/**
+		 * \brief Checks, if the running system supports io_uring.
+		 * \return true, if a ring can be created, false otherwise.
+		 */
+		static bool isSupported();
+
+	private:
+		struct Ring;
+		Ring* ring_;
+		unsigned queueDepth_;
+		unsigned pending_, queued_;
+	};
+}
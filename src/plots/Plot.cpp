@@ -20,6 +20,7 @@
 // ==========================================================================
 
 #include "Plot.hpp"
+#include "PlotChecksums.hpp"
 #include <Poco/SHA1Engine.h>
 #include <Poco/DigestStream.h>
 #include "mining/Miner.hpp"
@@ -28,6 +29,15 @@
 #include "logging/Message.hpp"
 #include "logging/MinerLogger.hpp"
 #include "MinerUtil.hpp"
+#include <algorithm>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
 
 Burst::PlotFile::PlotFile(std::string&& path, Poco::UInt64 size)
 	: path_(move(path)), size_(size)
@@ -36,6 +46,9 @@ Burst::PlotFile::PlotFile(std::string&& path, Poco::UInt64 size)
 	nonceStart_ = stoull(getStartNonceFromPlotFile(path_));
 	nonces_ = stoull(getNonceCountFromPlotFile(path_));
 	staggerSize_ = stoull(getStaggerSizeFromPlotFile(path_));
+	poc2_ = isPoc2PlotFile(path_);
+	readExtents();
+	checksums_ = PlotChecksums::load(*this);
 }
 
 const std::string& Burst::PlotFile::getPath() const
@@ -83,6 +96,99 @@ Poco::UInt64 Burst::PlotFile::getStaggerScoopBytes() const
 	return getStaggerSize() * Settings::ScoopSize;
 }
 
+bool Burst::PlotFile::isPoc2() const
+{
+	return poc2_;
+}
+
+const std::vector<Burst::PlotFile::Extent>& Burst::PlotFile::getExtents() const
+{
+	return extents_;
+}
+
+Poco::UInt64 Burst::PlotFile::getPhysicalOffset(const Poco::UInt64 offset) const
+{
+	// the last extent, that starts before the offset
+	auto iter = std::upper_bound(extents_.begin(), extents_.end(), offset, [](const Poco::UInt64 value, const Extent& extent)
+	{
+		return value < extent.logical;
+	});
+
+	if (iter == extents_.begin())
+		return offset;
+
+	--iter;
+	return iter->physical + (offset - iter->logical);
+}
+
+const std::shared_ptr<Burst::PlotChecksums>& Burst::PlotFile::getChecksums() const
+{
+	return checksums_;
+}
+
+void Burst::PlotFile::readExtents()
+{
+	extents_.clear();
+
+#ifdef __linux__
+	const auto fd = open(path_.c_str(), O_RDONLY);
+
+	if (fd < 0)
+		return;
+
+	const auto maxExtents = 256u;
+	std::vector<char> buffer(sizeof(fiemap) + maxExtents * sizeof(fiemap_extent));
+	auto map = reinterpret_cast<fiemap*>(buffer.data());
+	Poco::UInt64 start = 0;
+	auto last = false;
+
+	while (!last)
+	{
+		std::fill(buffer.begin(), buffer.end(), 0);
+		map->fm_start = start;
+		map->fm_length = FIEMAP_MAX_OFFSET;
+		map->fm_extent_count = maxExtents;
+
+		// an incomplete map is useless
+		if (ioctl(fd, FS_IOC_FIEMAP, map) != 0)
+		{
+			extents_.clear();
+			break;
+		}
+
+		if (map->fm_mapped_extents == 0)
+			break;
+
+		for (auto i = 0u; i < map->fm_mapped_extents; ++i)
+		{
+			const auto& extent = map->fm_extents[i];
+
+			// the data is not (yet) on the device or not at a known address
+			if (extent.fe_flags & (FIEMAP_EXTENT_UNKNOWN | FIEMAP_EXTENT_DELALLOC | FIEMAP_EXTENT_ENCODED |
+				FIEMAP_EXTENT_DATA_INLINE | FIEMAP_EXTENT_NOT_ALIGNED))
+			{
+				extents_.clear();
+				close(fd);
+				return;
+			}
+
+			// the filesystem splits big extents, only real gaps are fragments
+			if (!extents_.empty() &&
+				extents_.back().logical + extents_.back().length == extent.fe_logical &&
+				extents_.back().physical + extents_.back().length == extent.fe_physical)
+				extents_.back().length += extent.fe_length;
+			else
+				extents_.push_back({extent.fe_logical, extent.fe_physical, extent.fe_length});
+
+			start = extent.fe_logical + extent.fe_length;
+			last = (extent.fe_flags & FIEMAP_EXTENT_LAST) != 0;
+		}
+	}
+
+	close(fd);
+#endif
+}
+
 Burst::PlotDir::PlotDir(std::string plotPath, Type type)
 	: path_{std::move(plotPath)},
 	  type_{type},
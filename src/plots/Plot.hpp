@@ -23,6 +23,7 @@
 
 #include <Poco/Types.h>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Poco {
@@ -31,6 +32,8 @@ namespace Poco {
 
 namespace Burst
 {
+	class PlotChecksums;
+
 	/**
 	 * \brief Represents a plotfile.
 	 * This class is not an actual representation of the physical file,
@@ -39,8 +42,17 @@ namespace Burst
 	class PlotFile
 	{
 	public:
+		/**
+		 * \brief A physically contiguous part of the plotfile on the device.
+		 */
+		struct Extent
+		{
+			Poco::UInt64 logical, physical, length;
+		};
+
 		/**
 		 * \brief Constructor.
+		 * The extent map (only on linux) and the checksum index of the plotfile are read at creation.
 		 * \param path The path to the plotfile.
 		 * \param size The size of the plotfile in Bytes.
 		 */
@@ -100,10 +112,42 @@ namespace Burst
 		 */
 		Poco::UInt64 getStaggerScoopBytes() const;
 
+		/**
+		 * \brief Returns the format of the plotfile.
+		 * In the PoC2 format the second hash of every scoop is swapped with the one of the
+		 * mirrored scoop (4095 - scoop).
+		 * \return true, if the plotfile has the PoC2 format, false for PoC1.
+		 */
+		bool isPoc2() const;
+
+		/**
+		 * \brief Returns the physically contiguous parts of the plotfile, ordered by their logical offset.
+		 * \return The extents (empty, if the extent map could not be read).
+		 */
+		const std::vector<Extent>& getExtents() const;
+
+		/**
+		 * \brief Returns the address on the device of a byte inside the plotfile.
+		 * \param offset The logical offset inside the plotfile.
+		 * \return The physical address (or the logical offset, if the extent map is unknown).
+		 */
+		Poco::UInt64 getPhysicalOffset(Poco::UInt64 offset) const;
+
+		/**
+		 * \brief Returns the checksum index of the plotfile.
+		 * \return The index or a nullptr, if the plotfile has none.
+		 */
+		const std::shared_ptr<PlotChecksums>& getChecksums() const;
+
 	private:
+		void readExtents();
+
 		std::string path_;
 		Poco::UInt64 size_;
 		Poco::UInt64 accountId_, nonceStart_, nonces_, staggerSize_;
+		bool poc2_;
+		std::vector<Extent> extents_;
+		std::shared_ptr<PlotChecksums> checksums_;
 	};
 
 	/**
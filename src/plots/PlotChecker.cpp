@@ -0,0 +1,303 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotChecker.hpp"
+#include "Plot.hpp"
+#include "PlotDevice.hpp"
+#include "PlotGenerator.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/Miner.hpp"
+#include "mining/MinerConfig.hpp"
+#include "webserver/MinerServer.hpp"
+#include <Poco/JSON/Object.h>
+#include <Poco/Path.h>
+#include <Poco/Thread.h>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+constexpr size_t Burst::PlotChecker::CheckGroups;
+constexpr size_t Burst::PlotChecker::CheckScoops;
+
+Burst::PlotChecker::PlotChecker(Miner& miner, MinerServer& server)
+	: miner_(miner),
+	  server_(server),
+	  filesChecked_(0),
+	  files_(0),
+	  bytesChecked_(0),
+	  weightedIntegrity_(0)
+{}
+
+double Burst::PlotChecker::check(const std::vector<std::shared_ptr<PlotFile>>& plotFiles)
+{
+	filesChecked_ = 0;
+	files_ = plotFiles.size();
+	bytesChecked_ = 0;
+	weightedIntegrity_ = 0;
+
+	std::vector<std::unique_ptr<FileCheck>> fileChecks;
+	std::unordered_map<const PlotFile*, FileCheck*> fileCheckByPlotFile;
+	std::vector<PlotDevice> devices;
+	// the nonce groups of all plot files, that are generated
+	std::vector<std::pair<FileCheck*, size_t>> generateJobs;
+
+	for (const auto& plotFile : plotFiles)
+	{
+		fileChecks.emplace_back(new FileCheck);
+
+		auto& fileCheck = *fileChecks.back();
+		fileCheck.plotFile = plotFile;
+		prepare(fileCheck);
+
+		for (size_t group = 0; group < fileCheck.groups.size(); ++group)
+			generateJobs.emplace_back(&fileCheck, group);
+
+		fileCheckByPlotFile[plotFile.get()] = &fileCheck;
+		PlotDevice::addPlotFile(devices, plotFile, Poco::Path{plotFile->getPath()}.parent().toString());
+	}
+
+	log_system(MinerLogger::general, "Validating the integrity of %s plot files on %s devices...",
+		std::to_string(files_), std::to_string(devices.size()));
+
+	const auto nonRotationalReaders = MinerConfig::getConfig().getNonRotationalReaders();
+	std::vector<std::atomic<size_t>> nextFiles(devices.size());
+	std::atomic<size_t> nextGenerateJob{0};
+	std::vector<std::thread> threads;
+
+	// every device is read by as many readers as it has heads
+	for (size_t i = 0; i < devices.size(); ++i)
+	{
+		nextFiles[i] = 0;
+
+		const auto readers = std::min<size_t>(devices[i].getMaxReaders(nonRotationalReaders), devices[i].plotFiles.size());
+
+		for (size_t reader = 0; reader < readers; ++reader)
+			threads.emplace_back([&, i]()
+			{
+				const auto& device = devices[i];
+				auto& nextFile = nextFiles[i];
+
+				for (auto file = nextFile++; file < device.plotFiles.size(); file = nextFile++)
+				{
+					auto& fileCheck = *fileCheckByPlotFile[device.plotFiles[file].get()];
+					read(fileCheck);
+
+					if (--fileCheck.pending == 0)
+						finish(fileCheck);
+				}
+			});
+	}
+
+	// the nonces are generated on all cores
+	const auto generators = std::max(std::thread::hardware_concurrency(), 1u);
+
+	for (auto generator = 0u; generator < generators; ++generator)
+		threads.emplace_back([&]()
+		{
+			for (auto job = nextGenerateJob++; job < generateJobs.size(); job = nextGenerateJob++)
+			{
+				auto& fileCheck = *generateJobs[job].first;
+				generate(fileCheck, generateJobs[job].second);
+
+				if (--fileCheck.pending == 0)
+					finish(fileCheck);
+			}
+		});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	if (bytesChecked_ == 0)
+		return 0;
+
+	return weightedIntegrity_ / bytesChecked_;
+}
+
+void Burst::PlotChecker::prepare(FileCheck& fileCheck) const
+{
+	const auto& path = fileCheck.plotFile->getPath();
+
+	try
+	{
+		fileCheck.account = std::stoull(getAccountIdFromPlotFile(path));
+		fileCheck.startNonce = std::stoull(getStartNonceFromPlotFile(path));
+		fileCheck.nonces = std::stoull(getNonceCountFromPlotFile(path));
+		fileCheck.staggerSize = std::stoull(getStaggerSizeFromPlotFile(path));
+		fileCheck.poc2 = isPoc2PlotFile(path);
+	}
+	catch (...)
+	{
+		fileCheck.nonces = 0;
+	}
+
+	if (fileCheck.nonces == 0 || fileCheck.staggerSize == 0)
+	{
+		log_error(MinerLogger::general, "The plot file %s has an invalid name and can not be checked!", path);
+		fileCheck.readable = false;
+		fileCheck.pending = 1;
+		return;
+	}
+
+	std::random_device randomDevice;
+	std::mt19937 random{randomDevice()};
+
+	// every group lies at a random place in its part of the plot file
+	fileCheck.groupNonces = std::min<Poco::UInt64>(PlotGeneratorArena::getLanes(), fileCheck.nonces);
+	const auto groupInterval = std::max<Poco::UInt64>(fileCheck.nonces / CheckGroups, 1);
+
+	for (size_t group = 0; group < CheckGroups; ++group)
+	{
+		const auto nonce = group * groupInterval + random() % groupInterval;
+		fileCheck.groups.emplace_back(std::min(nonce, fileCheck.nonces - fileCheck.groupNonces));
+	}
+
+	const auto scoopInterval = Settings::ScoopPerPlot / CheckScoops;
+
+	for (size_t scoop = 0; scoop < CheckScoops; ++scoop)
+		fileCheck.scoops.emplace_back(scoop * scoopInterval + random() % scoopInterval);
+
+	const auto bytes = CheckGroups * CheckScoops * fileCheck.groupNonces * Settings::ScoopSize;
+	fileCheck.readData.resize(bytes);
+	fileCheck.generatedData.resize(bytes);
+	fileCheck.pending = fileCheck.groups.size() + 1;
+}
+
+void Burst::PlotChecker::read(FileCheck& fileCheck) const
+{
+	if (!fileCheck.readable)
+		return;
+
+	std::ifstream stream{fileCheck.plotFile->getPath(), std::ios::in | std::ios::binary};
+	const auto staggerScoopBytes = fileCheck.staggerSize * Settings::ScoopSize;
+
+	// scoop by scoop, so the reads in an optimized plot file go forward
+	for (size_t scoop = 0; stream && scoop < fileCheck.scoops.size(); ++scoop)
+	{
+		for (size_t group = 0; stream && group < fileCheck.groups.size(); ++group)
+		{
+			waitWhileProcessing();
+
+			const auto target = fileCheck.readData.data() + getOffset(fileCheck, group, scoop);
+
+			// the consecutive nonces of one stagger lie next to each other
+			for (Poco::UInt64 nonce = 0; nonce < fileCheck.groupNonces;)
+			{
+				const auto fileNonce = fileCheck.groups[group] + nonce;
+				const auto staggerOffset = fileNonce % fileCheck.staggerSize;
+				const auto nonces = std::min(fileCheck.staggerSize - staggerOffset, fileCheck.groupNonces - nonce);
+
+				stream.seekg(fileNonce / fileCheck.staggerSize * fileCheck.staggerSize * Settings::PlotSize +
+					fileCheck.scoops[scoop] * staggerScoopBytes + staggerOffset * Settings::ScoopSize);
+				stream.read(target + nonce * Settings::ScoopSize, nonces * Settings::ScoopSize);
+
+				nonce += nonces;
+			}
+		}
+	}
+
+	if (!stream)
+	{
+		log_error(MinerLogger::general, "Could not read from the plot file %s!", fileCheck.plotFile->getPath());
+		fileCheck.readable = false;
+	}
+}
+
+void Burst::PlotChecker::generate(FileCheck& fileCheck, const size_t group) const
+{
+	waitWhileProcessing();
+
+	auto& arena = PlotGeneratorArena::getThreadArena();
+	arena.generate(fileCheck.account, fileCheck.startNonce + fileCheck.groups[group], fileCheck.groupNonces);
+
+	for (size_t scoop = 0; scoop < fileCheck.scoops.size(); ++scoop)
+	{
+		const auto target = fileCheck.generatedData.data() + getOffset(fileCheck, group, scoop);
+
+		for (size_t nonce = 0; nonce < fileCheck.groupNonces; ++nonce)
+			arena.copyScoop(nonce, fileCheck.scoops[scoop], fileCheck.poc2, target + nonce * Settings::ScoopSize);
+	}
+}
+
+void Burst::PlotChecker::finish(FileCheck& fileCheck)
+{
+	const auto& plotPath = fileCheck.plotFile->getPath();
+	Poco::UInt64 scoopsIntact = 0;
+	Poco::UInt64 scoopsChecked = 0;
+
+	if (fileCheck.readable)
+		for (size_t offset = 0; offset < fileCheck.readData.size(); offset += Settings::ScoopSize)
+		{
+			if (memcmp(fileCheck.readData.data() + offset, fileCheck.generatedData.data() + offset, Settings::ScoopSize) == 0)
+				++scoopsIntact;
+
+			++scoopsChecked;
+		}
+
+	const auto integrity = scoopsChecked > 0 ? 100.0 * scoopsIntact / scoopsChecked : 0.0;
+
+	if (integrity < 100.0)
+		log_error(MinerLogger::general, "Total Integrity of %s: %0.3f%%", plotPath, integrity);
+	else
+		log_success(MinerLogger::general, "Total Integrity of %s: %0.3f%%", plotPath, integrity);
+
+	const auto plotId = getAccountIdFromPlotFile(plotPath) + "_" + getStartNonceFromPlotFile(plotPath) + "_" +
+		getNonceCountFromPlotFile(plotPath) + "_" + getStaggerSizeFromPlotFile(plotPath);
+
+	//response to websockets
+	Poco::JSON::Object json;
+	json.set("type", "plotcheck-result");
+	json.set("plotID", plotId);
+	json.set("plotIntegrity", std::to_string(integrity));
+
+	server_.sendToWebsockets(json);
+
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	++filesChecked_;
+	bytesChecked_ += fileCheck.plotFile->getSize();
+	weightedIntegrity_ += integrity * fileCheck.plotFile->getSize();
+
+	Poco::JSON::Object progress;
+	progress.set("type", "totalPlotcheck-progress");
+	progress.set("checked", filesChecked_);
+	progress.set("total", files_);
+
+	server_.sendToWebsockets(progress);
+
+	// the data is not needed anymore
+	std::vector<char>().swap(fileCheck.readData);
+	std::vector<char>().swap(fileCheck.generatedData);
+}
+
+void Burst::PlotChecker::waitWhileProcessing() const
+{
+	while (miner_.isProcessing())
+		Poco::Thread::sleep(100);
+}
+
+size_t Burst::PlotChecker::getOffset(const FileCheck& fileCheck, const size_t group, const size_t scoop) const
+{
+	return (group * fileCheck.scoops.size() + scoop) * fileCheck.groupNonces * Settings::ScoopSize;
+}
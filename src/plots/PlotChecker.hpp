@@ -0,0 +1,96 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	class Miner;
+	class MinerServer;
+	class PlotFile;
+
+	/**
+	 * \brief Checks the integrity of plot files by comparing random scoops with generated nonces.
+	 * Every physical device is read by its own readers, while the nonces are generated on all cores.
+	 * Every sample is a group of consecutive nonces (one per SIMD lane), so that a sampled scoop
+	 * is read with one seek and all lanes of the generator are used.
+	 * The check pauses while the miner processes a round and reports its progress over the websockets.
+	 */
+	class PlotChecker
+	{
+	public:
+		/**
+		 * \brief The number of nonce groups, that are checked per plot file.
+		 */
+		static constexpr size_t CheckGroups = 32;
+
+		/**
+		 * \brief The number of scoops, that are checked per nonce.
+		 */
+		static constexpr size_t CheckScoops = 32;
+
+		PlotChecker(Miner& miner, MinerServer& server);
+
+		/**
+		 * \brief Checks the integrity of plot files.
+		 * The result of every plot file is sent to the websockets when it is known.
+		 * \param plotFiles The plot files.
+		 * \return The integrity of all plot files in percent, weighted by their size.
+		 */
+		double check(const std::vector<std::shared_ptr<PlotFile>>& plotFiles);
+
+	private:
+		struct FileCheck
+		{
+			std::shared_ptr<PlotFile> plotFile;
+			Poco::UInt64 account = 0, startNonce = 0, nonces = 0, staggerSize = 0;
+			bool poc2 = false;
+			size_t groupNonces = 0;
+			std::vector<Poco::UInt64> groups, scoops;
+			// [group][scoop][nonce], the read and the generated scoops
+			std::vector<char> readData, generatedData;
+			bool readable = true;
+			// the generated groups and the read, that are not finished yet
+			std::atomic<size_t> pending{0};
+		};
+
+		void prepare(FileCheck& fileCheck) const;
+		void read(FileCheck& fileCheck) const;
+		void generate(FileCheck& fileCheck, size_t group) const;
+		void finish(FileCheck& fileCheck);
+		void waitWhileProcessing() const;
+		size_t getOffset(const FileCheck& fileCheck, size_t group, size_t scoop) const;
+
+		Miner& miner_;
+		MinerServer& server_;
+		std::mutex mutex_;
+		size_t filesChecked_, files_;
+		Poco::UInt64 bytesChecked_;
+		double weightedIntegrity_;
+	};
+}
@@ -0,0 +1,344 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotChecksums.hpp"
+#include "Plot.hpp"
+#include "PlotGenerator.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+	const char Magic[8] = {'C', 'R', 'E', 'E', 'P', 'C', 'R', 'C'};
+
+	std::array<Poco::UInt32, 256> createCrc32cTable()
+	{
+		std::array<Poco::UInt32, 256> table{};
+
+		// reflected Castagnoli polynomial
+		for (Poco::UInt32 i = 0; i < table.size(); ++i)
+		{
+			auto crc = i;
+
+			for (auto bit = 0; bit < 8; ++bit)
+				crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+
+			table[i] = crc;
+		}
+
+		return table;
+	}
+}
+
+constexpr Poco::UInt64 Burst::PlotChecksums::BlockNonces;
+
+Burst::PlotChecksums::PlotChecksums(Poco::SharedMemory memory, const Poco::UInt64 staggerSize, const Poco::UInt64 staggers)
+	: memory_(std::move(memory)),
+	  checksums_(reinterpret_cast<const Poco::UInt32*>(memory_.begin() + sizeof(Header))),
+	  staggerSize_(staggerSize),
+	  staggers_(staggers),
+	  blockNonces_(getBlockNonces(staggerSize)),
+	  blocksPerStagger_(getBlocksPerStagger(staggerSize))
+{}
+
+std::shared_ptr<Burst::PlotChecksums> Burst::PlotChecksums::load(const PlotFile& plotFile)
+{
+	const auto path = getPath(plotFile.getPath());
+
+	try
+	{
+		Poco::File file{path};
+
+		if (!file.exists() || !file.isFile())
+			return nullptr;
+
+		const auto checksums = plotFile.getStaggerCount() * Settings::ScoopPerPlot *
+			getBlocksPerStagger(plotFile.getStaggerSize());
+
+		Header header{};
+
+		if (file.getSize() == sizeof(Header) + checksums * sizeof(Poco::UInt32))
+		{
+			std::ifstream stream{path, std::ios::in | std::ios::binary};
+			stream.read(reinterpret_cast<char*>(&header), sizeof header);
+		}
+
+		// the plot file was replaced or the index is not complete
+		if (memcmp(header.magic, Magic, sizeof Magic) != 0 ||
+			header.nonces != plotFile.getNonces() ||
+			header.staggerSize != plotFile.getStaggerSize() ||
+			header.blockNonces != getBlockNonces(plotFile.getStaggerSize()) ||
+			(header.poc2 != 0) != plotFile.isPoc2())
+		{
+			log_warning(MinerLogger::plotReader, "The checksum index %s does not belong to the plot file %s, it is ignored",
+				path, plotFile.getPath());
+			return nullptr;
+		}
+
+		Poco::SharedMemory memory{file, Poco::SharedMemory::AM_READ};
+		return std::shared_ptr<PlotChecksums>(new PlotChecksums(memory, plotFile.getStaggerSize(),
+			plotFile.getStaggerCount()));
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_warning(MinerLogger::plotReader, "Could not load the checksum index %s: %s", path, exc.displayText());
+		return nullptr;
+	}
+}
+
+bool Burst::PlotChecksums::build(const PlotFile& plotFile, const Poco::UInt64 memoryBytes,
+	const std::function<bool()>& cancel)
+{
+	const auto path = getPath(plotFile.getPath());
+	const auto tempPath = path + ".tmp";
+	const auto staggerSize = plotFile.getStaggerSize();
+	const auto blockNonces = getBlockNonces(staggerSize);
+	const auto blocksPerStagger = getBlocksPerStagger(staggerSize);
+	const auto poc2 = plotFile.isPoc2();
+
+	// a batch is a multiple of a block, so that no block is split between two batches
+	const auto batchNonces = std::min(std::max<Poco::UInt64>(memoryBytes / Settings::PlotSize / blockNonces, 1) *
+		blockNonces, staggerSize);
+
+	std::ifstream input{plotFile.getPath(), std::ios::in | std::ios::binary};
+
+	if (!input)
+	{
+		log_error(MinerLogger::general, "Could not open the plot file %s!", plotFile.getPath());
+		return false;
+	}
+
+	Poco::File{Poco::Path{path}.parent()}.createDirectories();
+	std::ofstream output{tempPath, std::ios::out | std::ios::binary | std::ios::trunc};
+
+	const auto abort = [&]()
+	{
+		output.close();
+		Poco::File{tempPath}.remove();
+		return false;
+	};
+
+	if (!output)
+	{
+		log_error(MinerLogger::general, "Could not create the checksum index %s!", tempPath);
+		return false;
+	}
+
+	Header header{};
+	memcpy(header.magic, Magic, sizeof Magic);
+	header.nonces = plotFile.getNonces();
+	header.staggerSize = staggerSize;
+	header.blockNonces = static_cast<Poco::UInt32>(blockNonces);
+	header.poc2 = poc2 ? 1 : 0;
+	output.write(reinterpret_cast<const char*>(&header), sizeof header);
+
+	// the generated scoops are stored like in the plot file ([scoop][nonce])
+	std::vector<char> generated(batchNonces * Settings::PlotSize);
+	std::vector<char> read(batchNonces * Settings::ScoopSize);
+	std::vector<Poco::UInt32> checksums(Settings::ScoopPerPlot * blocksPerStagger);
+
+	const auto lanes = static_cast<Poco::UInt64>(PlotGeneratorArena::getLanes());
+	const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+	const auto staggers = plotFile.getStaggerCount();
+	auto lastPercent = 0ull;
+
+	log_information(MinerLogger::general, "Creating the checksum index of %s (%s nonces)", plotFile.getPath(),
+		numberToString(plotFile.getNonces()));
+
+	for (auto stagger = 0ull; stagger < staggers; ++stagger)
+	{
+		for (Poco::UInt64 batch = 0; batch < staggerSize; batch += batchNonces)
+		{
+			if (cancel())
+				return abort();
+
+			const auto nonces = std::min(batchNonces, staggerSize - batch);
+			const auto firstNonce = plotFile.getNonceStart() + stagger * staggerSize + batch;
+			std::atomic<Poco::UInt64> nextGroup{0};
+
+			// every thread generates groups of nonces, one nonce per lane
+			const auto generate = [&]()
+			{
+				auto& arena = PlotGeneratorArena::getThreadArena();
+
+				for (auto group = nextGroup.fetch_add(lanes); group < nonces; group = nextGroup.fetch_add(lanes))
+				{
+					const auto groupNonces = std::min(lanes, nonces - group);
+					arena.generate(plotFile.getAccountId(), firstNonce + group, groupNonces);
+
+					for (auto nonce = 0ull; nonce < groupNonces; ++nonce)
+						for (auto scoop = 0ull; scoop < Settings::ScoopPerPlot; ++scoop)
+							arena.copyScoop(nonce, scoop, poc2,
+								generated.data() + (scoop * nonces + group + nonce) * Settings::ScoopSize);
+				}
+			};
+
+			std::vector<std::thread> workers;
+
+			for (auto i = 1u; i < threads; ++i)
+				workers.emplace_back(generate);
+
+			generate();
+
+			for (auto& worker : workers)
+				worker.join();
+
+			for (auto scoop = 0ull; scoop < Settings::ScoopPerPlot; ++scoop)
+			{
+				const auto bytes = nonces * Settings::ScoopSize;
+				const auto expected = generated.data() + scoop * bytes;
+
+				input.seekg(stagger * plotFile.getStaggerBytes() + scoop * plotFile.getStaggerScoopBytes() +
+					batch * Settings::ScoopSize);
+				input.read(read.data(), bytes);
+
+				if (!input)
+				{
+					log_error(MinerLogger::general, "Could not read from plot file %s!", plotFile.getPath());
+					return abort();
+				}
+
+				if (memcmp(read.data(), expected, bytes) != 0)
+				{
+					auto nonce = 0ull;
+
+					while (memcmp(read.data() + nonce * Settings::ScoopSize, expected + nonce * Settings::ScoopSize,
+						Settings::ScoopSize) == 0)
+						++nonce;
+
+					log_error(MinerLogger::general, "The plot file %s is corrupted at nonce %s (scoop %s), "
+						"no checksum index is created", plotFile.getPath(),
+						std::to_string(firstNonce + nonce), std::to_string(scoop));
+					return abort();
+				}
+
+				for (Poco::UInt64 block = 0; block < nonces; block += blockNonces)
+					checksums[scoop * blocksPerStagger + (batch + block) / blockNonces] =
+						crc32c(0, read.data() + block * Settings::ScoopSize,
+							std::min(blockNonces, nonces - block) * Settings::ScoopSize);
+			}
+
+			const auto percent = (stagger * staggerSize + batch + nonces) * 100 / plotFile.getNonces();
+
+			if (percent != lastPercent)
+			{
+				log_information(MinerLogger::general, "Checksum index of %s: %s%%", plotFile.getPath(),
+					std::to_string(percent));
+				lastPercent = percent;
+			}
+		}
+
+		output.write(reinterpret_cast<const char*>(checksums.data()), checksums.size() * sizeof(Poco::UInt32));
+	}
+
+	output.close();
+
+	if (!output)
+	{
+		log_error(MinerLogger::general, "Could not write the checksum index %s!", tempPath);
+		return abort();
+	}
+
+	Poco::File{tempPath}.renameTo(path);
+	log_information(MinerLogger::general, "Created the checksum index %s", path);
+	return true;
+}
+
+std::string Burst::PlotChecksums::getPath(const std::string& plotPath)
+{
+	// the plot dir is scanned for plot files, but not its subdirs
+	Poco::Path path{plotPath};
+	const auto fileName = path.getFileName();
+
+	path.setFileName("");
+	path.pushDirectory(".checksums");
+	path.setFileName(fileName + ".crc32c");
+
+	return path.toString();
+}
+
+bool Burst::PlotChecksums::verify(const Poco::UInt64 scoop, const Poco::UInt64 nonce, const Poco::UInt64 nonces,
+	const char* data) const
+{
+	const auto stagger = nonce / staggerSize_;
+
+	if (stagger >= staggers_)
+		return true;
+
+	const auto staggerNonce = nonce % staggerSize_;
+	const auto end = std::min(staggerNonce + nonces, staggerSize_);
+	const auto checksums = checksums_ + (stagger * Settings::ScoopPerPlot + scoop) * blocksPerStagger_;
+
+	// the first block, that starts inside of the range
+	for (auto block = (staggerNonce + blockNonces_ - 1) / blockNonces_; block < blocksPerStagger_; ++block)
+	{
+		const auto blockBegin = block * blockNonces_;
+		const auto blockEnd = std::min(blockBegin + blockNonces_, staggerSize_);
+
+		if (blockEnd > end)
+			break;
+
+		if (crc32c(0, data + (blockBegin - staggerNonce) * Settings::ScoopSize,
+			(blockEnd - blockBegin) * Settings::ScoopSize) != checksums[block])
+			return false;
+	}
+
+	return true;
+}
+
+Poco::UInt32 Burst::PlotChecksums::crc32c(const Poco::UInt32 crc, const char* data, const size_t bytes)
+{
+#ifdef USE_SSE4
+	// the crc32 instruction needs SSE4.2, SSE4.1 is not enough
+	static const auto hasSse42 = cpuHasSse42();
+
+	if (hasSse42)
+		return crc32cSse4(crc, data, bytes);
+#endif
+
+	static const auto table = createCrc32cTable();
+	auto value = ~crc;
+
+	for (size_t i = 0; i < bytes; ++i)
+		value = table[(value ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (value >> 8);
+
+	return ~value;
+}
+
+Poco::UInt64 Burst::PlotChecksums::getBlockNonces(const Poco::UInt64 staggerSize)
+{
+	return std::min(staggerSize, BlockNonces);
+}
+
+Poco::UInt64 Burst::PlotChecksums::getBlocksPerStagger(const Poco::UInt64 staggerSize)
+{
+	const auto blockNonces = getBlockNonces(staggerSize);
+	return blockNonces == 0 ? 0 : (staggerSize + blockNonces - 1) / blockNonces;
+}
@@ -0,0 +1,124 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/SharedMemory.h>
+#include <Poco/Types.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Burst
+{
+	class PlotFile;
+
+	/**
+	 * \brief The checksum index of a plot file.
+	 * It holds the CRC32C of every block of every (stagger, scoop) slice, as it is stored on the disk.
+	 * The plot reader checks the scoops it reads against it, so bit rot is found while mining
+	 * without generating a single nonce.
+	 *
+	 * The index is a sidecar file (<plot dir>/.checksums/<plot file>.crc32c), which is memory mapped.
+	 * It starts with a \struct Header, followed by one UInt32 per block, ordered like the
+	 * plot file (stagger, scoop, block).
+	 */
+	class PlotChecksums
+	{
+	public:
+		/**
+		 * \brief The max. number of nonces of a block (64 KiB of scoops).
+		 * Smaller staggers have one block per slice.
+		 */
+		static constexpr Poco::UInt64 BlockNonces = 1024;
+
+		/**
+		 * \brief The header of the index file.
+		 */
+		struct Header
+		{
+			char magic[8];
+			Poco::UInt64 nonces;
+			Poco::UInt64 staggerSize;
+			Poco::UInt32 blockNonces;
+			Poco::UInt32 poc2;
+		};
+
+		/**
+		 * \brief Maps the index of a plot file.
+		 * \param plotFile The plot file.
+		 * \return The index or a nullptr, if there is no valid index for the plot file.
+		 */
+		static std::shared_ptr<PlotChecksums> load(const PlotFile& plotFile);
+
+		/**
+		 * \brief Creates the index of a plot file.
+		 * Every nonce is generated and compared with the plot file, so only verified data is indexed.
+		 * \param plotFile The plot file.
+		 * \param memoryBytes The memory, that is used for the generated nonces.
+		 * \param cancel Returns true, if the creation needs to be stopped.
+		 * \return true, if the plot file is valid and the index was written.
+		 */
+		static bool build(const PlotFile& plotFile, Poco::UInt64 memoryBytes, const std::function<bool()>& cancel);
+
+		/**
+		 * \brief Returns the path of the index of a plot file.
+		 * \param plotPath The path of the plot file.
+		 * \return The path of the index.
+		 */
+		static std::string getPath(const std::string& plotPath);
+
+		/**
+		 * \brief Checks a read range of scoops.
+		 * Only blocks, that are completely inside of the range, can be checked.
+		 * \param scoop The number of the scoop.
+		 * \param nonce The first nonce of the range, relative to the start of the plot file.
+		 * The range must not cross the border of a stagger.
+		 * \param nonces The number of nonces.
+		 * \param data The scoops, as they are stored in the plot file.
+		 * \return false, if a checked block is corrupted.
+		 */
+		bool verify(Poco::UInt64 scoop, Poco::UInt64 nonce, Poco::UInt64 nonces, const char* data) const;
+
+		/**
+		 * \brief Calculates the CRC32C (Castagnoli) of a buffer.
+		 * The SSE4.2 instruction is used, if the cpu supports it.
+		 * \param crc The CRC of the previous data (0 at the start).
+		 * \param data The data.
+		 * \param bytes The size of the data in bytes.
+		 * \return The CRC.
+		 */
+		static Poco::UInt32 crc32c(Poco::UInt32 crc, const char* data, size_t bytes);
+
+	private:
+		PlotChecksums(Poco::SharedMemory memory, Poco::UInt64 staggerSize, Poco::UInt64 staggers);
+		static Poco::UInt64 getBlockNonces(Poco::UInt64 staggerSize);
+		static Poco::UInt64 getBlocksPerStagger(Poco::UInt64 staggerSize);
+
+		Poco::SharedMemory memory_;
+		const Poco::UInt32* checksums_;
+		Poco::UInt64 staggerSize_, staggers_, blockNonces_, blocksPerStagger_;
+	};
+
+#ifdef USE_SSE4
+	Poco::UInt32 crc32cSse4(Poco::UInt32 crc, const char* data, size_t bytes);
+#endif
+}
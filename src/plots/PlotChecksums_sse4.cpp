@@ -0,0 +1,57 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotChecksums.hpp"
+
+#ifdef USE_SSE4
+#include <nmmintrin.h>
+#include <cstring>
+
+Poco::UInt32 Burst::crc32cSse4(const Poco::UInt32 crc, const char* data, size_t bytes)
+{
+	auto value = ~crc;
+
+#if defined __x86_64__ || defined _M_X64
+	Poco::UInt64 value64 = value;
+
+	for (; bytes >= sizeof(Poco::UInt64); bytes -= sizeof(Poco::UInt64), data += sizeof(Poco::UInt64))
+	{
+		Poco::UInt64 word;
+		memcpy(&word, data, sizeof word);
+		value64 = _mm_crc32_u64(value64, word);
+	}
+
+	value = static_cast<Poco::UInt32>(value64);
+#endif
+
+	for (; bytes >= sizeof(Poco::UInt32); bytes -= sizeof(Poco::UInt32), data += sizeof(Poco::UInt32))
+	{
+		Poco::UInt32 word;
+		memcpy(&word, data, sizeof word);
+		value = _mm_crc32_u32(value, word);
+	}
+
+	for (; bytes > 0; --bytes, ++data)
+		value = _mm_crc32_u8(value, static_cast<unsigned char>(*data));
+
+	return ~value;
+}
+#endif
@@ -0,0 +1,151 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotDevice.hpp"
+#include "Plot.hpp"
+#include <algorithm>
+#include <fstream>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <climits>
+#include <cstdlib>
+#endif
+
+namespace
+{
+#ifdef __linux__
+	/**
+	 * \brief Fills the name, rotational flag and the number of disks of a device from /sys/dev/block.
+	 * Partitions are resolved to their disk, RAID and device mapper devices count their slaves.
+	 * \return true, if the device was found in /sys.
+	 */
+	bool readDeviceTopology(Burst::PlotDevice& device)
+	{
+		char resolved[PATH_MAX];
+
+		if (realpath(("/sys/dev/block/" + device.id).c_str(), resolved) == nullptr)
+			return false;
+
+		Poco::Path sysPath{std::string(resolved) + "/"};
+
+		// a partition has no queue, its disk is the parent
+		if (Poco::File{sysPath.toString() + "partition"}.exists())
+			sysPath.popDirectory();
+
+		const auto deviceName = sysPath[sysPath.depth() - 1];
+		device.name = "/dev/" + deviceName;
+
+		std::ifstream rotationalFile{sysPath.toString() + "queue/rotational"};
+		int rotational;
+
+		if (rotationalFile >> rotational)
+			device.rotational = rotational != 0;
+
+		// a RAID (md) or device mapper device (LVM, dm-crypt) lists its disks as slaves
+		const Poco::File slaves{sysPath.toString() + "slaves"};
+
+		if (slaves.exists() && slaves.isDirectory())
+		{
+			unsigned disks = 0;
+
+			for (Poco::DirectoryIterator iter{slaves}, end; iter != end; ++iter)
+				++disks;
+
+			device.disks = std::max(1u, disks);
+		}
+
+		return true;
+	}
+#endif
+
+	/**
+	 * \brief Returns the device of a plot file, if it is not known yet, it is created.
+	 */
+	Burst::PlotDevice& getDevice(std::vector<Burst::PlotDevice>& devices, const std::string& plotFile,
+		const std::string& plotDir)
+	{
+		std::string id;
+
+#ifdef __linux__
+		struct stat fileStat;
+
+		if (stat(plotFile.c_str(), &fileStat) == 0)
+			id = std::to_string(major(fileStat.st_dev)) + ":" + std::to_string(minor(fileStat.st_dev));
+#endif
+
+		// an unknown device is identified by the plot dir
+		if (id.empty())
+			id = plotDir;
+
+		const auto iter = std::find_if(devices.begin(), devices.end(), [&id](const Burst::PlotDevice& device)
+		{
+			return device.id == id;
+		});
+
+		if (iter != devices.end())
+			return *iter;
+
+		Burst::PlotDevice device;
+		device.id = id;
+		device.name = plotDir;
+
+#ifdef __linux__
+		// anonymous devices (btrfs, network filesystems) are not in /sys/dev/block,
+		// they are read by one reader per filesystem
+		if (id != plotDir)
+			readDeviceTopology(device);
+#endif
+
+		devices.emplace_back(std::move(device));
+		return devices.back();
+	}
+}
+
+unsigned Burst::PlotDevice::getMaxReaders(const unsigned nonRotationalReaders) const
+{
+	// every disk of a RAID has its own head
+	if (rotational)
+		return std::max(1u, disks);
+
+	return std::max(1u, nonRotationalReaders);
+}
+
+void Burst::PlotDevice::addPlotDir(std::vector<PlotDevice>& devices, const PlotDir& plotDir)
+{
+	for (const auto& plotFile : plotDir.getPlotfiles())
+		addPlotFile(devices, plotFile, plotDir.getPath());
+
+	for (const auto& relatedPlotDir : plotDir.getRelatedDirs())
+		addPlotDir(devices, *relatedPlotDir);
+}
+
+void Burst::PlotDevice::addPlotFile(std::vector<PlotDevice>& devices, const std::shared_ptr<PlotFile>& plotFile,
+	const std::string& plotDir)
+{
+	auto& device = getDevice(devices, plotFile->getPath(), plotDir);
+	device.plotFiles.emplace_back(plotFile);
+	device.plotFileDirs.emplace_back(plotDir);
+}
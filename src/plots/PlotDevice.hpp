@@ -0,0 +1,97 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	class PlotFile;
+	class PlotDir;
+
+	/**
+	 * \brief A physical block device (HDD, SSD, NVMe, RAID), that holds plot files.
+	 * On Linux the device of a plot file is resolved by its st_dev and the /sys/block topology,
+	 * on other platforms every plot dir is its own device.
+	 */
+	struct PlotDevice
+	{
+		/**
+		 * \brief The unique id of the device (major:minor on Linux, the plot dir otherwise).
+		 */
+		std::string id;
+
+		/**
+		 * \brief The name of the device (e.g. /dev/sda), the plot dir if the device is unknown.
+		 */
+		std::string name;
+
+		/**
+		 * \brief True, if the device has spinning disks (or if it is unknown).
+		 */
+		bool rotational = true;
+
+		/**
+		 * \brief The number of disks, that the device consists of (more than one for a RAID).
+		 */
+		unsigned disks = 1;
+
+		/**
+		 * \brief All plot files on the device.
+		 */
+		std::vector<std::shared_ptr<PlotFile>> plotFiles;
+
+		/**
+		 * \brief The plot dir of every plot file (same index as the plot files).
+		 */
+		std::vector<std::string> plotFileDirs;
+
+		/**
+		 * \brief Returns the max. number of readers, that read the device at the same time.
+		 * A spinning disk is read by one reader, so its head does not need to jump between two places.
+		 * \param nonRotationalReaders The max. number of readers for a device without spinning disks.
+		 * \return The max. number of readers.
+		 */
+		unsigned getMaxReaders(unsigned nonRotationalReaders) const;
+
+		/**
+		 * \brief Adds the plot files of a plot dir to the devices, they are stored on.
+		 * Devices, that are not in the list yet, are added.
+		 * \param devices The list of devices.
+		 * \param plotDir The plot dir, its related dirs are also added.
+		 */
+		static void addPlotDir(std::vector<PlotDevice>& devices, const PlotDir& plotDir);
+
+		/**
+		 * \brief Adds a plot file to the device, it is stored on.
+		 * If the device is not in the list yet, it is added.
+		 * \param devices The list of devices.
+		 * \param plotFile The plot file.
+		 * \param plotDir The plot dir of the plot file.
+		 */
+		static void addPlotFile(std::vector<PlotDevice>& devices, const std::shared_ptr<PlotFile>& plotFile,
+			const std::string& plotDir);
+	};
+}
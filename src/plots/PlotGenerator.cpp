@@ -24,59 +24,37 @@
 #include "shabal/MinerShabal.hpp"
 #include "mining/Miner.hpp"
 #include "PlotVerifier.hpp"
+#include "PlotReader.hpp"
 #include "MinerUtil.hpp"
+#include "mining/MinerConfig.hpp"
+#include <algorithm>
 #include <fstream>
 #include <random>
 #include "webserver/MinerServer.hpp"
+#include "PlotChecker.hpp"
+#include "Plot.hpp"
+#include <Poco/File.h>
 #include <future>
 #include <thread>
 
 Poco::UInt64 Burst::PlotGenerator::generateAndCheck(Poco::UInt64 account, Poco::UInt64 nonce, const Miner& miner)
 {
-	char final[32];
-	char gendata[16 + Settings::PlotSize];
+	auto& arena = PlotGeneratorArena::getThreadArena();
+	arena.generate(account, nonce, 1);
 
-	auto xv = reinterpret_cast<char*>(&account);
-
-	for (auto j = 0u; j <= 7; ++j)
-		gendata[Settings::PlotSize + j] = xv[7 - j];
-
-	xv = reinterpret_cast<char*>(&nonce);
-
-	for (auto j = 0u; j <= 7; ++j)
-		gendata[Settings::PlotSize + 8 + j] = xv[7 - j];
-
-	for (auto i = Settings::PlotSize; i > 0; i -= Settings::HashSize)
-	{
-		Shabal256_SSE2 x;
-
-		auto len = Settings::PlotSize + 16 - i;
-
-		if (len > Settings::ScoopPerPlot)
-			len = Settings::ScoopPerPlot;
-
-		x.update(&gendata[i], len);
-		x.close(&gendata[i - Settings::HashSize]);
-	}
-
-	Shabal256_SSE2 x;
-	x.update(&gendata[0], 16 + Settings::PlotSize);
-	x.close(&final[0]);
-
-	// XOR with final
-	for (size_t i = 0; i < Settings::PlotSize; i++)
-		gendata[i] ^= final[i % Settings::HashSize];
+	const auto poc2 = MinerConfig::getConfig().isPoc2Block(miner.getBlockheight());
+	ScoopData scoopData;
+	arena.copyScoop(0, miner.getScoopNum(), poc2, reinterpret_cast<char*>(scoopData.data()));
 
 	std::array<uint8_t, 32> target;
 	Poco::UInt64 result;
 
 	const auto generationSignature = miner.getGensig();
-	const auto scoop = miner.getScoopNum();
 	const auto basetarget = miner.getBaseTarget();
 
 	Shabal256_SSE2 y;
 	y.update(generationSignature.data(), Settings::HashSize);
-	y.update(&gendata[scoop * Settings::ScoopSize], Settings::ScoopSize);
+	y.update(scoopData.data(), Settings::ScoopSize);
 	y.close(target.data());
 
 	memcpy(&result, target.data(), sizeof(Poco::UInt64));
@@ -87,122 +65,139 @@ Poco::UInt64 Burst::PlotGenerator::generateAndCheck(Poco::UInt64 account, Poco::
 
 double Burst::PlotGenerator::checkPlotfileIntegrity(std::string plotPath, Miner& miner, MinerServer& server)
 {
-	const auto account = Poco::NumberParser::parseUnsigned64(getAccountIdFromPlotFile(plotPath));
-	const auto startNonce = Poco::NumberParser::parseUnsigned64(getStartNonceFromPlotFile(plotPath));
-	const auto nonceCount = Poco::NumberParser::parseUnsigned64(getNonceCountFromPlotFile(plotPath));
-	const auto staggerSize = Poco::NumberParser::parseUnsigned64(getStaggerSizeFromPlotFile(plotPath));
-
-	//set up random number generator
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<Poco::UInt64> randInt(0, nonceCount);
-
-	log_system(MinerLogger::general, "Validating the integrity of file " + plotPath + " ...");
-	
-	const auto checkNonces = 32ull;		//number of nonces to check
-	const auto checkScoops = 32ull;		//number of scoops to check per nonce
-	const auto scoopSize = Settings::ScoopSize;
-	const auto scoopStep = Settings::ScoopPerPlot / checkScoops;
-	const auto nonceStep = (nonceCount / checkNonces);
-
-	// drawing random numbers to decide which scoops/nonces to check
-	std::vector<Poco::UInt64> scoops(checkScoops + 1);
-	std::vector<Poco::UInt64> nonces(checkNonces + 1);
-	for (auto i = 0; i < (checkScoops + 1); i++) scoops[i] = randInt(gen) % scoopStep;
-	for (auto i = 0; i < (checkNonces + 1); i++) nonces[i] = randInt(gen) % nonceStep;
-
-	// reading the nonces from the plot file in a parallel thread
-	std::vector<char> readNonce(16 + scoopSize * checkNonces * checkScoops);
-
-	std::thread nonceReader([&readNonce, scoops, plotPath, &miner, nonces, checkNonces, checkScoops,
-		startNonce, nonceCount, staggerSize, scoopSize, scoopStep, nonceStep]
+	Poco::File file{plotPath};
+
+	if (!file.exists())
 	{
-		const auto nonceScoopOffset = staggerSize * scoopSize;
-		for (auto scoopInterval = 0ull; scoopInterval < checkScoops; scoopInterval++)
+		log_error(MinerLogger::general, "The plot file %s does not exist!", plotPath);
+		return 0;
+	}
+
+	const auto plotFile = std::make_shared<PlotFile>(std::move(plotPath), file.getSize());
+	return PlotChecker{miner, server}.check({plotFile});
+}
+
+void Burst::PlotGenerator::convertPocFormat(char* nonce)
+{
+	const auto halfScoop = Settings::ScoopSize / 2;
+
+	for (auto scoop = 0u; scoop < Settings::ScoopPerPlot / 2; ++scoop)
+	{
+		const auto mirrorScoop = Settings::ScoopPerPlot - 1 - scoop;
+		std::swap_ranges(nonce + scoop * Settings::ScoopSize + halfScoop, nonce + (scoop + 1) * Settings::ScoopSize,
+			nonce + mirrorScoop * Settings::ScoopSize + halfScoop);
+	}
+}
+
+bool Burst::PlotGenerator::selfTest()
+{
+	struct GoldenScoop
+	{
+		size_t scoop;
+		std::string poc1, poc2;
+	};
+
+	// generated with the reference implementation of sphlib, the PoC2 scoop is the first hash of the
+	// PoC1 scoop and the second hash of the mirrored PoC1 scoop (4095 - scoop)
+	static const std::vector<GoldenScoop> goldenScoops = {
 		{
-			while (miner.isProcessing()) Poco::Thread::sleep(1000);
-
-			auto scoop = scoopInterval * scoopStep + scoops[scoopInterval];
-			if (scoop >= Settings::ScoopPerPlot) scoop = Settings::ScoopPerPlot - 1;
-
-			std::ifstream plotFile(plotPath, std::ifstream::in | std::ifstream::binary);
-
-			for (auto nonceInterval = 0ull; nonceInterval < checkNonces; nonceInterval++)
-			{
-				auto nonce = startNonce + nonceInterval * nonceStep + nonces[nonceInterval];
-				if (nonce >= startNonce + nonceCount) nonce = startNonce + nonceCount - 1;
-				const auto nonceStaggerOffset = ((nonce - startNonce) / staggerSize) *Settings::PlotSize*staggerSize + ((nonce - startNonce) % staggerSize)*scoopSize;
-				plotFile.seekg(nonceStaggerOffset + scoop * nonceScoopOffset);
-				plotFile.read(readNonce.data() + nonceInterval * scoopSize + (checkNonces*scoopInterval*scoopSize), scoopSize);
-			}
-			plotFile.close();
+			0,
+			"8086f62bbbdc23156fee8b507e7a834e5257c3e49df418ed9adffc4a01722e6a"
+			"3727354a3388997301a9ee104c266429762bcfbaab30b2fd2e69c1f83adc8437",
+			"8086f62bbbdc23156fee8b507e7a834e5257c3e49df418ed9adffc4a01722e6a"
+			"497034f050cea60a0126b27024c8d89c3e9e3523b279afb69b2710dd83ba1bfa"
+		},
+		{
+			1000,
+			"f178cf9a80ca57138e18812c7d611b0491dd41766c4362fbff7577328b1f7d5d"
+			"74235d10c52a71b5fc7070919067478a5d68dad2efef1acebf183d111af50494",
+			"f178cf9a80ca57138e18812c7d611b0491dd41766c4362fbff7577328b1f7d5d"
+			"2e0dbe929954750d627cbdb636fbe377faca4da5a3599e4cc5b6eae2abef6ada"
+		},
+		{
+			4095,
+			"57805fe206ef9a5173b328525a8aa44d51d558034e952cbb155c79859d465827"
+			"497034f050cea60a0126b27024c8d89c3e9e3523b279afb69b2710dd83ba1bfa",
+			"57805fe206ef9a5173b328525a8aa44d51d558034e952cbb155c79859d465827"
+			"3727354a3388997301a9ee104c266429762bcfbaab30b2fd2e69c1f83adc8437"
 		}
-	});
+	};
 
-	//Generating the Nonces to compare the scoops with what we have read from the file
-	std::array<std::vector<char>, checkNonces> genData;
+	auto passed = true;
 
-	for (auto nonceInterval = 0ull; nonceInterval < checkNonces; nonceInterval++)
+	const auto check = [&passed](const std::string& name, const size_t scoop, const ScoopData& scoopData,
+		const std::string& expected)
 	{
-		auto nonce = startNonce + nonceInterval * nonceStep + nonces[nonceInterval];
-		if (nonce >= startNonce + nonceCount) nonce = startNonce + nonceCount - 1;
-		genData[nonceInterval] = generateSse2(account, nonce)[0];
-	}
+		const auto actual = byteArrayToStr(scoopData);
 
-	//waiting for read thread to finish
-	nonceReader.join();
+		if (actual == expected)
+			return;
 
-	//Comparing the read nonces with the generated ones
-	auto totalIntegrity = 0.0;
-	auto noncesChecked = 0;
+		log_error(MinerLogger::general, "Self test %s failed for scoop %z!\n\texpected: %s\n\tactual:   %s",
+			name, scoop, expected, actual);
+		passed = false;
+	};
 
-	for (auto nonceInterval = 0ull; nonceInterval < checkNonces; nonceInterval++)
+	const auto getScoop = [](const char* nonce, const size_t scoop)
 	{
-		auto nonce = startNonce + nonceInterval * nonceStep + nonces[nonceInterval];
-		if (nonce >= startNonce + nonceCount) nonce = startNonce + nonceCount - 1;
-		auto scoopsIntact = 0ull;
-		auto scoopsChecked = 0ull;
+		ScoopData scoopData;
+		memcpy(scoopData.data(), nonce + scoop * Settings::ScoopSize, Settings::ScoopSize);
+		return scoopData;
+	};
 
-		for (auto scoopInterval = 0ull; scoopInterval < checkScoops; scoopInterval++)
-		{
-			auto scoop = scoopInterval * scoopStep + scoops[scoopInterval];
-			if (scoop >= Settings::ScoopPerPlot) scoop = Settings::ScoopPerPlot - 1;
-			const auto scoopPos = scoop * scoopSize;
-			const auto nonceScoopPos = nonceInterval * scoopSize + (checkNonces*scoopInterval*scoopSize);
-			auto bytes = 0;
-			for (auto i = 0ull; i < scoopSize; i++)
-				if (genData[nonceInterval][scoopPos + i] == readNonce[nonceScoopPos + i]) bytes++;
-			if (bytes == 64)
-				scoopsIntact++;
-			scoopsChecked++;
-		}
-		const auto intact = 100.0 * scoopsIntact / scoopsChecked;
-		//log_information(MinerLogger::general, "Nonce %s: %s% Integrity.", std::to_string(nonce), std::to_string(intact));
-		totalIntegrity += intact;
-		noncesChecked++;
-	}
+	// the nonce of the widest kernel and of the SSE2 kernel (the baseline)
+	auto& arena = PlotGeneratorArena::getThreadArena();
+	arena.generate(12345, 0, 1);
+	const auto sse2 = generateSse2(12345, 0);
+
+	std::vector<char> poc1Nonce(arena.getNonce(0), arena.getNonce(0) + Settings::PlotSize);
+	auto poc2Nonce = poc1Nonce;
+	convertPocFormat(poc2Nonce.data());
+
+	for (const auto& golden : goldenScoops)
+	{
+		const auto mirror = Settings::ScoopPerPlot - 1 - golden.scoop;
+		ScoopData scoopData;
+
+		check(PlotGeneratorArena::getInstructionSet() + " PoC1 nonce", golden.scoop, getScoop(poc1Nonce.data(), golden.scoop),
+			golden.poc1);
+		check("SSE2 PoC1 nonce", golden.scoop, getScoop(sse2[0].data(), golden.scoop), golden.poc1);
+
+		arena.copyScoop(0, golden.scoop, true, reinterpret_cast<char*>(scoopData.data()));
+		check("PoC2 scoop copy", golden.scoop, scoopData, golden.poc2);
+
+		check("convertPocFormat PoC1 -> PoC2", golden.scoop, getScoop(poc2Nonce.data(), golden.scoop), golden.poc2);
 
-	if(totalIntegrity / noncesChecked < 100.0)
-		log_error(MinerLogger::general, "Total Integrity of %s: %0.3f%%", plotPath, totalIntegrity / noncesChecked);
-	else
-		log_success(MinerLogger::general, "Total Integrity of %s: %0.3f%%", plotPath, totalIntegrity / noncesChecked);
+		// a PoC1 file mined in a PoC2 block and the other way around
+		scoopData = getScoop(poc1Nonce.data(), golden.scoop);
+		auto mirrorScoopData = getScoop(poc1Nonce.data(), mirror);
+		PlotReader::mergeMirroredHalves(&scoopData, &mirrorScoopData, 1);
+		check("mergeMirroredHalves PoC1 -> PoC2", golden.scoop, scoopData, golden.poc2);
 
-	const auto plotId = getAccountIdFromPlotFile(plotPath) + "_" + getStartNonceFromPlotFile(plotPath) + "_" + getNonceCountFromPlotFile(plotPath) + "_" + getStaggerSizeFromPlotFile(plotPath);
+		scoopData = getScoop(poc2Nonce.data(), golden.scoop);
+		mirrorScoopData = getScoop(poc2Nonce.data(), mirror);
+		PlotReader::mergeMirroredHalves(&scoopData, &mirrorScoopData, 1);
+		check("mergeMirroredHalves PoC2 -> PoC1", golden.scoop, scoopData, golden.poc1);
+	}
+
+	// the conversion is the same in both directions
+	convertPocFormat(poc2Nonce.data());
 
-	//response to websockets
-	Poco::JSON::Object json;
-	json.set("type", "plotcheck-result");
-	json.set("plotID", plotId);
-	json.set("plotIntegrity", std::to_string(totalIntegrity / noncesChecked));
+	if (poc2Nonce != poc1Nonce)
+	{
+		log_error(MinerLogger::general, "Self test convertPocFormat PoC2 -> PoC1 failed!");
+		passed = false;
+	}
 
-	server.sendToWebsockets(json);
+	if (passed)
+		log_success(MinerLogger::general, "Self test passed (%s)", PlotGeneratorArena::getInstructionSet());
 
-	return totalIntegrity / noncesChecked;
+	return passed;
 }
 
 std::array<std::vector<char>, Burst::Shabal256_SSE2::HashSize> Burst::PlotGenerator::generateSse2(const Poco::UInt64 account, const Poco::UInt64 startNonce)
 {
-	return generate<Shabal256_SSE2, PlotGeneratorOperations1<Shabal256_SSE2>>(account, startNonce);
+	return generate<Shabal256_SSE2, PlotGeneratorOperations_sse2>(account, startNonce);
 }
 
 std::array<std::vector<char>, Burst::Shabal256_AVX::HashSize> Burst::PlotGenerator::generateAvx(const Poco::UInt64 account, const Poco::UInt64 startNonce)
@@ -220,11 +215,16 @@ std::array<std::vector<char>, Burst::Shabal256_AVX2::HashSize> Burst::PlotGenera
 	return generate<Shabal256_AVX2, PlotGeneratorOperations8<Shabal256_AVX2>>(account, startNonce);
 }
 
-Poco::UInt64 Burst::PlotGenerator::calculateDeadlineSse2(std::vector<char>& gendata,
-	GensigData& generationSignature, const Poco::UInt64 scoop, const Poco::UInt64 baseTarget)
+std::array<std::vector<char>, Burst::Shabal256_AVX512::HashSize> Burst::PlotGenerator::generateAvx512(const Poco::UInt64 account, const Poco::UInt64 startNonce)
+{
+	return generate<Shabal256_AVX512, PlotGeneratorOperations16<Shabal256_AVX512>>(account, startNonce);
+}
+
+std::array<Poco::UInt64, Burst::Shabal256_SSE2::HashSize> Burst::PlotGenerator::
+	calculateDeadlineSse2(std::array<std::vector<char>, Shabal256_SSE2::HashSize>& gendatas,
+		GensigData& generationSignature, const Poco::UInt64 scoop, const Poco::UInt64 baseTarget)
 {
-	std::array<std::vector<char>, 1> container = {gendata};
-	return calculateDeadline<Shabal256_SSE2, PlotGeneratorOperations1<Shabal256_SSE2>>(container, generationSignature, scoop, baseTarget)[0];
+	return calculateDeadline<Shabal256_SSE2, PlotGeneratorOperations_sse2>(gendatas, generationSignature, scoop, baseTarget);
 }
 
 std::array<Poco::UInt64, Burst::Shabal256_AVX::HashSize> Burst::PlotGenerator::
@@ -247,3 +247,124 @@ std::array<Poco::UInt64, Burst::Shabal256_AVX2::HashSize> Burst::PlotGenerator::
 {
 	return calculateDeadline<Shabal256_AVX2, PlotGeneratorOperations8<Shabal256_AVX2>>(gendatas, generationSignature, scoop, baseTarget);
 }
+
+std::array<Poco::UInt64, Burst::Shabal256_AVX512::HashSize> Burst::PlotGenerator::
+	calculateDeadlineAvx512(std::array<std::vector<char>, Shabal256_AVX512::HashSize>& gendatas,
+		GensigData& generationSignature, const Poco::UInt64 scoop, const Poco::UInt64 baseTarget)
+{
+	return calculateDeadline<Shabal256_AVX512, PlotGeneratorOperations16<Shabal256_AVX512>>(gendatas, generationSignature, scoop, baseTarget);
+}
+
+namespace
+{
+	struct PlotGeneratorKernel
+	{
+		std::string instructionSet;
+		size_t lanes;
+		void (*generate)(Poco::UInt64 account, Poco::UInt64 startNonce, char* nonces, size_t stride);
+	};
+
+	template <typename TShabal, typename TOperations>
+	void generateBatch(const Poco::UInt64 account, const Poco::UInt64 startNonce, char* nonces, const size_t stride)
+	{
+		std::array<char*, TShabal::HashSize> gendatas{};
+
+		for (size_t lane = 0; lane < TShabal::HashSize; ++lane)
+			gendatas[lane] = nonces + lane * stride;
+
+		Burst::PlotGenerator::generate<TShabal, TOperations>(account, startNonce, gendatas);
+	}
+
+	const PlotGeneratorKernel& getPlotGeneratorKernel()
+	{
+		using namespace Burst;
+
+		// the widest kernel, that is supported by the build and the cpu
+		static const auto kernel = []() -> PlotGeneratorKernel
+		{
+			if (Settings::Avx512 && cpuHasInstructionSet(CpuInstructionSet::avx512))
+				return {"AVX512", Shabal256_AVX512::HashSize,
+					&generateBatch<Shabal256_AVX512, PlotGeneratorOperations16<Shabal256_AVX512>>};
+
+			if (Settings::Avx2 && cpuHasInstructionSet(CpuInstructionSet::avx2))
+				return {"AVX2", Shabal256_AVX2::HashSize,
+					&generateBatch<Shabal256_AVX2, PlotGeneratorOperations8<Shabal256_AVX2>>};
+
+			if (Settings::Avx && cpuHasInstructionSet(CpuInstructionSet::avx))
+				return {"AVX", Shabal256_AVX::HashSize,
+					&generateBatch<Shabal256_AVX, PlotGeneratorOperations4<Shabal256_AVX>>};
+
+			if (Settings::Sse4 && cpuHasInstructionSet(CpuInstructionSet::sse4))
+				return {"SSE4", Shabal256_SSE4::HashSize,
+					&generateBatch<Shabal256_SSE4, PlotGeneratorOperations4<Shabal256_SSE4>>};
+
+			return {"SSE2", Shabal256_SSE2::HashSize, &generateBatch<Shabal256_SSE2, PlotGeneratorOperations_sse2>};
+		}();
+
+		return kernel;
+	}
+}
+
+constexpr size_t Burst::PlotGeneratorArena::CacheLineSize;
+constexpr size_t Burst::PlotGeneratorArena::NonceStride;
+
+Burst::PlotGeneratorArena::PlotGeneratorArena()
+	: nonces_(nullptr), capacity_(0)
+{}
+
+void Burst::PlotGeneratorArena::generate(const Poco::UInt64 account, const Poco::UInt64 startNonce, const size_t nonces)
+{
+	const auto& kernel = getPlotGeneratorKernel();
+
+	// the last batch fills every lane, even if not all nonces are needed
+	const auto batches = (nonces + kernel.lanes - 1) / kernel.lanes;
+	const auto capacity = batches * kernel.lanes;
+
+	if (capacity > capacity_)
+	{
+		buffer_.resize(capacity * NonceStride + CacheLineSize);
+
+		void* alignedBuffer = buffer_.data();
+		auto space = buffer_.size();
+
+		nonces_ = static_cast<char*>(std::align(CacheLineSize, capacity * NonceStride, alignedBuffer, space));
+		capacity_ = capacity;
+	}
+
+	for (size_t batch = 0; batch < batches; ++batch)
+		kernel.generate(account, startNonce + batch * kernel.lanes, nonces_ + batch * kernel.lanes * NonceStride,
+			NonceStride);
+}
+
+const char* Burst::PlotGeneratorArena::getNonce(const size_t index) const
+{
+	return nonces_ + index * NonceStride;
+}
+
+void Burst::PlotGeneratorArena::copyScoop(const size_t index, const size_t scoop, const bool poc2, char* target) const
+{
+	const auto nonce = getNonce(index);
+	const auto source = nonce + scoop * Settings::ScoopSize;
+
+	// PoC2 takes the second hash from the mirrored scoop
+	const auto secondHash = poc2 ? nonce + (Settings::ScoopPerPlot - 1 - scoop) * Settings::ScoopSize : source;
+
+	memcpy(target, source, Settings::HashSize);
+	memcpy(target + Settings::HashSize, secondHash + Settings::HashSize, Settings::HashSize);
+}
+
+size_t Burst::PlotGeneratorArena::getLanes()
+{
+	return getPlotGeneratorKernel().lanes;
+}
+
+const std::string& Burst::PlotGeneratorArena::getInstructionSet()
+{
+	return getPlotGeneratorKernel().instructionSet;
+}
+
+Burst::PlotGeneratorArena& Burst::PlotGeneratorArena::getThreadArena()
+{
+	static thread_local PlotGeneratorArena arena;
+	return arena;
+}
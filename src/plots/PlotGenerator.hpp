@@ -23,6 +23,7 @@
 
 #include <Poco/Types.h>
 #include <mutex>
+#include <string>
 #include <vector>
 #include <condition_variable>
 #include "Declarations.hpp"
@@ -42,12 +43,29 @@ namespace Burst
 		static Poco::UInt64 generateAndCheck(Poco::UInt64 account, Poco::UInt64 nonce, const Miner& miner);
 		static double checkPlotfileIntegrity(std::string plotPath, Miner& miner, MinerServer& server);
 
+		/**
+		 * \brief Converts a generated nonce between the PoC1 and the PoC2 format.
+		 * The second hash of every scoop is swapped with the one of the mirrored scoop (4095 - scoop),
+		 * so the conversion is the same in both directions.
+		 * \param nonce The data of the nonce (4096 scoops).
+		 */
+		static void convertPocFormat(char* nonce);
+
+		/**
+		 * \brief Checks the nonce generation, the PoC format conversion and the merging of mirrored scoops
+		 * against golden vectors of both formats (account 12345, nonce 0).
+		 * \return true, if all vectors match, false otherwise.
+		 */
+		static bool selfTest();
+
 		static std::array<std::vector<char>, Shabal256_SSE2::HashSize> generateSse2(Poco::UInt64 account, Poco::UInt64 startNonce);
 		static std::array<std::vector<char>, Shabal256_AVX::HashSize> generateAvx(Poco::UInt64 account, Poco::UInt64 startNonce);
 		static std::array<std::vector<char>, Shabal256_SSE4::HashSize> generateSse4(Poco::UInt64 account, Poco::UInt64 startNonce);
 		static std::array<std::vector<char>, Shabal256_AVX2::HashSize> generateAvx2(Poco::UInt64 account, Poco::UInt64 startNonce);
+		static std::array<std::vector<char>, Shabal256_AVX512::HashSize> generateAvx512(Poco::UInt64 account, Poco::UInt64 startNonce);
 
-		static Poco::UInt64 calculateDeadlineSse2(std::vector<char>& gendata,
+		static std::array<Poco::UInt64, Shabal256_SSE2::HashSize> calculateDeadlineSse2(
+			std::array<std::vector<char>, Shabal256_SSE2::HashSize>& gendatas,
 			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
 
 		static std::array<Poco::UInt64, Shabal256_AVX::HashSize> calculateDeadlineAvx(
@@ -62,25 +80,32 @@ namespace Burst
 			std::array<std::vector<char>, Shabal256_AVX2::HashSize>& gendatas,
 			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
 
-	private:
+		static std::array<Poco::UInt64, Shabal256_AVX512::HashSize> calculateDeadlineAvx512(
+			std::array<std::vector<char>, Shabal256_AVX512::HashSize>& gendatas,
+			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
+
+		/**
+		 * \brief Generates one nonce per SIMD lane into preallocated buffers.
+		 * The buffers are not allocated here, so a plotter can reuse them for every batch.
+		 * \param account The numeric id of the account.
+		 * \param startNonce The nonce of the first lane, the other lanes get the following nonces.
+		 * \param gendatas One buffer with 16 + PlotSize bytes per lane.
+		 */
 		template <typename TShabal, typename TOperations>
-		static std::array<std::vector<char>, TShabal::HashSize> generate(const Poco::UInt64 account, const Poco::UInt64 startNonce)
+		static void generate(const Poco::UInt64 account, const Poco::UInt64 startNonce,
+			const std::array<char*, TShabal::HashSize>& gendatas)
 		{
 			std::array<std::array<char, 32>, TShabal::HashSize> finals{};
-			std::array<std::vector<char>, TShabal::HashSize> gendatas{};
-
-			for (auto& gendata : gendatas)
-				gendata.resize(16 + Settings::PlotSize);
 
 			auto xv = reinterpret_cast<const char*>(&account);
 
-			for (auto& gendata : gendatas)
+			for (auto gendata : gendatas)
 				for (auto j = 0u; j <= 7; ++j)
 					gendata[Settings::PlotSize + j] = xv[7 - j];
 
 			auto nonce = startNonce;
 
-			for (auto& gendata : gendatas)
+			for (auto gendata : gendatas)
 			{
 				xv = reinterpret_cast<char*>(&nonce);
 				
@@ -104,8 +129,8 @@ namespace Burst
 
 				for (size_t j = 0; j < TShabal::HashSize; ++j)
 				{
-					gendataUpdatePtr[j] = reinterpret_cast<unsigned char*>(gendatas[j].data() + i);
-					gendataClosePtr[j] = reinterpret_cast<unsigned char*>(gendatas[j].data() + i - Settings::HashSize);
+					gendataUpdatePtr[j] = reinterpret_cast<unsigned char*>(gendatas[j] + i);
+					gendataClosePtr[j] = reinterpret_cast<unsigned char*>(gendatas[j] + i - Settings::HashSize);
 				}
 
 				TOperations::update(x, gendataUpdatePtr, len);
@@ -116,7 +141,7 @@ namespace Burst
 
 			for (size_t i = 0; i < TShabal::HashSize; ++i)
 			{
-				gendataUpdatePtr[i] = reinterpret_cast<unsigned char*>(gendatas[i].data());
+				gendataUpdatePtr[i] = reinterpret_cast<unsigned char*>(gendatas[i]);
 				gendataClosePtr[i] = reinterpret_cast<unsigned char*>(&finals[i][0]);
 			}
 
@@ -127,8 +152,23 @@ namespace Burst
 			for (size_t i = 0; i < TShabal::HashSize; ++i)
 				for (size_t j = 0; j < Settings::PlotSize; j++)
 					gendatas[i][j] ^= finals[i][j % Settings::HashSize];
+		}
+
+	private:
+		template <typename TShabal, typename TOperations>
+		static std::array<std::vector<char>, TShabal::HashSize> generate(const Poco::UInt64 account, const Poco::UInt64 startNonce)
+		{
+			std::array<std::vector<char>, TShabal::HashSize> gendatas{};
+			std::array<char*, TShabal::HashSize> buffers{};
+
+			for (size_t i = 0; i < TShabal::HashSize; ++i)
+			{
+				gendatas[i].resize(16 + Settings::PlotSize);
+				buffers[i] = gendatas[i].data();
+			}
 
-			return std::move(gendatas);
+			generate<TShabal, TOperations>(account, startNonce, buffers);
+			return gendatas;
 		}
 
 		template <typename TShabal, typename TOperations, typename TContainer>
@@ -215,4 +255,96 @@ namespace Burst
 				container[4], container[5], container[6], container[7]);
 		}
 	};
+
+	template <typename TShabal>
+	struct PlotGeneratorOperations16
+	{
+		template <typename TContainer>
+		static void update(TShabal& shabal, const TContainer& container, const Poco::UInt64 length)
+		{
+			shabal.update(container[0], container[1], container[2], container[3],
+				container[4], container[5], container[6], container[7],
+				container[8], container[9], container[10], container[11],
+				container[12], container[13], container[14], container[15], length);
+		}
+
+		template <typename TContainer>
+		static void close(TShabal& shabal, const TContainer& container)
+		{
+			shabal.close(container[0], container[1], container[2], container[3],
+				container[4], container[5], container[6], container[7],
+				container[8], container[9], container[10], container[11],
+				container[12], container[13], container[14], container[15]);
+		}
+	};
+
+#ifdef USE_SSE2
+	using PlotGeneratorOperations_sse2 = PlotGeneratorOperations4<Shabal256_SSE2>;
+#else
+	using PlotGeneratorOperations_sse2 = PlotGeneratorOperations1<Shabal256_SSE2>;
+#endif
+
+	/**
+	 * \brief A reusable buffer for the generation of nonces.
+	 * The buffer grows to the largest batch and is never freed, so the generation
+	 * does not allocate after the first batch. Every nonce starts at a cache line.
+	 * The nonces are generated with the widest kernel, that is supported by the build and the cpu.
+	 */
+	class PlotGeneratorArena
+	{
+	public:
+		static constexpr size_t CacheLineSize = 64;
+
+		PlotGeneratorArena();
+
+		/**
+		 * \brief Generates consecutive nonces, the nonces of the last batch are overwritten.
+		 * \param account The numeric id of the account.
+		 * \param startNonce The first nonce.
+		 * \param nonces The number of nonces.
+		 */
+		void generate(Poco::UInt64 account, Poco::UInt64 startNonce, size_t nonces);
+
+		/**
+		 * \brief Returns the data of a generated nonce (4096 scoops in the PoC1 format).
+		 * \param index The index of the nonce inside the batch.
+		 * \return The data of the nonce.
+		 */
+		const char* getNonce(size_t index) const;
+
+		/**
+		 * \brief Copies a scoop of a generated nonce.
+		 * \param index The index of the nonce inside the batch.
+		 * \param scoop The number of the scoop.
+		 * \param poc2 If true, the scoop is copied in the PoC2 format, otherwise in the PoC1 format.
+		 * \param target The target, it needs ScoopSize bytes.
+		 */
+		void copyScoop(size_t index, size_t scoop, bool poc2, char* target) const;
+
+		/**
+		 * \brief Returns the number of nonces, that are generated at once.
+		 * Batches, that are a multiple of it, use every lane of the kernel.
+		 * \return The number of SIMD lanes of the kernel.
+		 */
+		static size_t getLanes();
+
+		/**
+		 * \brief Returns the name of the instruction set of the kernel.
+		 * \return The name of the instruction set.
+		 */
+		static const std::string& getInstructionSet();
+
+		/**
+		 * \brief Returns the arena of the calling thread.
+		 * \return The arena.
+		 */
+		static PlotGeneratorArena& getThreadArena();
+
+	private:
+		static constexpr size_t NonceStride = (16 + Settings::PlotSize + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+
+		std::vector<char> buffer_;
+		char* nonces_;
+		size_t capacity_;
+	};
 }
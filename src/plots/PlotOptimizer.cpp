@@ -0,0 +1,387 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotOptimizer.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Thread.h>
+#include <algorithm>
+#include <fstream>
+#include <future>
+
+Burst::PlotOptimizer::PlotOptimizer(std::vector<std::string> plotFiles, std::string outputDir, const bool poc2,
+	const Poco::UInt64 memoryBytes)
+	: plotFiles_(std::move(plotFiles)),
+	  outputDir_(std::move(outputDir)),
+	  poc2_(poc2),
+	  nonces_(0)
+{
+	// two buffers, so that the next window is read while the current one is written
+	windowNonces_ = std::max<Poco::UInt64>(memoryBytes / (2 * Settings::PlotSize), 1);
+}
+
+bool Burst::PlotOptimizer::run(const std::function<bool()>& pause, const std::function<bool()>& cancel)
+{
+	if (!prepare())
+		return false;
+
+	auto noncesWritten = readProgress();
+
+	if (noncesWritten >= nonces_)
+	{
+		log_information(MinerLogger::general, "The plot file %s is already optimized", outputPath_);
+		return true;
+	}
+
+	Poco::File outputFile{outputPath_};
+
+	if (noncesWritten == 0)
+	{
+		const auto size = nonces_ * Settings::PlotSize;
+		const auto existing = outputFile.exists() ? outputFile.getSize() : 0;
+
+		if (Poco::File{outputDir_}.freeSpace() + existing < size)
+		{
+			log_error(MinerLogger::general, "Not enough free space in %s to optimize the plot file %s (needed: %s)",
+				outputDir_, outputPath_, memToString(size, 2));
+			return false;
+		}
+
+		// the progress is written first, so that an interrupted preallocation is repeated
+		if (!writeProgress(0))
+			return false;
+
+		outputFile.createFile();
+		outputFile.setSize(size);
+	}
+	else
+		log_information(MinerLogger::general, "Resuming the optimization of %s at nonce %s of %s", outputPath_,
+			numberToString(noncesWritten), numberToString(nonces_));
+
+	std::fstream output{outputPath_, std::ios::in | std::ios::out | std::ios::binary};
+
+	if (!output)
+	{
+		log_error(MinerLogger::general, "Could not open the plot file %s for writing!", outputPath_);
+		return false;
+	}
+
+	// the windows start at the resumed nonce and never cross the border of an input file
+	std::vector<Window> windows;
+
+	for (auto nonce = noncesWritten; nonce < nonces_;)
+	{
+		auto input = std::find_if(inputs_.begin(), inputs_.end(), [&](const Input& in)
+		{
+			return in.nonceStart - inputs_.front().nonceStart + in.nonces > nonce;
+		});
+
+		Window window;
+		window.input = &*input;
+		window.outputNonce = nonce;
+		window.inputNonce = nonce - (input->nonceStart - inputs_.front().nonceStart);
+		window.nonces = std::min(windowNonces_, input->nonces - window.inputNonce);
+		windows.emplace_back(window);
+		nonce += window.nonces;
+	}
+
+	std::vector<char> buffers[2];
+	buffers[0].resize(windowNonces_ * Settings::PlotSize);
+	buffers[1].resize(windowNonces_ * Settings::PlotSize);
+
+	const auto read = [&](const size_t index)
+	{
+		auto& window = windows[index];
+		auto buffer = buffers[index % 2].data();
+
+		if (!readWindow(window, buffer, pause, cancel))
+			return false;
+
+		convertWindow(window, buffer);
+		return true;
+	};
+
+	auto nextRead = std::async(std::launch::async, read, 0);
+	auto lastPercent = noncesWritten * 100 / nonces_;
+
+	for (size_t i = 0; i < windows.size(); ++i)
+	{
+		if (!nextRead.get())
+			return false;
+
+		if (i + 1 < windows.size())
+			nextRead = std::async(std::launch::async, read, i + 1);
+
+		while (pause() && !cancel())
+			Poco::Thread::sleep(100);
+
+		const auto& window = windows[i];
+
+		if (cancel() || !writeWindow(window, buffers[i % 2].data(), output))
+		{
+			if (nextRead.valid())
+				nextRead.wait();
+			return false;
+		}
+
+		noncesWritten = window.outputNonce + window.nonces;
+
+		if (!writeProgress(noncesWritten))
+		{
+			if (nextRead.valid())
+				nextRead.wait();
+			return false;
+		}
+
+		const auto percent = noncesWritten * 100 / nonces_;
+
+		if (percent / 10 != lastPercent / 10)
+			log_information(MinerLogger::general, "Optimizing %s: %s%%", outputPath_, numberToString(percent));
+
+		lastPercent = percent;
+	}
+
+	output.close();
+	Poco::File{outputPath_ + ":stream"}.remove();
+
+	log_success(MinerLogger::general, "Optimized the plot file %s\n"
+		"\tThe original plot files can be removed from the plot dirs now", outputPath_);
+
+	return true;
+}
+
+const std::string& Burst::PlotOptimizer::getOutputPath() const
+{
+	return outputPath_;
+}
+
+bool Burst::PlotOptimizer::prepare()
+{
+	inputs_.clear();
+	nonces_ = 0;
+
+	if (plotFiles_.empty())
+		return false;
+
+	for (const auto& plotFile : plotFiles_)
+	{
+		if (isValidPlotFile(plotFile) != PlotCheckResult::Ok)
+		{
+			log_error(MinerLogger::general, "The plot file %s is not valid and can not be optimized!", plotFile);
+			return false;
+		}
+
+		Input input;
+		input.path = plotFile;
+		input.nonceStart = std::stoull(getStartNonceFromPlotFile(plotFile));
+		input.nonces = std::stoull(getNonceCountFromPlotFile(plotFile));
+		input.staggerSize = std::stoull(getStaggerSizeFromPlotFile(plotFile));
+		input.poc2 = isPoc2PlotFile(plotFile);
+		inputs_.emplace_back(input);
+	}
+
+	std::sort(inputs_.begin(), inputs_.end(), [](const Input& lhs, const Input& rhs)
+	{
+		return lhs.nonceStart < rhs.nonceStart;
+	});
+
+	const auto account = getAccountIdFromPlotFile(inputs_.front().path);
+
+	for (size_t i = 0; i < inputs_.size(); ++i)
+	{
+		if (getAccountIdFromPlotFile(inputs_[i].path) != account)
+		{
+			log_error(MinerLogger::general, "The plot files %s and %s belong to different accounts and can not be merged!",
+				inputs_.front().path, inputs_[i].path);
+			return false;
+		}
+
+		if (i > 0 && inputs_[i - 1].nonceStart + inputs_[i - 1].nonces != inputs_[i].nonceStart)
+		{
+			log_error(MinerLogger::general, "The nonces of the plot files %s and %s are not consecutive and can not be merged!",
+				inputs_[i - 1].path, inputs_[i].path);
+			return false;
+		}
+
+		nonces_ += inputs_[i].nonces;
+	}
+
+	// PoC1 is only kept, if all plot files are PoC1
+	const auto& first = inputs_.front();
+	poc2_ = poc2_ || std::any_of(inputs_.begin(), inputs_.end(), [](const Input& input) { return input.poc2; });
+
+	if (outputDir_.empty())
+		outputDir_ = Poco::Path{first.path}.parent().toString();
+
+	auto name = account + "_" + std::to_string(first.nonceStart) + "_" + std::to_string(nonces_);
+
+	if (!poc2_)
+		name += "_" + std::to_string(nonces_);
+
+	outputPath_ = Poco::Path{outputDir_}.makeDirectory().setFileName(name).toString();
+
+	// a single plot file in the optimized layout is its own output
+	if (inputs_.size() == 1 && (first.poc2 || first.staggerSize == first.nonces) && first.poc2 == poc2_)
+	{
+		outputPath_ = first.path;
+		return true;
+	}
+
+	if (std::any_of(inputs_.begin(), inputs_.end(), [&](const Input& input) { return input.path == outputPath_; }))
+	{
+		log_error(MinerLogger::general, "The optimized plot file %s would overwrite one of its sources!", outputPath_);
+		return false;
+	}
+
+	return true;
+}
+
+bool Burst::PlotOptimizer::readWindow(const Window& window, char* buffer, const std::function<bool()>& pause,
+	const std::function<bool()>& cancel)
+{
+	const auto& input = *window.input;
+	const auto staggerSize = input.staggerSize;
+	const auto staggerScoopBytes = staggerSize * Settings::ScoopSize;
+	const auto windowScoopBytes = window.nonces * Settings::ScoopSize;
+
+	std::ifstream stream{input.path, std::ios::in | std::ios::binary};
+
+	if (!stream)
+	{
+		log_error(MinerLogger::general, "Could not open the plot file %s for reading!", input.path);
+		return false;
+	}
+
+	// the window is read stagger by stagger, the buffer has the scoop-major layout of the output file
+	for (auto nonce = window.inputNonce; nonce < window.inputNonce + window.nonces;)
+	{
+		while (pause() && !cancel())
+			Poco::Thread::sleep(100);
+
+		if (cancel())
+			return false;
+
+		const auto stagger = nonce / staggerSize;
+		const auto staggerOffset = nonce % staggerSize;
+		const auto nonces = std::min(staggerSize - staggerOffset, window.inputNonce + window.nonces - nonce);
+		const auto bufferOffset = (nonce - window.inputNonce) * Settings::ScoopSize;
+		const auto staggerBegin = stagger * staggerSize * Settings::PlotSize;
+
+		if (nonces == staggerSize && staggerSize * Settings::PlotSize <= 64 * 1024 * 1024)
+		{
+			// small staggers are read as a whole and scattered, instead of seeking for every scoop
+			staging_.resize(staggerSize * Settings::PlotSize);
+			stream.seekg(staggerBegin);
+			stream.read(staging_.data(), staging_.size());
+
+			for (size_t scoop = 0; stream && scoop < Settings::ScoopPerPlot; ++scoop)
+				std::copy_n(staging_.data() + scoop * staggerScoopBytes, staggerScoopBytes,
+					buffer + scoop * windowScoopBytes + bufferOffset);
+		}
+		else
+		{
+			for (size_t scoop = 0; stream && scoop < Settings::ScoopPerPlot; ++scoop)
+			{
+				stream.seekg(staggerBegin + scoop * staggerScoopBytes + staggerOffset * Settings::ScoopSize);
+				stream.read(buffer + scoop * windowScoopBytes + bufferOffset, nonces * Settings::ScoopSize);
+			}
+		}
+
+		if (!stream)
+		{
+			log_error(MinerLogger::general, "Could not read from the plot file %s!", input.path);
+			return false;
+		}
+
+		nonce += nonces;
+	}
+
+	return true;
+}
+
+void Burst::PlotOptimizer::convertWindow(const Window& window, char* buffer) const
+{
+	if (window.input->poc2 == poc2_)
+		return;
+
+	// PoC2 swaps the second hash of scoop n with the second hash of scoop 4095 - n
+	const auto windowScoopBytes = window.nonces * Settings::ScoopSize;
+
+	for (size_t scoop = 0; scoop < Settings::ScoopPerPlot / 2; ++scoop)
+	{
+		auto lower = buffer + scoop * windowScoopBytes + Settings::HashSize;
+		auto upper = buffer + (Settings::ScoopPerPlot - 1 - scoop) * windowScoopBytes + Settings::HashSize;
+
+		for (size_t nonce = 0; nonce < window.nonces; ++nonce)
+			std::swap_ranges(lower + nonce * Settings::ScoopSize, lower + nonce * Settings::ScoopSize + Settings::HashSize,
+				upper + nonce * Settings::ScoopSize);
+	}
+}
+
+bool Burst::PlotOptimizer::writeWindow(const Window& window, const char* buffer, std::ostream& output) const
+{
+	const auto windowScoopBytes = window.nonces * Settings::ScoopSize;
+	const auto scoopBytes = nonces_ * Settings::ScoopSize;
+
+	for (size_t scoop = 0; output && scoop < Settings::ScoopPerPlot; ++scoop)
+	{
+		output.seekp(scoop * scoopBytes + window.outputNonce * Settings::ScoopSize);
+		output.write(buffer + scoop * windowScoopBytes, windowScoopBytes);
+	}
+
+	output.flush();
+
+	if (!output)
+	{
+		log_error(MinerLogger::general, "Could not write to the plot file %s!", outputPath_);
+		return false;
+	}
+
+	return true;
+}
+
+bool Burst::PlotOptimizer::writeProgress(const Poco::UInt64 noncesWritten) const
+{
+	if (!writePlotFileProgress(outputPath_, noncesWritten))
+	{
+		log_error(MinerLogger::general, "Could not write the progress of the plot file %s!", outputPath_);
+		return false;
+	}
+
+	return true;
+}
+
+Poco::UInt64 Burst::PlotOptimizer::readProgress() const
+{
+	if (!Poco::File{outputPath_}.exists())
+		return 0;
+
+	Poco::UInt64 noncesWritten = 0;
+
+	// an existing plot file without progress is complete
+	if (!readPlotFileProgress(outputPath_, noncesWritten))
+		return Poco::File{outputPath_}.getSize() == nonces_ * Settings::PlotSize ? nonces_ : 0;
+
+	return noncesWritten;
+}
@@ -0,0 +1,96 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	/**
+	 * \brief Rewrites plot files into the optimized layout, where the whole file is one stagger
+	 * and the scoops of all nonces can be read with one seek per round.
+	 * Several plot files with consecutive nonces can be merged into one file and PoC1 files
+	 * can be converted into PoC2 files.
+	 * The progress is stored like the plotters do it (the nonces written in <file>:stream),
+	 * so an interrupted optimization is resumed with the next run.
+	 */
+	class PlotOptimizer
+	{
+	public:
+		/**
+		 * \brief Constructor.
+		 * \param plotFiles The plot files, that are optimized (and merged, if more than one).
+		 * \param outputDir The dir of the optimized plot file (if empty, the dir of the first plot file).
+		 * \param poc2 If true, the optimized plot file has the PoC2 format, otherwise only if one of the plot files has it.
+		 * \param memoryBytes The memory, that is used for the two buffers.
+		 */
+		PlotOptimizer(std::vector<std::string> plotFiles, std::string outputDir, bool poc2, Poco::UInt64 memoryBytes);
+
+		/**
+		 * \brief Optimizes the plot files.
+		 * \param pause While this returns true, the optimizer waits (e.g. while the miner processes a round).
+		 * \param cancel If this returns true, the optimizer stops. The progress is kept.
+		 * \return true, if the optimized plot file is complete.
+		 */
+		bool run(const std::function<bool()>& pause, const std::function<bool()>& cancel);
+
+		/**
+		 * \brief Returns the path of the optimized plot file.
+		 * \return The path (empty, if the plot files can not be optimized).
+		 */
+		const std::string& getOutputPath() const;
+
+	private:
+		struct Input
+		{
+			std::string path;
+			Poco::UInt64 nonceStart, nonces, staggerSize;
+			bool poc2;
+		};
+
+		struct Window
+		{
+			const Input* input;
+			// the first nonce, relative to the input file and to the output file
+			Poco::UInt64 inputNonce, outputNonce;
+			Poco::UInt64 nonces;
+		};
+
+		bool prepare();
+		bool readWindow(const Window& window, char* buffer, const std::function<bool()>& pause,
+			const std::function<bool()>& cancel);
+		void convertWindow(const Window& window, char* buffer) const;
+		bool writeWindow(const Window& window, const char* buffer, std::ostream& output) const;
+		bool writeProgress(Poco::UInt64 noncesWritten) const;
+		Poco::UInt64 readProgress() const;
+
+		std::vector<std::string> plotFiles_;
+		std::string outputDir_, outputPath_;
+		bool poc2_;
+		Poco::UInt64 windowNonces_, nonces_;
+		std::vector<Input> inputs_;
+		std::vector<char> staging_;
+	};
+}
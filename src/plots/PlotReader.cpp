@@ -20,17 +20,28 @@
 // ==========================================================================
 
 #include "PlotReader.hpp"
+#include "PlotThroughput.hpp"
 #include "MinerUtil.hpp"
 #include "logging/MinerLogger.hpp"
 #include "mining/MinerConfig.hpp"
 #include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
 #include "mining/Miner.hpp"
 #include <Poco/NotificationQueue.h>
 #include "PlotVerifier.hpp"
 #include <Poco/Timestamp.h>
 #include "logging/Output.hpp"
 #include "Plot.hpp"
+#include "PlotChecksums.hpp"
 #include "logging/Performance.hpp"
+#include "DirectFile.hpp"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 Burst::GlobalBufferSize Burst::PlotReader::globalBufferSize;
 
@@ -38,6 +49,7 @@ void Burst::GlobalBufferSize::setMax(Poco::UInt64 max)
 {
 	Poco::FastMutex::ScopedLock lock{ mutex_ };
 	max_ = max;
+	freed_.broadcast();
 }
 
 bool Burst::GlobalBufferSize::reserve(Poco::UInt64 size)
@@ -55,6 +67,24 @@ bool Burst::GlobalBufferSize::reserve(Poco::UInt64 size)
 	return true;
 }
 
+bool Burst::GlobalBufferSize::reserve(Poco::UInt64 size, long milliseconds)
+{
+	// unlimited memory
+	if (MinerConfig::getConfig().getMaxBufferSize() == 0)
+		return true;
+
+	Poco::FastMutex::ScopedLock lock{ mutex_ };
+
+	if (size_ + size > max_ && milliseconds > 0)
+		freed_.tryWait(mutex_, milliseconds);
+
+	if (size_ + size > max_)
+		return false;
+
+	size_ += size;
+	return true;
+}
+
 void Burst::GlobalBufferSize::free(Poco::UInt64 size)
 {
 	// unlimited memory
@@ -67,6 +97,7 @@ void Burst::GlobalBufferSize::free(Poco::UInt64 size)
 		size = size_;
 
 	size_ -= size;
+	freed_.broadcast();
 }
 
 Poco::UInt64 Burst::GlobalBufferSize::getSize() const
@@ -80,14 +111,79 @@ Poco::UInt64 Burst::GlobalBufferSize::getMax() const
 }
 
 Burst::PlotReader::PlotReader(MinerData& data, std::shared_ptr<Burst::PlotReadProgress> progress,
-	Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue)
-	: Task("PlotReader"), data_(data), progress_{progress}, verificationQueue_{&verificationQueue}, plotReadQueue_(&plotReadQueue)
+	VerificationScheduler& verificationScheduler, Poco::NotificationQueue& plotReadQueue)
+	: Task("PlotReader"), data_(data), progress_{progress}, verificationScheduler_{&verificationScheduler},
+	  verificationQueue_{verificationScheduler.registerReader()}, plotReadQueue_(&plotReadQueue)
 {
 	//scoopNum_ = miner_.getScoopNum();
 	//gensig_ = miner_.getGensig();
 	//plotList_ = &plotList;
 }
 
+Burst::PlotReader::~PlotReader() = default;
+
+Poco::UInt64 Burst::PlotReader::getChunkBytes(const PlotFile& plotFile)
+{
+	const auto maxBufferSize = MinerConfig::getConfig().getMaxBufferSize();
+
+	// unlimited buffer size
+	if (maxBufferSize == 0)
+		return plotFile.getStaggerScoopBytes();
+
+	return maxBufferSize / MinerConfig::getConfig().getBufferChunkCount();
+}
+
+Poco::UInt64 Burst::PlotReader::getNoncesPerChunk(const PlotFile& plotFile, const Poco::UInt64 chunkBytes)
+{
+	const auto noncesPerChunk = chunkBytes / Settings::ScoopSize;
+
+	if (MinerConfig::getConfig().isUsingCoalescedReads())
+		return noncesPerChunk;
+
+	return std::min(noncesPerChunk, plotFile.getStaggerSize());
+}
+
+Burst::PlotReadChunk Burst::PlotReader::getChunk(const PlotFile& plotFile, const Poco::UInt64 nonce,
+	const Poco::UInt64 noncesPerChunk, const Poco::UInt64 chunkBytes, const Poco::UInt64 scoopNum)
+{
+	PlotReadChunk chunk;
+	chunk.startNonce = nonce;
+	chunk.nonces = noncesPerChunk;
+
+	const auto staggerBegin = nonce / plotFile.getStaggerSize();
+
+	// the scoops of multiple whole staggers are read into one buffer (one verification for all of them)
+	if (nonce % plotFile.getStaggerSize() == 0 && plotFile.getStaggerCount() > staggerBegin)
+	{
+		const auto staggers = std::min(noncesPerChunk / plotFile.getStaggerSize(), plotFile.getStaggerCount() - staggerBegin);
+
+		if (staggers > 1)
+		{
+			chunk.nonces = staggers * plotFile.getStaggerSize();
+			chunk.offset = staggerBegin * plotFile.getStaggerBytes() + scoopNum * plotFile.getStaggerScoopBytes();
+			chunk.bytes = staggers * plotFile.getStaggerScoopBytes();
+			chunk.slices = staggers;
+			chunk.sliceStride = plotFile.getStaggerBytes();
+			return chunk;
+		}
+	}
+
+	const auto staggerEnd = (nonce + noncesPerChunk) / plotFile.getStaggerSize();
+
+	// a chunk never crosses the border of a stagger
+	if (staggerBegin != staggerEnd)
+		chunk.nonces = plotFile.getStaggerSize() - nonce % plotFile.getStaggerSize();
+
+	const auto chunkOffset = nonce % plotFile.getStaggerSize() * Settings::ScoopSize;
+	const auto staggerBlockOffset = staggerBegin * plotFile.getStaggerBytes();
+	const auto staggerScoopOffset = scoopNum * plotFile.getStaggerScoopBytes();
+
+	chunk.offset = staggerBlockOffset + staggerScoopOffset + chunkOffset;
+	chunk.bytes = std::min(chunk.nonces * Settings::ScoopSize, chunkBytes);
+
+	return chunk;
+}
+
 void Burst::PlotReader::runTask()
 {
 	while (!isCancelled())
@@ -109,6 +205,7 @@ void Burst::PlotReader::runTask()
 					continue;
 
 			Poco::Timestamp timeStartDir;
+			const auto pageCacheStart = TEST_PROBE ? getPageCacheSize() : 0;
 
 			// check, if the incoming plot-read-notification is for the current round
 			auto currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
@@ -120,14 +217,47 @@ void Burst::PlotReader::runTask()
 				for (const auto& relatedPlotFile : relatedPlotList.second)
 					plotList.emplace_back(relatedPlotFile);
 
+			// the io_uring engine reads all plot files of the list at once
+			const auto readAsync = !plotReadNotification->wakeUpCall && isUsingIoUring();
+			const auto fused = MinerConfig::getConfig().isUsingFusedVerification();
+
+			// the scoops of all plot files in the order of their address on the device
+			const auto readByExtents = !readAsync && !plotReadNotification->wakeUpCall &&
+				MinerConfig::getConfig().isUsingExtentOrder() &&
+				std::all_of(plotList.begin(), plotList.end(), [](const std::shared_ptr<PlotFile>& plotFile)
+				{
+					return !plotFile->getExtents().empty();
+				});
+
+			if (readAsync)
+				currentBlock = readPlotListAsync(*plotReadNotification);
+			else if (readByExtents)
+				currentBlock = readPlotListByExtents(*plotReadNotification);
+
 			for (auto plotFileIter = plotList.begin();
 				plotFileIter != plotList.end() &&
+				!readAsync &&
+				!readByExtents &&
 				!isCancelled() &&
 				currentBlock;
 				++plotFileIter)
 			{
 				auto& plotFile = **plotFileIter;
 				std::ifstream inputStream(plotFile.getPath(), std::ifstream::in | std::ifstream::binary);
+				std::unique_ptr<DirectFile> directFile;
+
+				// read around the page cache, the scoops of a round are never read again
+				if (MinerConfig::getConfig().isUsingDirectIo() && !plotReadNotification->wakeUpCall)
+				{
+					directFile = std::make_unique<DirectFile>(plotFile.getPath());
+
+					if (!directFile->isOpen())
+					{
+						log_debug(MinerLogger::plotReader, "Could not open %s for direct reading, using buffered reads",
+							plotFile.getPath());
+						directFile.reset();
+					}
+				}
 
 				START_PROBE_DOMAIN("PlotReader.ReadFile", plotFile.getPath())
 					Poco::Timestamp timeStartFile;
@@ -150,39 +280,25 @@ void Burst::PlotReader::runTask()
 						break;
 					}
 
-					const auto maxBufferSize = MinerConfig::getConfig().getMaxBufferSize();
-					auto chunkBytes = maxBufferSize / MinerConfig::getConfig().getBufferChunkCount();
-
-					// unlimited buffer size
-					if (maxBufferSize == 0)
-						chunkBytes = plotFile.getStaggerScoopBytes();
-
-					const auto noncesPerChunk = std::min(chunkBytes / Settings::ScoopSize, plotFile.getStaggerSize());
+					const auto chunkBytes = getChunkBytes(plotFile);
+					const auto noncesPerChunk = getNoncesPerChunk(plotFile, chunkBytes);
 
 					auto nonce = 0ull;
 
 					while (nonce < plotFile.getNonces() && currentBlock && !isCancelled())
 					{
 						START_PROBE_DOMAIN("PlotReader.Nonces", plotFile.getPath());
-						auto startNonce = nonce;
-						auto readNonces = noncesPerChunk;
-						auto staggerBegin = startNonce / plotFile.getStaggerSize();
-						auto staggerEnd = (startNonce + readNonces) / plotFile.getStaggerSize();
-
-						if (staggerBegin != staggerEnd)
-							readNonces = plotFile.getStaggerSize() - startNonce % plotFile.getStaggerSize();
+						const auto chunk = getChunk(plotFile, nonce, noncesPerChunk, chunkBytes, plotReadNotification->scoopNum);
+						auto startNonce = chunk.startNonce;
+						auto readNonces = chunk.nonces;
 
 						auto memoryAcquired = false;
-						auto memoryToAcquire = std::min(readNonces * Settings::ScoopSize, chunkBytes);
+						auto memoryToAcquire = chunk.bytes;
 
 						START_PROBE_DOMAIN("PlotReader.AllocMemory", plotFile.getPath());
+						// wait until a verifier gives its buffer back
 						while (!isCancelled() && !memoryAcquired)
-						{
-							memoryAcquired = globalBufferSize.reserve(memoryToAcquire);
-
-							if (!memoryAcquired)
-								std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
-						}
+							memoryAcquired = globalBufferSize.reserve(memoryToAcquire, 100);
 						TAKE_PROBE_DOMAIN("PlotReader.AllocMemory", plotFile.getPath());
 
 						// if the reader is cancelled, jump out of the loop
@@ -198,12 +314,8 @@ void Burst::PlotReader::runTask()
 						if (memoryAcquired && currentBlock)
 						{
 							START_PROBE_DOMAIN("PlotReader.PushWork", plotFile.getPath());
-							const auto chunkOffset = startNonce % plotFile.getStaggerSize() * Settings::ScoopSize;
-							const auto staggerBlockOffset = staggerBegin * plotFile.getStaggerBytes();
-							const auto staggerScoopOffset = plotReadNotification->scoopNum * plotFile.getStaggerScoopBytes();
-
 							START_PROBE("PlotReader.CreateVerification");
-							VerifyNotification::Ptr verification(new VerifyNotification{});
+							auto verification = VerifyNotificationPool::instance().acquire();
 							verification->accountId = plotFile.getAccountId();
 							verification->nonceStart = plotFile.getNonceStart();
 							verification->block = plotReadNotification->blockheight;
@@ -212,6 +324,7 @@ void Burst::PlotReader::runTask()
 							verification->nonceRead = startNonce;
 							verification->baseTarget = plotReadNotification->baseTarget;
 							verification->memorySize = memoryToAcquire;
+							verification->threshold = data_.getDeadlineThreshold(verification->block, verification->accountId);
 
 							memoryAcquired = false;
 
@@ -231,17 +344,22 @@ void Burst::PlotReader::runTask()
 									throw;
 								}
 
+								// wait for a verifier to give back its buffer
 								if (!memoryAcquired)
-									std::this_thread::sleep_for(std::chrono::milliseconds{10});
+									VerifyNotificationPool::instance().waitForRelease(100);
 							}
 							TAKE_PROBE("PlotReader.CreateVerification");
 
-							START_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
-							inputStream.seekg(staggerBlockOffset + staggerScoopOffset + chunkOffset);
-							inputStream.read(reinterpret_cast<char*>(&verification->buffer[0]), memoryToAcquire);
-							TAKE_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
-
-							verificationQueue_->enqueueNotification(verification);
+							// a corrupted chunk is skipped, its deadlines would be wrong anyway
+							if (!readChunk(plotFile, chunk, plotReadNotification->scoopNum, plotReadNotification->blockheight,
+								inputStream, directFile, verification->buffer.data()))
+							{
+								VerifyNotificationPool::instance().release(verification);
+								globalBufferSize.free(memoryToAcquire);
+							}
+							// on fast drives the reader verifies the chunk itself, while the scoops are in its cache
+							else if (!fused || !verificationScheduler_->verifyFused(verification, [this]() { return isCancelled(); }))
+								verificationScheduler_->enqueue(verification, verificationQueue_);
 
 							if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
 								progress_->add(readNonces * Settings::PlotSize, plotReadNotification->blockheight);
@@ -267,38 +385,8 @@ void Burst::PlotReader::runTask()
 				currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
 
 				if (!isCancelled() && currentBlock)
-				{
-					auto fileReadDiff = timeStartFile.elapsed();
-					auto fileReadDiffSeconds = static_cast<float>(fileReadDiff) / 1000 / 1000;
-					Poco::Timespan span{ fileReadDiff };
-
-					auto plotListSize = plotReadNotification->plotList.size();
-
-					if (plotListSize > 0)
-					{
-						data_.getBlockData()->setProgress(
-							plotReadNotification->dir,
-							static_cast<float>(std::distance(plotReadNotification->plotList.begin(), plotFileIter) + 1) / plotListSize * 100.f,
-							plotReadNotification->blockheight
-						);
-					}
-
-					const auto nonceBytes = static_cast<double>(plotFile.getNonces() * Settings::ScoopSize);
-					const auto bytesPerSeconds = nonceBytes / fileReadDiffSeconds;
-
-					log_information_if(MinerLogger::plotReader, MinerLogger::hasOutput(PlotDone), "%s (%s) read in %ss (~%s/s)",
-						plotFile.getPath(),
-						memToString(plotFile.getSize(), 2),
-						Poco::DateTimeFormatter::format(span, "%s.%i"),
-						memToString(static_cast<Poco::UInt64>(bytesPerSeconds), 2));
-
-					if (!MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
-					{
-						START_PROBE("PlotReader.Progress")
-							progress_->add(plotFile.getSize(), plotReadNotification->blockheight);
-						TAKE_PROBE("PlotReader.Progress")
-					}
-				}
+					plotFileRead(*plotReadNotification, plotFile,
+						std::distance(plotReadNotification->plotList.begin(), plotFileIter) + 1, timeStartFile);
 
 				// if it was cancelled, we push the current plot dir back in the queue again
 				if (isCancelled())
@@ -310,7 +398,9 @@ void Burst::PlotReader::runTask()
 			if (plotReadNotification->wakeUpCall)
 				continue;
 
-			data_.getBlockData()->setProgress(plotReadNotification->dir, 100.f, plotReadNotification->blockheight);
+			// the progress of the dirs is set for every plot file, the notification is a device
+			if (plotReadNotification->dirProgress == nullptr)
+				data_.getBlockData()->setProgress(plotReadNotification->dir, 100.f, plotReadNotification->blockheight);
 
 			auto dirReadDiff = timeStartDir.elapsed();
 			auto dirReadDiffSeconds = static_cast<float>(dirReadDiff) / 1000 / 1000;
@@ -321,6 +411,11 @@ void Burst::PlotReader::runTask()
 			for (const auto& plot : plotReadNotification->plotList)
 				totalSizeBytes += plot->getSize();
 
+			// only complete reads are a valid measurement for the round scheduling
+			if (totalSizeBytes > 0 && currentBlock && !isCancelled())
+				PlotThroughput::add(plotReadNotification->dir, totalSizeBytes / Settings::PlotSize * Settings::ScoopSize,
+					dirReadDiffSeconds);
+
 			if (plotReadNotification->type == PlotDir::Type::Sequential && totalSizeBytes > 0 && currentBlock)
 			{
 				const auto sumNonces = totalSizeBytes / Settings::PlotSize;
@@ -335,8 +430,9 @@ void Burst::PlotReader::runTask()
 					sstr << " + " << relatedPlotList.first;
 
 				log_information_if(MinerLogger::plotReader, MinerLogger::hasOutput(DirDone),
-					"Dir %s read in %ss (~%s/s)\n"
+					"%s %s read in %ss (~%s/s)\n"
 					"\t%z %s (%s)",
+					std::string(plotReadNotification->dirProgress == nullptr ? "Dir" : "Device"),
 					sstr.str(),
 					Poco::DateTimeFormatter::format(span, "%s.%i"),
 					memToString(static_cast<Poco::UInt64>(bytesPerSecond), 2),
@@ -346,6 +442,15 @@ void Burst::PlotReader::runTask()
 			}
 
 			TAKE_PROBE_DOMAIN("PlotReader.ReadDir", plotReadNotification->dir)
+
+			// the growth of the page cache while reading the dir (other processes may influence it)
+			if (TEST_PROBE)
+			{
+				const auto pageCacheEnd = getPageCacheSize();
+
+				if (pageCacheEnd > pageCacheStart)
+					ADD_PROBE_VALUE_DOMAIN("PlotReader.PageCacheGrowth", plotReadNotification->dir, pageCacheEnd - pageCacheStart);
+			}
 		}
 		catch (Poco::Exception& exc)
 		{
@@ -360,6 +465,733 @@ void Burst::PlotReader::runTask()
 	}
 }
 
+bool Burst::PlotReader::readChunk(const PlotFile& plotFile, const PlotReadChunk& chunk, const Poco::UInt64 scoopNum,
+	const Poco::UInt64 blockheight, std::ifstream& stream, std::unique_ptr<DirectFile>& directFile, ScoopData* buffer)
+{
+	const auto readSlices = [&](const PlotReadChunk& slicedChunk, char* target)
+	{
+		const auto sliceBytes = slicedChunk.bytes / slicedChunk.slices;
+
+		if (directFile != nullptr)
+		{
+			START_PROBE_DOMAIN("PlotReader.DirectRead", plotFile.getPath());
+			auto directRead = true;
+
+			for (auto slice = 0ull; slice < slicedChunk.slices && directRead; ++slice)
+				directRead = directFile->read(target + slice * sliceBytes,
+					slicedChunk.offset + slice * slicedChunk.sliceStride, sliceBytes);
+
+			TAKE_PROBE_DOMAIN("PlotReader.DirectRead", plotFile.getPath());
+
+			// the filesystem accepted O_DIRECT on open, but refuses the reads
+			if (!directRead && directFile->getLastError() == EINVAL)
+			{
+				log_debug(MinerLogger::plotReader, "Direct reading of %s failed, using buffered reads",
+					plotFile.getPath());
+				directFile.reset();
+			}
+			// a short read (e.g. a truncated file) or an I/O error, the buffer is incomplete
+			else if (!directRead)
+			{
+				log_error(MinerLogger::plotReader, "Could not read %z bytes at offset %Lu of %s, skipping the chunk\n"
+					"\tReason: %s", static_cast<size_t>(slicedChunk.bytes), slicedChunk.offset, plotFile.getPath(),
+					directFile->getLastError() == 0 ? std::string("end of file") :
+					std::string(std::strerror(directFile->getLastError())));
+				return false;
+			}
+			else
+				ADD_PROBE_VALUE_DOMAIN("PlotReader.DirectRead", plotFile.getPath(), slicedChunk.bytes);
+		}
+
+		if (directFile == nullptr)
+		{
+			START_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
+
+			for (auto slice = 0ull; slice < slicedChunk.slices; ++slice)
+			{
+				stream.seekg(slicedChunk.offset + slice * slicedChunk.sliceStride);
+				stream.read(target + slice * sliceBytes, sliceBytes);
+
+				// a short read leaves stale scoops of an older chunk in the (pooled) buffer
+				if (!stream || static_cast<Poco::UInt64>(stream.gcount()) != sliceBytes)
+				{
+					// without clearing, every following read of this file would fail too
+					stream.clear();
+					TAKE_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
+					log_error(MinerLogger::plotReader, "Could not read %z bytes at offset %Lu of %s, skipping the chunk",
+						static_cast<size_t>(sliceBytes), slicedChunk.offset + slice * slicedChunk.sliceStride,
+						plotFile.getPath());
+					return false;
+				}
+			}
+
+			TAKE_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
+			ADD_PROBE_VALUE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath(), slicedChunk.bytes);
+		}
+
+		return true;
+	};
+
+	if (!readSlices(chunk, reinterpret_cast<char*>(buffer)))
+		return false;
+
+	auto valid = verifyChecksums(plotFile, chunk, scoopNum, reinterpret_cast<const char*>(buffer));
+
+	// the plot file has the other format than the block, the second hashes are in the mirrored scoop
+	if (plotFile.isPoc2() != MinerConfig::getConfig().isPoc2Block(blockheight))
+	{
+		const auto nonces = chunk.bytes / Settings::ScoopSize;
+		const auto mirrorChunk = getMirrorChunk(plotFile, chunk, scoopNum);
+
+		if (mirrorBuffer_.size() < nonces)
+			mirrorBuffer_.resize(nonces);
+
+		if (!readSlices(mirrorChunk, reinterpret_cast<char*>(mirrorBuffer_.data())))
+			return false;
+
+		valid = verifyChecksums(plotFile, mirrorChunk, Settings::ScoopPerPlot - 1 - scoopNum,
+			reinterpret_cast<const char*>(mirrorBuffer_.data())) && valid;
+		mergeMirroredHalves(buffer, mirrorBuffer_.data(), nonces);
+	}
+
+	return valid;
+}
+
+Burst::PlotReadChunk Burst::PlotReader::getMirrorChunk(const PlotFile& plotFile, const PlotReadChunk& chunk,
+	const Poco::UInt64 scoopNum)
+{
+	auto mirrorChunk = chunk;
+	mirrorChunk.offset = chunk.offset - scoopNum * plotFile.getStaggerScoopBytes() +
+		(Settings::ScoopPerPlot - 1 - scoopNum) * plotFile.getStaggerScoopBytes();
+	return mirrorChunk;
+}
+
+void Burst::PlotReader::mergeMirroredHalves(ScoopData* scoops, const ScoopData* mirrorScoops, const Poco::UInt64 nonces)
+{
+	const auto halfScoop = Settings::ScoopSize / 2;
+
+	for (auto i = 0ull; i < nonces; ++i)
+		memcpy(scoops[i].data() + halfScoop, mirrorScoops[i].data() + halfScoop, halfScoop);
+}
+
+bool Burst::PlotReader::verifyChecksums(const PlotFile& plotFile, const PlotReadChunk& chunk, const Poco::UInt64 scoopNum,
+	const char* data)
+{
+	const auto& checksums = plotFile.getChecksums();
+
+	if (checksums == nullptr || !MinerConfig::getConfig().isVerifyingChecksums())
+		return true;
+
+	// every slice is inside of another stagger
+	const auto sliceNonces = chunk.bytes / chunk.slices / Settings::ScoopSize;
+
+	for (auto slice = 0ull; slice < chunk.slices; ++slice)
+	{
+		const auto nonce = chunk.startNonce + slice * sliceNonces;
+
+		if (!checksums->verify(scoopNum, nonce, sliceNonces, data + slice * sliceNonces * Settings::ScoopSize))
+		{
+			log_warning(MinerLogger::plotReader, "The plot file %s is corrupted (scoop %s, nonces %s - %s), "
+				"the chunk is skipped!", plotFile.getPath(), std::to_string(scoopNum),
+				std::to_string(plotFile.getNonceStart() + nonce),
+				std::to_string(plotFile.getNonceStart() + nonce + sliceNonces - 1));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Burst::PlotReader::isUsingIoUring()
+{
+	if (MinerConfig::getConfig().getPlotReaderEngine() != PlotReaderEngine::IoUring)
+		return false;
+
+	if (ring_ == nullptr)
+	{
+		ring_ = std::make_unique<IoUring>(MinerConfig::getConfig().getIoQueueDepth());
+
+		if (ring_->isAvailable())
+			log_debug(MinerLogger::plotReader, "Plot reader uses io_uring with a queue depth of %u", ring_->getQueueDepth());
+		else
+			log_warning(MinerLogger::plotReader, "The reader engine io_uring is not supported by your system!\n"
+				"As a fallback solution the stream engine is used.");
+	}
+
+	return ring_->isAvailable();
+}
+
+bool Burst::PlotReader::readPlotListAsync(PlotReadNotification& notification)
+{
+	auto currentBlock = notification.blockheight == data_.getCurrentBlockheight();
+
+#ifdef __linux__
+	struct AsyncPlotFile
+	{
+		PlotFile* plotFile = nullptr;
+		int fd = -1;
+		Poco::UInt64 nonce = 0, chunkBytes = 0, noncesPerChunk = 0;
+		unsigned inFlight = 0;
+		bool finished = false;
+		// the plot file has the other PoC format than the block
+		bool mirror = false;
+		Poco::Timestamp timeStart;
+	};
+
+	struct AsyncRead
+	{
+		AsyncPlotFile* file = nullptr;
+		VerifyNotification::Ptr verification;
+		PlotReadChunk chunk, mirrorChunk;
+		// only the scoop buffer is used, it is recycled by the pool like the one of the verification
+		VerifyNotification::Ptr mirror;
+		Poco::UInt64 slicesPending = 0;
+		bool failed = false;
+	};
+
+	// every slice of a chunk is a request of its own, they are all submitted at once
+	struct AsyncSlice
+	{
+		AsyncRead* read = nullptr;
+		Poco::UInt64 slice = 0;
+		Poco::UInt64 bytesRead = 0;
+		bool mirror = false;
+	};
+
+	auto& ring = *ring_;
+	const auto fused = MinerConfig::getConfig().isUsingFusedVerification();
+	std::vector<AsyncPlotFile> files(notification.plotList.size());
+	size_t nextFile = 0, filesRead = 0;
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		auto& file = files[i];
+		file.plotFile = notification.plotList[i].get();
+		file.fd = open(file.plotFile->getPath().c_str(), O_RDONLY);
+		file.chunkBytes = getChunkBytes(*file.plotFile);
+		file.noncesPerChunk = getNoncesPerChunk(*file.plotFile, file.chunkBytes);
+		file.mirror = file.plotFile->isPoc2() != MinerConfig::getConfig().isPoc2Block(notification.blockheight);
+
+		// all slices of a coalesced chunk (and their mirrored slices) need to fit into the ring
+		file.noncesPerChunk = std::min(file.noncesPerChunk,
+			std::max<Poco::UInt64>(ring.getQueueDepth() / (file.mirror ? 2 : 1), 1) * file.plotFile->getStaggerSize());
+
+		// files, that can not be opened, are skipped
+		if (file.fd < 0)
+			file.nonce = file.plotFile->getNonces();
+	}
+
+	// the ring is filled file by file, so at least the files are read in the order of their address on the device
+	if (MinerConfig::getConfig().isUsingExtentOrder())
+		std::stable_sort(files.begin(), files.end(), [](const AsyncPlotFile& lhs, const AsyncPlotFile& rhs)
+		{
+			return lhs.plotFile->getPhysicalOffset(0) < rhs.plotFile->getPhysicalOffset(0);
+		});
+
+	const auto isFileDone = [](const AsyncPlotFile& file)
+	{
+		return !file.finished && file.nonce >= file.plotFile->getNonces() && file.inFlight == 0;
+	};
+
+	const auto finishFile = [&](AsyncPlotFile& file)
+	{
+		++filesRead;
+		file.finished = true;
+
+		if (file.fd >= 0)
+		{
+			close(file.fd);
+			file.fd = -1;
+		}
+
+		if (!isCancelled() && currentBlock)
+			plotFileRead(notification, *file.plotFile, filesRead, file.timeStart);
+	};
+
+	// the buffers of a mirrored chunk are reserved together
+	const auto getReadMemory = [](const AsyncRead& read)
+	{
+		return read.chunk.bytes * (read.mirror.isNull() ? 1 : 2);
+	};
+
+	const auto releaseRead = [&getReadMemory](AsyncRead& read)
+	{
+		VerifyNotificationPool::instance().release(read.verification);
+
+		if (!read.mirror.isNull())
+			VerifyNotificationPool::instance().release(read.mirror);
+
+		globalBufferSize.free(getReadMemory(read));
+	};
+
+	const auto submitSlice = [&ring](AsyncSlice* slice)
+	{
+		auto& read = *slice->read;
+		const auto& chunk = slice->mirror ? read.mirrorChunk : read.chunk;
+		const auto sliceBytes = chunk.bytes / chunk.slices;
+		auto buffer = reinterpret_cast<char*>(slice->mirror ? read.mirror->buffer.data() : read.verification->buffer.data()) +
+			slice->slice * sliceBytes + slice->bytesRead;
+		return ring.read(read.file->fd, buffer, sliceBytes - slice->bytesRead,
+			chunk.offset + slice->slice * chunk.sliceStride + slice->bytesRead, slice);
+	};
+
+	while (!isCancelled() && currentBlock)
+	{
+		currentBlock = notification.blockheight == data_.getCurrentBlockheight();
+
+		START_PROBE_DOMAIN("PlotReader.Uring.Submit", notification.dir);
+		// fill the ring with reads of the plot files in list order
+		while (ring.getPending() < ring.getQueueDepth() && nextFile < files.size() && !isCancelled())
+		{
+			auto& file = files[nextFile];
+
+			if (file.nonce >= file.plotFile->getNonces())
+			{
+				if (isFileDone(file))
+					finishFile(file);
+
+				++nextFile;
+				continue;
+			}
+
+			const auto chunk = getChunk(*file.plotFile, file.nonce, file.noncesPerChunk, file.chunkBytes,
+				notification.scoopNum);
+
+			const auto requests = chunk.slices * (file.mirror ? 2 : 1);
+
+			// not enough room in the ring for all slices of the chunk
+			if (ring.getPending() + requests > ring.getQueueDepth())
+				break;
+
+			// no free memory, so wait for a running read or for the verifiers
+			if (!globalBufferSize.reserve(chunk.bytes * (file.mirror ? 2 : 1), ring.getPending() == 0 ? 100 : 0))
+				break;
+
+			auto read = std::make_unique<AsyncRead>();
+			read->file = &file;
+			read->chunk = chunk;
+			read->verification = VerifyNotificationPool::instance().acquire();
+
+			if (file.mirror)
+			{
+				read->mirrorChunk = getMirrorChunk(*file.plotFile, chunk, notification.scoopNum);
+				read->mirror = VerifyNotificationPool::instance().acquire();
+			}
+
+			read->verification->accountId = file.plotFile->getAccountId();
+			read->verification->nonceStart = file.plotFile->getNonceStart();
+			read->verification->block = notification.blockheight;
+			read->verification->inputPath = file.plotFile->getPath();
+			read->verification->gensig = notification.gensig;
+			read->verification->nonceRead = chunk.startNonce;
+			read->verification->baseTarget = notification.baseTarget;
+			read->verification->memorySize = chunk.bytes;
+			read->verification->threshold = data_.getDeadlineThreshold(notification.blockheight,
+				read->verification->accountId);
+
+			try
+			{
+				read->verification->buffer.resize(chunk.nonces);
+
+				if (file.mirror)
+					read->mirror->buffer.resize(chunk.nonces);
+			}
+			catch (std::bad_alloc&)
+			{
+				// try it again, when a running read is done
+				releaseRead(*read);
+
+				if (ring.getPending() == 0)
+					VerifyNotificationPool::instance().waitForRelease(100);
+
+				break;
+			}
+
+			auto submitted = 0ull;
+
+			for (; submitted < requests; ++submitted)
+			{
+				auto slice = std::make_unique<AsyncSlice>();
+				slice->read = read.get();
+				slice->slice = submitted % chunk.slices;
+				slice->mirror = submitted >= chunk.slices;
+
+				if (!submitSlice(slice.get()))
+					break;
+
+				slice.release();
+			}
+
+			if (submitted == 0)
+			{
+				releaseRead(*read);
+				break;
+			}
+
+			// the chunk is incomplete, it is given free, when the submitted slices are done
+			// and read again with the next fill of the ring
+			const auto incomplete = submitted < requests;
+			read->slicesPending = submitted;
+			read->failed = incomplete;
+			read.release();
+			++file.inFlight;
+
+			if (incomplete)
+			{
+				log_debug(MinerLogger::plotReader, "Could only submit %s of %s reads for plot file %s, reading the chunk again",
+					std::to_string(submitted), std::to_string(requests), file.plotFile->getPath());
+				break;
+			}
+
+			file.nonce += chunk.nonces;
+		}
+
+		ring.submit();
+		TAKE_PROBE_DOMAIN("PlotReader.Uring.Submit", notification.dir);
+
+		// everything is read
+		if (ring.getPending() == 0 && nextFile >= files.size())
+			break;
+
+		IoUring::Completion completion;
+
+		START_PROBE_DOMAIN("PlotReader.Uring.Wait", notification.dir);
+		const auto completed = ring.wait(completion, true);
+		TAKE_PROBE_DOMAIN("PlotReader.Uring.Wait", notification.dir);
+
+		if (!completed)
+			continue;
+
+		std::unique_ptr<AsyncSlice> slice{static_cast<AsyncSlice*>(completion.userData)};
+		auto& file = *slice->read->file;
+
+		const auto& sliceChunk = slice->mirror ? slice->read->mirrorChunk : slice->read->chunk;
+		const auto sliceBytes = sliceChunk.bytes / sliceChunk.slices;
+
+		if (completion.result > 0)
+			slice->bytesRead += completion.result;
+
+		// a short read, we need to read the rest
+		if (completion.result > 0 && slice->bytesRead < sliceBytes && submitSlice(slice.get()))
+		{
+			slice.release();
+			continue;
+		}
+
+		if (completion.result < 0)
+		{
+			log_error(MinerLogger::plotReader, "Could not read from plot file %s!\n\tReason: %s",
+				file.plotFile->getPath(), std::string(strerror(static_cast<int>(-completion.result))));
+			slice->read->failed = true;
+		}
+		// the end of the file (truncated plot file) or the rest of a short read could not be submitted,
+		// the buffer still holds the scoops of an earlier chunk
+		else if (slice->bytesRead < sliceBytes)
+		{
+			log_error(MinerLogger::plotReader, "Could not read from plot file %s!\n\tReason: only %s of %s bytes read",
+				file.plotFile->getPath(), std::to_string(slice->bytesRead), std::to_string(sliceBytes));
+			slice->read->failed = true;
+		}
+
+		// the other slices of the chunk are still in flight
+		if (--slice->read->slicesPending > 0)
+			continue;
+
+		std::unique_ptr<AsyncRead> read{slice->read};
+		--file.inFlight;
+
+		// a corrupted chunk is skipped, its deadlines would be wrong anyway
+		const auto corrupted = !read->failed &&
+			(!verifyChecksums(*file.plotFile, read->chunk, notification.scoopNum,
+				reinterpret_cast<const char*>(read->verification->buffer.data())) ||
+			(file.mirror && !verifyChecksums(*file.plotFile, read->mirrorChunk,
+				Settings::ScoopPerPlot - 1 - notification.scoopNum, reinterpret_cast<const char*>(read->mirror->buffer.data()))));
+
+		if (read->failed || corrupted)
+			releaseRead(*read);
+		else
+		{
+			// the verifier only gives back the memory of the verification
+			if (file.mirror)
+			{
+				mergeMirroredHalves(read->verification->buffer.data(), read->mirror->buffer.data(),
+					read->chunk.bytes / Settings::ScoopSize);
+				VerifyNotificationPool::instance().release(read->mirror);
+				globalBufferSize.free(read->chunk.bytes);
+			}
+
+			// the next reads are still in flight, while the reader verifies this chunk (double buffering)
+			if (!fused || !verificationScheduler_->verifyFused(read->verification, [this]() { return isCancelled(); }))
+				verificationScheduler_->enqueue(read->verification, verificationQueue_);
+
+			ADD_PROBE_VALUE_DOMAIN("PlotReader.Uring.Wait", notification.dir, read->chunk.bytes);
+
+			if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
+				progress_->add(read->chunk.nonces * Settings::PlotSize, notification.blockheight);
+		}
+
+		currentBlock = notification.blockheight == data_.getCurrentBlockheight();
+
+		if (isFileDone(file))
+			finishFile(file);
+	}
+
+	// the kernel still owns the buffers of all running reads
+	IoUring::Completion completion;
+
+	while (ring.getPending() > 0)
+	{
+		ring.submit();
+
+		if (!ring.wait(completion, true))
+			break;
+
+		std::unique_ptr<AsyncSlice> slice{static_cast<AsyncSlice*>(completion.userData)};
+
+		if (--slice->read->slicesPending > 0)
+			continue;
+
+		std::unique_ptr<AsyncRead> read{slice->read};
+		releaseRead(*read);
+	}
+
+	for (auto& file : files)
+		if (file.fd >= 0)
+			close(file.fd);
+
+	// if it was cancelled, we push the current plot dir back in the queue again
+	if (isCancelled())
+		plotReadQueue_->enqueueNotification(PlotReadNotification::Ptr{&notification, true});
+#endif
+
+	return currentBlock;
+}
+
+bool Burst::PlotReader::readPlotListByExtents(PlotReadNotification& notification)
+{
+	struct ExtentPlotFile
+	{
+		PlotFile* plotFile = nullptr;
+		std::ifstream stream;
+		std::unique_ptr<DirectFile> directFile;
+		size_t chunks = 0;
+		Poco::Timestamp timeStart;
+	};
+
+	struct ExtentRead
+	{
+		ExtentPlotFile* file;
+		PlotReadChunk chunk;
+		Poco::UInt64 physical;
+	};
+
+	auto currentBlock = notification.blockheight == data_.getCurrentBlockheight();
+	const auto fused = MinerConfig::getConfig().isUsingFusedVerification();
+	std::vector<ExtentPlotFile> files(notification.plotList.size());
+	std::vector<ExtentRead> reads;
+	size_t filesRead = 0;
+
+	const auto finishFile = [&](ExtentPlotFile& file)
+	{
+		++filesRead;
+		file.stream.close();
+		file.directFile.reset();
+
+		if (!isCancelled() && currentBlock)
+			plotFileRead(notification, *file.plotFile, filesRead, file.timeStart);
+	};
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		auto& file = files[i];
+		file.plotFile = notification.plotList[i].get();
+		file.stream.open(file.plotFile->getPath(), std::ifstream::in | std::ifstream::binary);
+
+		// files, that can not be opened, are skipped
+		if (!file.stream.is_open())
+			continue;
+
+		// read around the page cache, the scoops of a round are never read again
+		if (MinerConfig::getConfig().isUsingDirectIo())
+		{
+			file.directFile = std::make_unique<DirectFile>(file.plotFile->getPath());
+
+			if (!file.directFile->isOpen())
+				file.directFile.reset();
+		}
+
+		const auto chunkBytes = getChunkBytes(*file.plotFile);
+		const auto noncesPerChunk = getNoncesPerChunk(*file.plotFile, chunkBytes);
+
+		for (auto nonce = 0ull; nonce < file.plotFile->getNonces(); ++file.chunks)
+		{
+			const auto chunk = getChunk(*file.plotFile, nonce, noncesPerChunk, chunkBytes, notification.scoopNum);
+			reads.push_back({&file, chunk, file.plotFile->getPhysicalOffset(chunk.offset)});
+			nonce += chunk.nonces;
+		}
+	}
+
+	for (auto& file : files)
+		if (file.chunks == 0)
+			finishFile(file);
+
+	// one sweep over the device
+	std::stable_sort(reads.begin(), reads.end(), [](const ExtentRead& lhs, const ExtentRead& rhs)
+	{
+		return lhs.physical < rhs.physical;
+	});
+
+	for (auto readIter = reads.begin(); readIter != reads.end() && !isCancelled() && currentBlock; ++readIter)
+	{
+		auto& read = *readIter;
+		auto& file = *read.file;
+
+		START_PROBE_DOMAIN("PlotReader.ExtentRead", notification.dir);
+		auto memoryAcquired = false;
+
+		// wait until a verifier gives its buffer back
+		while (!isCancelled() && !memoryAcquired)
+			memoryAcquired = globalBufferSize.reserve(read.chunk.bytes, 100);
+
+		if (!memoryAcquired)
+			break;
+
+		auto verification = VerifyNotificationPool::instance().acquire();
+		verification->accountId = file.plotFile->getAccountId();
+		verification->nonceStart = file.plotFile->getNonceStart();
+		verification->block = notification.blockheight;
+		verification->inputPath = file.plotFile->getPath();
+		verification->gensig = notification.gensig;
+		verification->nonceRead = read.chunk.startNonce;
+		verification->baseTarget = notification.baseTarget;
+		verification->memorySize = read.chunk.bytes;
+		verification->threshold = data_.getDeadlineThreshold(notification.blockheight, verification->accountId);
+
+		memoryAcquired = false;
+
+		while (!memoryAcquired && !isCancelled())
+		{
+			try
+			{
+				verification->buffer.resize(read.chunk.nonces);
+				memoryAcquired = true;
+			}
+			catch (std::bad_alloc&)
+			{
+			}
+			catch (...)
+			{
+				globalBufferSize.free(read.chunk.bytes);
+				throw;
+			}
+
+			// wait for a verifier to give back its buffer
+			if (!memoryAcquired)
+				VerifyNotificationPool::instance().waitForRelease(100);
+		}
+
+		if (!memoryAcquired)
+		{
+			VerifyNotificationPool::instance().release(verification);
+			globalBufferSize.free(read.chunk.bytes);
+			break;
+		}
+
+		// a corrupted chunk is skipped, its deadlines would be wrong anyway
+		if (!readChunk(*file.plotFile, read.chunk, notification.scoopNum, notification.blockheight, file.stream,
+			file.directFile, verification->buffer.data()))
+		{
+			VerifyNotificationPool::instance().release(verification);
+			globalBufferSize.free(read.chunk.bytes);
+		}
+		else if (!fused || !verificationScheduler_->verifyFused(verification, [this]() { return isCancelled(); }))
+			verificationScheduler_->enqueue(verification, verificationQueue_);
+
+		if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
+			progress_->add(read.chunk.nonces * Settings::PlotSize, notification.blockheight);
+
+		ADD_PROBE_VALUE_DOMAIN("PlotReader.ExtentRead", notification.dir, read.chunk.bytes);
+		TAKE_PROBE_DOMAIN("PlotReader.ExtentRead", notification.dir);
+
+		currentBlock = notification.blockheight == data_.getCurrentBlockheight();
+
+		if (--file.chunks == 0)
+			finishFile(file);
+	}
+
+	// if it was cancelled, we push the current plot dir back in the queue again
+	if (isCancelled())
+		plotReadQueue_->enqueueNotification(PlotReadNotification::Ptr{&notification, true});
+
+	return currentBlock;
+}
+
+void Burst::PlotReader::plotFileRead(const PlotReadNotification& notification, const PlotFile& plotFile,
+	const size_t filesRead, const Poco::Timestamp& timeStart)
+{
+	auto fileReadDiff = timeStart.elapsed();
+	auto fileReadDiffSeconds = static_cast<float>(fileReadDiff) / 1000 / 1000;
+	Poco::Timespan span{ fileReadDiff };
+
+	auto plotListSize = notification.plotList.size();
+
+	// the plot files of the dir are spread over many notifications (one per device and reader)
+	if (notification.dirProgress != nullptr)
+	{
+		std::string dir;
+		const auto dirProgress = notification.dirProgress->setPlotFileRead(plotFile.getPath(), dir);
+
+		if (dirProgress >= 0)
+			data_.getBlockData()->setProgress(dir, dirProgress, notification.blockheight);
+	}
+	else if (plotListSize > 0)
+	{
+		data_.getBlockData()->setProgress(
+			notification.dir,
+			static_cast<float>(filesRead) / plotListSize * 100.f,
+			notification.blockheight
+		);
+	}
+
+	const auto nonceBytes = static_cast<double>(plotFile.getNonces() * Settings::ScoopSize);
+	const auto bytesPerSeconds = nonceBytes / fileReadDiffSeconds;
+
+	log_information_if(MinerLogger::plotReader, MinerLogger::hasOutput(PlotDone), "%s (%s) read in %ss (~%s/s)",
+		plotFile.getPath(),
+		memToString(plotFile.getSize(), 2),
+		Poco::DateTimeFormatter::format(span, "%s.%i"),
+		memToString(static_cast<Poco::UInt64>(bytesPerSeconds), 2));
+
+	if (!MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
+	{
+		START_PROBE("PlotReader.Progress")
+			progress_->add(plotFile.getSize(), notification.blockheight);
+		TAKE_PROBE("PlotReader.Progress")
+	}
+}
+
+void Burst::PlotDirProgress::addPlotFile(const std::string& dir, const std::string& plotFile)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	plotFileDirs_[plotFile] = dir;
+	++dirs_[dir].second;
+}
+
+float Burst::PlotDirProgress::setPlotFileRead(const std::string& plotFile, std::string& dir)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	const auto iter = plotFileDirs_.find(plotFile);
+
+	if (iter == plotFileDirs_.end())
+		return -1.f;
+
+	dir = iter->second;
+	auto& files = dirs_[dir];
+	++files.first;
+
+	return static_cast<float>(files.first) / files.second * 100.f;
+}
+
 void Burst::PlotReadProgress::reset(Poco::UInt64 blockheight, uintmax_t max)
 {
 	std::lock_guard<std::mutex> guard(mutex_);
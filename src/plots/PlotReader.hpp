@@ -26,12 +26,18 @@
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <fstream>
 #include "Declarations.hpp"
 #include <Poco/Task.h>
 #include <atomic>
 #include <Poco/Notification.h>
 #include "mining/MinerConfig.hpp"
 #include "Plot.hpp"
+#include "IoUring.hpp"
+#include "DirectFile.hpp"
+#include <Poco/Timestamp.h>
+#include <Poco/Condition.h>
+#include <unordered_map>
 
 namespace Poco
 {
@@ -42,12 +48,22 @@ namespace Burst
 {
 	class MinerData;
 	class PlotReadProgress;
+	class VerificationScheduler;
 
 	class GlobalBufferSize
 	{
 	public:
 		void setMax(Poco::UInt64 max);
 		bool reserve(Poco::UInt64 size);
+
+		/**
+		 * \brief Reserves memory and waits for it, if there is not enough free memory.
+		 * The waiting thread is woken up as soon as memory is given free.
+		 * \param size The size of the memory in bytes.
+		 * \param milliseconds The max. time to wait.
+		 * \return true, if the memory was reserved, false otherwise.
+		 */
+		bool reserve(Poco::UInt64 size, long milliseconds);
 		void free(Poco::UInt64 size);
 		
 		Poco::UInt64 getSize() const;
@@ -57,6 +73,35 @@ namespace Burst
 		Poco::UInt64 size_ = 0;
 		Poco::UInt64 max_ = 0;
 		mutable Poco::FastMutex mutex_;
+		Poco::Condition freed_;
+	};
+
+	/**
+	 * \brief Counts the read plot files of every plot dir, when the plot files
+	 * of a dir are read by more than one plot read notification.
+	 */
+	class PlotDirProgress
+	{
+	public:
+		/**
+		 * \brief Adds a plot file, that will be read.
+		 * \param dir The plot dir of the plot file.
+		 * \param plotFile The path of the plot file.
+		 */
+		void addPlotFile(const std::string& dir, const std::string& plotFile);
+
+		/**
+		 * \brief Marks a plot file as read.
+		 * \param plotFile The path of the plot file.
+		 * \param dir The plot dir of the plot file.
+		 * \return The progress of the plot dir in percent, a negative value if the plot file is unknown.
+		 */
+		float setPlotFileRead(const std::string& plotFile, std::string& dir);
+
+	private:
+		std::mutex mutex_;
+		std::unordered_map<std::string, std::string> plotFileDirs_;
+		std::unordered_map<std::string, std::pair<size_t, size_t>> dirs_;
 	};
 
 	struct PlotReadNotification : Poco::Notification
@@ -71,24 +116,142 @@ namespace Burst
 		std::vector<std::pair<std::string, std::vector<std::shared_ptr<PlotFile>>>> relatedPlotLists;
 		PlotDir::Type type = PlotDir::Type::Sequential;
 		bool wakeUpCall = false;
+		std::shared_ptr<PlotDirProgress> dirProgress;
+	};
+
+	/**
+	 * \brief A part of the scoops of a plot file, that is read at once.
+	 * It is a contiguous part of the scoops of one stagger or the scoops of
+	 * multiple whole staggers (coalesced reads), that are read into one buffer.
+	 */
+	struct PlotReadChunk
+	{
+		Poco::UInt64 startNonce = 0;
+		Poco::UInt64 nonces = 0;
+		Poco::UInt64 offset = 0;
+		Poco::UInt64 bytes = 0;
+
+		/**
+		 * \brief The number of equally sized slices, every one inside another stagger.
+		 */
+		Poco::UInt64 slices = 1;
+
+		/**
+		 * \brief The distance between the offsets of two slices in bytes.
+		 */
+		Poco::UInt64 sliceStride = 0;
 	};
 
 	class PlotReader : public Poco::Task
 	{
 	public:
 		PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progress,
-			Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue);
-		~PlotReader() override = default;
+			VerificationScheduler& verificationScheduler, Poco::NotificationQueue& plotReadQueue);
+		~PlotReader() override;
 
 		void runTask() override;
 
+		/**
+		 * \brief Returns the max. size of a chunk for a plot file.
+		 * \param plotFile The plot file.
+		 * \return The max. size of a chunk in bytes.
+		 */
+		static Poco::UInt64 getChunkBytes(const PlotFile& plotFile);
+
+		/**
+		 * \brief Returns the max. number of nonces inside a chunk for a plot file.
+		 * Without coalesced reads a chunk never exceeds the size of a stagger.
+		 * \param plotFile The plot file.
+		 * \param chunkBytes The max. size of a chunk in bytes.
+		 * \return The max. number of nonces.
+		 */
+		static Poco::UInt64 getNoncesPerChunk(const PlotFile& plotFile, Poco::UInt64 chunkBytes);
+
+		/**
+		 * \brief Calculates the chunk, that starts at a specific nonce.
+		 * A chunk never exceeds the border of a stagger, except it consists of multiple whole staggers.
+		 * \param plotFile The plot file.
+		 * \param nonce The first nonce of the chunk, relative to the start of the plot file.
+		 * \param noncesPerChunk The max. number of nonces inside the chunk.
+		 * \param chunkBytes The max. size of the chunk in bytes.
+		 * \param scoopNum The scoop of the current round.
+		 * \return The chunk.
+		 */
+		static PlotReadChunk getChunk(const PlotFile& plotFile, Poco::UInt64 nonce, Poco::UInt64 noncesPerChunk,
+			Poco::UInt64 chunkBytes, Poco::UInt64 scoopNum);
+
+		/**
+		 * \brief Calculates the chunk of the mirrored scoop (4095 - scoop), that holds the second hashes
+		 * of a chunk in the other PoC format.
+		 * \param plotFile The plot file.
+		 * \param chunk The chunk of the scoop of the current round.
+		 * \param scoopNum The scoop of the current round.
+		 * \return The chunk of the mirrored scoop.
+		 */
+		static PlotReadChunk getMirrorChunk(const PlotFile& plotFile, const PlotReadChunk& chunk, Poco::UInt64 scoopNum);
+
+		/**
+		 * \brief Replaces the second hashes of scoops with the ones of the mirrored scoops.
+		 * This converts PoC1 scoops into PoC2 scoops and vice versa.
+		 * \param scoops The scoops, that are converted.
+		 * \param mirrorScoops The mirrored scoops of the same nonces.
+		 * \param nonces The number of scoops.
+		 */
+		static void mergeMirroredHalves(ScoopData* scoops, const ScoopData* mirrorScoops, Poco::UInt64 nonces);
+
+		/**
+		 * \brief Checks the read scoops of a chunk against the checksum index of the plot file.
+		 * A corrupted chunk is logged.
+		 * \param plotFile The plot file.
+		 * \param chunk The chunk.
+		 * \param scoopNum The scoop of the chunk.
+		 * \param data The scoops, as they are stored in the plot file.
+		 * \return false, if the chunk is corrupted; true, if it is valid or can not be checked.
+		 */
+		static bool verifyChecksums(const PlotFile& plotFile, const PlotReadChunk& chunk, Poco::UInt64 scoopNum,
+			const char* data);
+
 		static GlobalBufferSize globalBufferSize;
 
 	private:
+		bool isUsingIoUring();
+		bool readPlotListAsync(PlotReadNotification& notification);
+
+		/**
+		 * \brief Reads the scoops of all plot files of the notification in the order of their
+		 * address on the device (elevator order), so there are no seeks back and forth between
+		 * the fragments of the plot files.
+		 * All plot files need a known extent map.
+		 * \param notification The plot read notification.
+		 * \return True, if the notification is still for the current block.
+		 */
+		bool readPlotListByExtents(PlotReadNotification& notification);
+
+		/**
+		 * \brief Reads all slices of a chunk into a buffer, directly or buffered.
+		 * If the plot file has an other PoC format than the block, the mirrored scoops are read too.
+		 * When the filesystem refuses the direct reading (EINVAL), the direct file is closed and the chunk is read buffered.
+		 * \param plotFile The plot file.
+		 * \param chunk The chunk.
+		 * \param scoopNum The scoop of the current round.
+		 * \param blockheight The height of the current round.
+		 * \param stream The buffered stream of the plot file.
+		 * \param directFile The direct file of the plot file (can be nullptr).
+		 * \param buffer The target buffer.
+		 * \return false, if the chunk could not be read completely or is corrupted (see \fn verifyChecksums).
+		 */
+		bool readChunk(const PlotFile& plotFile, const PlotReadChunk& chunk, Poco::UInt64 scoopNum, Poco::UInt64 blockheight,
+			std::ifstream& stream, std::unique_ptr<DirectFile>& directFile, ScoopData* buffer);
+		void plotFileRead(const PlotReadNotification& notification, const PlotFile& plotFile, size_t filesRead,
+			const Poco::Timestamp& timeStart);
+
 		MinerData& data_;
 		std::shared_ptr<PlotReadProgress> progress_;
-		Poco::NotificationQueue* verificationQueue_;
+		VerificationScheduler* verificationScheduler_;
+		size_t verificationQueue_;
 		Poco::NotificationQueue* plotReadQueue_;
+		std::unique_ptr<IoUring> ring_;
+		std::vector<ScoopData> mirrorBuffer_;
 	};
 
 	class PlotReadProgress
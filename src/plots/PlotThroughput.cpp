@@ -0,0 +1,152 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotThroughput.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <Poco/File.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+
+Poco::Mutex Burst::PlotThroughput::mutex_;
+std::unordered_map<std::string, double> Burst::PlotThroughput::bytesPerSecond_;
+bool Burst::PlotThroughput::loaded_ = false;
+bool Burst::PlotThroughput::changed_ = false;
+
+namespace
+{
+	// the weight of a new measurement
+	const double throughputWeight = 0.3;
+}
+
+void Burst::PlotThroughput::add(const std::string& key, const Poco::UInt64 bytes, const double seconds)
+{
+	if (bytes == 0 || seconds <= 0)
+		return;
+
+	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+	loadUnlocked();
+
+	const auto measured = static_cast<double>(bytes) / seconds;
+	const auto iter = bytesPerSecond_.find(key);
+
+	if (iter == bytesPerSecond_.end())
+		bytesPerSecond_.emplace(key, measured);
+	else
+		iter->second = throughputWeight * measured + (1 - throughputWeight) * iter->second;
+
+	changed_ = true;
+}
+
+double Burst::PlotThroughput::get(const std::string& key)
+{
+	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+	loadUnlocked();
+
+	const auto iter = bytesPerSecond_.find(key);
+
+	if (iter == bytesPerSecond_.end())
+		return 0;
+
+	return iter->second;
+}
+
+double Burst::PlotThroughput::getSlowest()
+{
+	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+	loadUnlocked();
+
+	if (bytesPerSecond_.empty())
+		return 0;
+
+	return std::min_element(bytesPerSecond_.begin(), bytesPerSecond_.end(),
+		[](const std::pair<const std::string, double>& lhs, const std::pair<const std::string, double>& rhs)
+		{
+			return lhs.second < rhs.second;
+		})->second;
+}
+
+void Burst::PlotThroughput::save()
+{
+	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+
+	if (!changed_)
+		return;
+
+	const auto historyPath = getMinerHomeDir("throughput.json").toString();
+
+	try
+	{
+		Poco::File{getMinerHomeDir()}.createDirectories();
+
+		Poco::JSON::Object history;
+
+		for (const auto& throughput : bytesPerSecond_)
+			history.set(throughput.first, throughput.second);
+
+		std::ofstream historyFile{historyPath};
+
+		if (historyFile.is_open())
+		{
+			history.stringify(historyFile, 4);
+			changed_ = false;
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::plotReader, "Could not write the throughput history %s: %s", historyPath, exc.displayText());
+	}
+}
+
+void Burst::PlotThroughput::loadUnlocked()
+{
+	if (loaded_)
+		return;
+
+	loaded_ = true;
+
+	const auto historyPath = getMinerHomeDir("throughput.json").toString();
+
+	try
+	{
+		std::ifstream historyFile{historyPath};
+
+		if (!historyFile.is_open())
+			return;
+
+		Poco::JSON::Parser parser;
+		const auto history = parser.parse(historyFile).extract<Poco::JSON::Object::Ptr>();
+
+		for (const auto& throughput : *history)
+		{
+			const auto bytesPerSecond = throughput.second.convert<double>();
+
+			if (bytesPerSecond > 0)
+				bytesPerSecond_[throughput.first] = bytesPerSecond;
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::plotReader, "Could not read the throughput history %s: %s", historyPath, exc.displayText());
+	}
+}
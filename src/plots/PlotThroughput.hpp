@@ -0,0 +1,75 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <unordered_map>
+#include <string>
+#include <Poco/Mutex.h>
+
+namespace Burst
+{
+	/**
+	 * \brief A persistent history of the read throughput of the plot dirs and devices.
+	 * The throughput is used to predict, how long the reading of a dir or device takes,
+	 * so the slowest ones can be started first.
+	 */
+	class PlotThroughput
+	{
+	public:
+		~PlotThroughput() = delete;
+
+		/**
+		 * \brief Adds a measured read throughput.
+		 * The history is an exponential moving average, so single slow rounds don't dominate it.
+		 * \param key The plot dir or the device.
+		 * \param bytes The amount of scoop bytes, that were read.
+		 * \param seconds The time needed to read the bytes.
+		 */
+		static void add(const std::string& key, Poco::UInt64 bytes, double seconds);
+
+		/**
+		 * \brief Gets the read throughput of a plot dir or device.
+		 * \param key The plot dir or the device.
+		 * \return The throughput in bytes per second (0 if it is unknown).
+		 */
+		static double get(const std::string& key);
+
+		/**
+		 * \brief Gets the lowest known read throughput.
+		 * \return The throughput in bytes per second (0 if no throughput is known).
+		 */
+		static double getSlowest();
+
+		/**
+		 * \brief Writes the history into the miner home dir.
+		 */
+		static void save();
+
+	private:
+		static void loadUnlocked();
+
+		static Poco::Mutex mutex_;
+		static std::unordered_map<std::string, double> bytesPerSecond_;
+		static bool loaded_;
+		static bool changed_;
+	};
+}
@@ -20,3 +20,393 @@
 // ==========================================================================
 
 #include "PlotVerifier.hpp"
+#include "MinerUtil.hpp"
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <Poco/File.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/NotificationQueue.h>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+Burst::VerifyNotification::Ptr Burst::VerifyNotificationPool::acquire()
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	if (notifications_.empty())
+		return new VerifyNotification{};
+
+	auto notification = notifications_.back();
+	notifications_.pop_back();
+	return notification;
+}
+
+void Burst::VerifyNotificationPool::release(VerifyNotification::Ptr notification)
+{
+	// the threshold belongs to the round of the notification
+	if (!notification.isNull())
+		notification->threshold.reset();
+
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	// the pool is full, the notification will be destroyed
+	if (notifications_.size() < maxSize_)
+		notifications_.emplace_back(std::move(notification));
+
+	released_.broadcast();
+}
+
+bool Burst::VerifyNotificationPool::waitForRelease(const long milliseconds)
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+	return released_.tryWait(mutex_, milliseconds);
+}
+
+void Burst::VerifyNotificationPool::preallocate(const size_t count, const Poco::UInt64 nonces, const bool hugePages)
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	if (maxSize_ == count && nonces_ == nonces && hugePages_ == hugePages)
+		return;
+
+	maxSize_ = count;
+	nonces_ = nonces;
+	hugePages_ = hugePages;
+
+	notifications_.clear();
+	notifications_.reserve(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		VerifyNotification::Ptr notification = new VerifyNotification{};
+		notification->buffer.reserve(nonces);
+
+#if defined __linux__ && defined MADV_HUGEPAGE
+		// transparent huge pages need a page aligned region
+		if (hugePages && nonces > 0)
+		{
+			const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+			const auto begin = reinterpret_cast<uintptr_t>(notification->buffer.data());
+			const auto end = begin + nonces * Settings::ScoopSize;
+			const auto alignedBegin = (begin + pageSize - 1) / pageSize * pageSize;
+
+			if (alignedBegin < end)
+				madvise(reinterpret_cast<void*>(alignedBegin), end - alignedBegin, MADV_HUGEPAGE);
+		}
+#endif
+
+		// touch the memory now, not with the first reads of a round
+		notification->buffer.resize(nonces);
+		notifications_.emplace_back(notification);
+	}
+}
+
+size_t Burst::VerifyNotificationPool::getSize() const
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+	return notifications_.size();
+}
+
+Burst::VerifyNotificationPool& Burst::VerifyNotificationPool::instance()
+{
+	static VerifyNotificationPool pool;
+	return pool;
+}
+
+namespace
+{
+	using MeasureFunction = double (*)(std::vector<Burst::ScoopData>&, const Burst::GensigData&, unsigned);
+
+	struct CpuKernel
+	{
+		std::string name;
+		std::string instructionSet;
+		bool supported;
+		MeasureFunction measure;
+	};
+
+	/**
+	 * \brief All CPU verification kernels, the fixed length kernels (that are used for mining)
+	 * have the name of their instruction set, all others an empty one.
+	 */
+	std::vector<CpuKernel> getCpuKernels()
+	{
+		using namespace Burst;
+
+		const auto sse2 = Settings::Sse2 && cpuHasInstructionSet(CpuInstructionSet::sse2);
+		const auto sse4 = Settings::Sse4 && cpuHasInstructionSet(CpuInstructionSet::sse4);
+		const auto avx = Settings::Avx && cpuHasInstructionSet(CpuInstructionSet::avx);
+		const auto avx2 = Settings::Avx2 && cpuHasInstructionSet(CpuInstructionSet::avx2);
+		const auto avx512 = Settings::Avx512 && cpuHasInstructionSet(CpuInstructionSet::avx512);
+
+		return {
+			{"sphlib (reference)", "", true, &measureVerifierAlgorithm<PlotVerifierAlgorithm_sphlib>},
+			{"SSE2 (generic)", "", sse2, &measureVerifierAlgorithm<PlotVerifierAlgorithm_sse2_generic>},
+			// without SSE2 the baseline kernel is sphlib
+			{"SSE2 (fixed)", "SSE2", true, &measureVerifierAlgorithm<PlotVerifierAlgorithm_sse2>},
+			{"SSE4 (generic)", "", sse4, &measureVerifierAlgorithm<PlotVerifierAlgorithm_sse4_generic>},
+			{"SSE4 (fixed)", "SSE4", sse4, &measureVerifierAlgorithm<PlotVerifierAlgorithm_sse4>},
+			{"AVX (generic)", "", avx, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx_generic>},
+			{"AVX (fixed)", "AVX", avx, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx>},
+			{"AVX2 (generic)", "", avx2, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx2_generic>},
+			{"AVX2 (fixed)", "AVX2", avx2, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx2>},
+			{"AVX512 (generic)", "", avx512, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx512_generic>},
+			{"AVX512 (fixed)", "AVX512", avx512, &measureVerifierAlgorithm<PlotVerifierAlgorithm_avx512>},
+		};
+	}
+
+	void fillSyntheticBuffer(std::vector<Burst::ScoopData>& buffer, Burst::GensigData& gensig)
+	{
+		std::mt19937 random{42};
+
+		for (auto& scoop : buffer)
+			for (auto& byte : scoop)
+				byte = static_cast<Poco::UInt8>(random());
+
+		for (auto& byte : gensig)
+			byte = static_cast<Poco::UInt8>(random());
+	}
+
+	/**
+	 * \brief A fingerprint of the CPU and the compiled kernels, a cached calibration
+	 * is only valid for the same fingerprint.
+	 */
+	std::string getCalibrationFingerprint()
+	{
+		std::stringstream sstream;
+
+		sstream << Burst::cpuGetBrand() << ';' << Burst::cpuGetInstructionSets() << ';';
+
+		for (const auto& kernel : getCpuKernels())
+			if (!kernel.instructionSet.empty() && kernel.supported)
+				sstream << kernel.instructionSet << ',';
+
+		return sstream.str();
+	}
+
+	/**
+	 * \brief Lets readers push the notifications through a queue to verifiers, that verify them.
+	 * \return The verified notifications per second.
+	 */
+	template <typename TEnqueue, typename TDequeue>
+	double measureScheduling(const std::vector<Burst::VerifyNotification::Ptr>& work, const size_t notifications,
+		const unsigned readers, const unsigned verifiers, const Burst::GensigData& gensig, TEnqueue enqueue, TDequeue dequeue)
+	{
+		using namespace Burst;
+
+		std::atomic<size_t> verified{0};
+		std::vector<std::thread> threads;
+		const auto startPoint = std::chrono::high_resolution_clock::now();
+		auto endPoint = startPoint;
+
+		for (auto i = 0u; i < verifiers; ++i)
+			threads.emplace_back([&, i]()
+			{
+				const DeadlineThreshold threshold;
+
+				while (verified < notifications)
+				{
+					auto notification = dequeue(i);
+
+					if (!notification)
+						continue;
+
+					PlotVerifierAlgorithm_sse2::run(notification->buffer, notification->nonceRead, notification->nonceStart,
+						1, gensig, threshold, []() { return false; }, nullptr);
+
+					// the waiting verifiers need some time to notice the end, that is not measured
+					if (++verified == notifications)
+						endPoint = std::chrono::high_resolution_clock::now();
+				}
+			});
+
+		for (auto i = 0u; i < readers; ++i)
+			threads.emplace_back([&, i]()
+			{
+				for (size_t j = i; j < notifications; j += readers)
+					enqueue(work[j % work.size()], i);
+			});
+
+		for (auto& thread : threads)
+			thread.join();
+
+		const auto seconds = std::chrono::duration<double>(endPoint - startPoint).count();
+
+		if (seconds <= 0)
+			return 0;
+
+		return static_cast<double>(notifications) / seconds;
+	}
+}
+
+void Burst::benchmarkVerifierAlgorithms(const size_t nonces, const unsigned rounds)
+{
+	std::vector<ScoopData> buffer(nonces);
+	GensigData gensig;
+
+	fillSyntheticBuffer(buffer, gensig);
+
+	log_information(MinerLogger::general, "Verifying %z nonces %u times with every CPU kernel...", nonces, rounds);
+
+	for (const auto& kernel : getCpuKernels())
+	{
+		if (!kernel.supported)
+		{
+			log_information(MinerLogger::general, "%s: not supported", kernel.name);
+			continue;
+		}
+
+		const auto noncesPerSecond = kernel.measure(buffer, gensig, rounds);
+		log_information(MinerLogger::general, "%s: %s nonces/s", kernel.name,
+			numberToString(static_cast<Poco::UInt64>(noncesPerSecond)));
+	}
+}
+
+void Burst::benchmarkVerificationScheduler(const size_t nonces, const size_t notifications, const unsigned maxVerifiers)
+{
+	constexpr auto Readers = 4u;
+	std::vector<ScoopData> buffer(nonces);
+	GensigData gensig;
+
+	fillSyntheticBuffer(buffer, gensig);
+
+	// the readers cycle through the same notifications, so the memory stays small
+	std::vector<VerifyNotification::Ptr> work(1024);
+
+	for (auto& notification : work)
+	{
+		notification = new VerifyNotification{};
+		notification->buffer = buffer;
+	}
+
+	log_information(MinerLogger::general, "Verifying %z chunks of %z nonces with %u readers and 1 to %u verifiers...",
+		notifications, nonces, Readers, maxVerifiers);
+
+	for (auto verifiers = 1u; verifiers <= maxVerifiers; verifiers *= 2)
+	{
+		Poco::NotificationQueue queue;
+		VerificationScheduler scheduler;
+		scheduler.setWorkStealing(true);
+
+		const auto queueSpeed = measureScheduling(work, notifications, Readers, verifiers, gensig,
+			[&queue](const VerifyNotification::Ptr& notification, size_t)
+			{
+				queue.enqueueNotification(notification);
+			},
+			[&queue](size_t)
+			{
+				Poco::Notification::Ptr notification(queue.waitDequeueNotification(100));
+				return notification.cast<VerifyNotification>();
+			});
+
+		const auto schedulerSpeed = measureScheduling(work, notifications, Readers, verifiers, gensig,
+			[&scheduler](const VerifyNotification::Ptr& notification, const size_t reader)
+			{
+				scheduler.enqueue(notification, reader);
+			},
+			[&scheduler](const size_t verifier)
+			{
+				return scheduler.waitDequeue(verifier, 100);
+			});
+
+		log_information(MinerLogger::general, "%2u verifiers: %s chunks/s (single queue), %s chunks/s (work stealing)",
+			verifiers, numberToString(static_cast<Poco::UInt64>(queueSpeed)),
+			numberToString(static_cast<Poco::UInt64>(schedulerSpeed)));
+	}
+}
+
+std::string Burst::calibrateCpuInstructionSet(const size_t nonces, const unsigned rounds)
+{
+	std::vector<ScoopData> buffer(nonces);
+	GensigData gensig;
+	std::string fastest = "SSE2";
+	auto fastestNoncesPerSecond = 0.0;
+
+	fillSyntheticBuffer(buffer, gensig);
+
+	for (const auto& kernel : getCpuKernels())
+	{
+		if (kernel.instructionSet.empty() || !kernel.supported)
+			continue;
+
+		// warm up, so that the first kernel is not measured with a sleeping core
+		kernel.measure(buffer, gensig, 1);
+
+		const auto noncesPerSecond = kernel.measure(buffer, gensig, rounds);
+
+		log_debug(MinerLogger::general, "Calibration %s: %s nonces/s", kernel.instructionSet,
+			numberToString(static_cast<Poco::UInt64>(noncesPerSecond)));
+
+		if (noncesPerSecond > fastestNoncesPerSecond)
+		{
+			fastest = kernel.instructionSet;
+			fastestNoncesPerSecond = noncesPerSecond;
+		}
+	}
+
+	return fastest;
+}
+
+std::string Burst::getCalibratedCpuInstructionSet()
+{
+	const auto cachePath = getMinerHomeDir("calibration.json").toString();
+	const auto fingerprint = getCalibrationFingerprint();
+
+	try
+	{
+		std::ifstream cacheFile{cachePath};
+
+		if (cacheFile.is_open())
+		{
+			Poco::JSON::Parser parser;
+			const auto cache = parser.parse(cacheFile).extract<Poco::JSON::Object::Ptr>();
+
+			if (cache->optValue<std::string>("fingerprint", "") == fingerprint)
+			{
+				const auto cached = cache->optValue<std::string>("cpuInstructionSet", "");
+
+				if (!cached.empty())
+				{
+					log_debug(MinerLogger::general, "Using the calibrated CPU instruction set %s from %s", cached, cachePath);
+					return cached;
+				}
+			}
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::general, "Could not read the calibration cache %s: %s", cachePath, exc.displayText());
+	}
+
+	log_system(MinerLogger::general, "Calibrating the CPU instruction set...");
+
+	const auto fastest = calibrateCpuInstructionSet(64 * 1024, 4);
+
+	log_system(MinerLogger::general, "Fastest CPU instruction set: %s", fastest);
+
+	try
+	{
+		Poco::File{getMinerHomeDir()}.createDirectories();
+
+		Poco::JSON::Object cache;
+		cache.set("fingerprint", fingerprint);
+		cache.set("cpuInstructionSet", fastest);
+
+		std::ofstream cacheFile{cachePath};
+
+		if (cacheFile.is_open())
+			cache.stringify(cacheFile, 4);
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::general, "Could not write the calibration cache %s: %s", cachePath, exc.displayText());
+	}
+
+	return fastest;
+}
@@ -27,6 +27,7 @@
 #include <Poco/AutoPtr.h>
 #include <Poco/Notification.h>
 #include <Poco/NotificationQueue.h>
+#include <Poco/Condition.h>
 #include "shabal/MinerShabal.hpp"
 #include "logging/Performance.hpp"
 #include "mining/Miner.hpp"
@@ -35,6 +36,8 @@
 #include "PlotReader.hpp"
 #include "gpu/gpu_shell.hpp"
 #include "gpu/algorithm/gpu_algorithm_atomic.hpp"
+#include "mining/DeadlineThreshold.hpp"
+#include "VerificationScheduler.hpp"
 
 namespace Burst
 {
@@ -53,6 +56,65 @@ namespace Burst
 		GensigData gensig;
 		Poco::UInt64 baseTarget = 0;
 		Poco::UInt64 memorySize = 0;
+		std::shared_ptr<DeadlineThreshold> threshold;
+	};
+
+	/**
+	 * \brief A pool of verify notifications, that are given back by the verifiers after the verification.
+	 * The scoop buffers of the notifications keep their memory, so reading a round
+	 * needs no allocation (and no zero filling) of scoop buffers.
+	 */
+	class VerifyNotificationPool
+	{
+	public:
+		/**
+		 * \brief Returns a notification, a recycled one if possible.
+		 * The scoop buffer of a recycled notification keeps its capacity.
+		 * \return The notification.
+		 */
+		VerifyNotification::Ptr acquire();
+
+		/**
+		 * \brief Gives a notification back to the pool.
+		 * \param notification The notification, that is not used anymore.
+		 */
+		void release(VerifyNotification::Ptr notification);
+
+		/**
+		 * \brief Waits until a notification is given back to the pool.
+		 * \param milliseconds The max. time to wait.
+		 * \return true, if a notification was given back, false otherwise.
+		 */
+		bool waitForRelease(long milliseconds);
+
+		/**
+		 * \brief Allocates the notifications and their scoop buffers in advance.
+		 * Nothing happens, if the pool was already allocated with the same parameters.
+		 * \param count The number of notifications.
+		 * \param nonces The number of nonces per scoop buffer.
+		 * \param hugePages If true, the scoop buffers are advised to use huge pages.
+		 */
+		void preallocate(size_t count, Poco::UInt64 nonces, bool hugePages);
+
+		/**
+		 * \brief Returns the number of notifications, that are waiting in the pool.
+		 * \return The number of notifications.
+		 */
+		size_t getSize() const;
+
+		/**
+		 * \brief Returns the global pool.
+		 * \return The global singleton instance.
+		 */
+		static VerifyNotificationPool& instance();
+
+	private:
+		std::vector<VerifyNotification::Ptr> notifications_;
+		size_t maxSize_ = 0;
+		Poco::UInt64 nonces_ = 0;
+		bool hugePages_ = false;
+		mutable Poco::FastMutex mutex_;
+		Poco::Condition released_;
 	};
 	
 	using DeadlineTuple = std::pair<Poco::UInt64, Poco::UInt64>;
@@ -62,22 +124,37 @@ namespace Burst
 	class PlotVerifier : public Poco::Task
 	{
 	public:
-		PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, std::shared_ptr<PlotReadProgress> progress,
+		PlotVerifier(MinerData& data, VerificationScheduler& scheduler, std::shared_ptr<PlotReadProgress> progress,
 		             SubmitFunction submitFunction);
 		~PlotVerifier() override;
 		void runTask() override;
+
+		/**
+		 * \brief Verifies a chunk of read scoops and submits the best deadline.
+		 * Afterwards the notification and its memory are given back.
+		 * \param verifyNotification The chunk.
+		 * \param data The miner data, that knows the current block.
+		 * \param progress The verification progress, can be nullptr.
+		 * \param submitFunction The function, that submits the best deadline.
+		 * \param cancelled Returns true, if the verification has to be stopped.
+		 * \param stream The stream of the verification algorithm.
+		 */
+		static void verify(VerifyNotification::Ptr verifyNotification, MinerData& data, PlotReadProgress* progress,
+			const SubmitFunction& submitFunction, const std::function<bool()>& cancelled, void* stream);
 		
 	private:
 		MinerData* data_;
-		Poco::NotificationQueue* queue_;
+		VerificationScheduler* scheduler_;
+		size_t homeQueue_;
 		std::shared_ptr<PlotReadProgress> progress_;
 		SubmitFunction submitFunction_;
 	};
 
 	template <typename TVerificationAlgorithm>
-	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, Poco::NotificationQueue& queue,
+	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, VerificationScheduler& scheduler,
 		std::shared_ptr<PlotReadProgress> progress, SubmitFunction submitFunction)
-		: Task("PlotVerifier"), data_{&data}, queue_{&queue}, progress_{progress}, submitFunction_{submitFunction}
+		: Task("PlotVerifier"), data_{&data}, scheduler_{&scheduler}, homeQueue_{scheduler.registerVerifier()},
+		  progress_{progress}, submitFunction_{submitFunction}
 	{
 	}
 
@@ -102,44 +179,13 @@ namespace Burst
 		{
 			try
 			{
-				Poco::Notification::Ptr notification(queue_->waitDequeueNotification());
-				VerifyNotification::Ptr verifyNotification;
-
-				if (notification)
-					verifyNotification = notification.cast<VerifyNotification>();
-				else
-					break;
-
-				const auto stopFunction = [this, &verifyNotification]()
-				{
-					return isCancelled() || verifyNotification->block != data_->getCurrentBlockheight();
-				};
+				// wake up from time to time, to check if the verifier was cancelled
+				auto verifyNotification = scheduler_->waitDequeue(homeQueue_, 100);
 
-				START_PROBE("PlotVerifier.SearchDeadline");
-				auto bestResult = TVerificationAlgorithm::run(verifyNotification->buffer, verifyNotification->nonceRead,
-					verifyNotification->nonceStart, verifyNotification->baseTarget, verifyNotification->gensig,
-					stopFunction, stream);
-				TAKE_PROBE("PlotVerifier.SearchDeadline");
+				if (!verifyNotification)
+					continue;
 
-				if (bestResult.first != 0 && bestResult.second != 0)
-				{
-					START_PROBE("PlotVerifier.Submit");
-					submitFunction_(bestResult.first,
-					                verifyNotification->accountId,
-					                bestResult.second,
-					                verifyNotification->block,
-					                verifyNotification->inputPath,
-					                true);
-					TAKE_PROBE("PlotVerifier.Submit");
-				}
-
-				START_PROBE("PlotVerifier.FreeMemory");
-				PlotReader::globalBufferSize.free(verifyNotification->memorySize);
-				TAKE_PROBE("PlotVerifier.FreeMemory");
-
-				if (progress_ != nullptr)
-					progress_->add(static_cast<Poco::UInt64>(verifyNotification->buffer.size()) * Settings::PlotSize,
-						verifyNotification->block);
+				verify(verifyNotification, *data_, progress_.get(), submitFunction_, [this]() { return isCancelled(); }, stream);
 			}
 			catch (Poco::Exception& exc)
 			{
@@ -160,6 +206,53 @@ namespace Burst
 		log_debug(MinerLogger::plotVerifier, "Verifier stopped");
 	}
 
+	template <typename TVerificationAlgorithm>
+	void PlotVerifier<TVerificationAlgorithm>::verify(VerifyNotification::Ptr verifyNotification, MinerData& data,
+		PlotReadProgress* progress, const SubmitFunction& submitFunction, const std::function<bool()>& cancelled,
+		void* stream)
+	{
+		static const DeadlineThreshold unlimitedThreshold;
+
+		const auto stopFunction = [&]()
+		{
+			return cancelled() || verifyNotification->block != data.getCurrentBlockheight();
+		};
+
+		// without a threshold (the round is already over) every deadline is accepted
+		const auto& threshold = verifyNotification->threshold != nullptr
+			? *verifyNotification->threshold : unlimitedThreshold;
+
+		START_PROBE("PlotVerifier.SearchDeadline");
+		auto bestResult = TVerificationAlgorithm::run(verifyNotification->buffer, verifyNotification->nonceRead,
+			verifyNotification->nonceStart, verifyNotification->baseTarget, verifyNotification->gensig,
+			threshold, stopFunction, stream);
+		TAKE_PROBE("PlotVerifier.SearchDeadline");
+
+		// only deadlines, that beat the best one of all verifiers, are submitted
+		if (bestResult.first != 0 && bestResult.second != 0 &&
+			(verifyNotification->threshold == nullptr || verifyNotification->threshold->improve(bestResult.second)))
+		{
+			START_PROBE("PlotVerifier.Submit");
+			submitFunction(bestResult.first,
+			               verifyNotification->accountId,
+			               bestResult.second,
+			               verifyNotification->block,
+			               verifyNotification->inputPath,
+			               true);
+			TAKE_PROBE("PlotVerifier.Submit");
+		}
+
+		if (progress != nullptr)
+			progress->add(static_cast<Poco::UInt64>(verifyNotification->buffer.size()) * Settings::PlotSize,
+				verifyNotification->block);
+
+		START_PROBE("PlotVerifier.FreeMemory");
+		const auto memorySize = verifyNotification->memorySize;
+		VerifyNotificationPool::instance().release(verifyNotification);
+		PlotReader::globalBufferSize.free(memorySize);
+		TAKE_PROBE("PlotVerifier.FreeMemory");
+	}
+
 	template <typename TShabal>
 	struct PlotVerifierOperations_1
 	{
@@ -210,6 +303,28 @@ namespace Burst
 		}
 	};
 
+	template <typename TShabal>
+	struct PlotVerifierOperations_16
+	{
+		template <typename TContainer>
+		static void updateScoops(TShabal& shabal, const TContainer& scoopPtr)
+		{
+			shabal.update(scoopPtr[0], scoopPtr[1], scoopPtr[2], scoopPtr[3],
+				scoopPtr[4], scoopPtr[5], scoopPtr[6], scoopPtr[7],
+				scoopPtr[8], scoopPtr[9], scoopPtr[10], scoopPtr[11],
+				scoopPtr[12], scoopPtr[13], scoopPtr[14], scoopPtr[15], Burst::Settings::ScoopSize);
+		}
+
+		template <typename TContainer>
+		static void close(TShabal& shabal, TContainer& targetPtr)
+		{
+			shabal.close(targetPtr[0], targetPtr[1], targetPtr[2], targetPtr[3],
+				targetPtr[4], targetPtr[5], targetPtr[6], targetPtr[7],
+				targetPtr[8], targetPtr[9], targetPtr[10], targetPtr[11],
+				targetPtr[12], targetPtr[13], targetPtr[14], targetPtr[15]);
+		}
+	};
+
 	template <typename TShabal, typename TShabalOperations>
 	struct PlotVerifierAlgorithm_cpu
 	{
@@ -220,7 +335,7 @@ namespace Burst
 
 		static DeadlineTuple run(std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
 						Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, const GensigData& gensig,
-						std::function<bool()> stop, void* stream)
+						const DeadlineThreshold& threshold, std::function<bool()> stop, void* stream)
 		{
 			DeadlineTuple bestResult = {0, 0};
 			TShabal shabal;
@@ -237,8 +352,8 @@ namespace Burst
 				for (auto& pair : result)
 					// make sure the nonce->deadline pair is valid...
 					if (pair.first > 0 && pair.second > 0)
-						// ..and better than the others
-						if (bestResult.second == 0 || pair.second < bestResult.second)
+						// ..and better than the others (also the ones of the other verifiers)
+						if ((bestResult.second == 0 || pair.second < bestResult.second) && threshold.isImproving(pair.second))
 							bestResult = pair;
 			}
 
@@ -292,6 +407,70 @@ namespace Burst
 		}
 	};
 
+	/**
+	 * \brief Verifies the scoops with a fixed length Shabal256 kernel.
+	 * The kernel only hashes the 96 byte message gensig + scoop and only
+	 * calculates the first 64 bit of the digest, that are needed for the deadline.
+	 * \tparam TShabal The mshabal implementation, that provides the kernel.
+	 */
+	template <typename TShabal>
+	struct PlotVerifierAlgorithm_fixed
+	{
+		static bool initStream(void** stream)
+		{
+			return true;
+		}
+
+		static DeadlineTuple run(std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
+						Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, const GensigData& gensig,
+						const DeadlineThreshold& threshold, std::function<bool()> stop, void* stream)
+		{
+			// the stop function is only checked between two batches
+			constexpr auto BatchSize = TShabal::DeadlineLanes * 16;
+
+			DeadlineTuple bestResult = {0, 0};
+			typename TShabal::deadline_context_t context;
+			std::array<unsigned long long, BatchSize> targets;
+
+			// everything, that depends on the gensig, is calculated only once
+			TShabal::initDeadline(context, gensig.data());
+
+			for (size_t i = 0;
+				i < buffer.size() && !stop();
+				i += BatchSize)
+			{
+				const auto count = std::min(BatchSize, buffer.size() - i);
+
+				TShabal::calculateTargets(context, buffer.data() + i, count, targets.data());
+
+				// the best deadline of all verifiers (or the target deadline) is converted into a limit
+				// for the raw targets, so only the few improving targets need a division
+				auto limit = threshold.getTargetLimit(baseTarget);
+
+				if (bestResult.second != 0)
+					limit = std::min(limit, DeadlineThreshold::toTargetLimit(bestResult.second, baseTarget));
+
+				for (size_t j = 0; j < count; ++j)
+				{
+					if (static_cast<Poco::UInt64>(targets[j]) >= limit)
+						continue;
+
+					const auto nonce = nonceStart + nonceRead + i + j;
+					const auto deadline = static_cast<Poco::UInt64>(targets[j]) / baseTarget;
+
+					// make sure the nonce->deadline pair is valid and better than the others
+					if (nonce > 0 && deadline > 0 && (bestResult.second == 0 || deadline < bestResult.second))
+					{
+						bestResult = std::make_pair(nonce, deadline);
+						limit = DeadlineThreshold::toTargetLimit(deadline, baseTarget);
+					}
+				}
+			}
+
+			return bestResult;
+		}
+	};
+
 	template <typename TGpu, typename TAlgorithm>
 	struct PlotVerifierAlgorithm_gpu
 	{
@@ -302,7 +481,7 @@ namespace Burst
 
 		static DeadlineTuple run(std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
 			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, const GensigData& gensig,
-			std::function<bool()> stop, void* stream)
+			const DeadlineThreshold& threshold, std::function<bool()> stop, void* stream)
 		{
 			DeadlineTuple bestDeadline{0, 0};
 			TGpu::template run<TAlgorithm>(
@@ -316,20 +495,98 @@ namespace Burst
 		}
 	};
 
-	using PlotVerifierOperation_sse2 = PlotVerifierOperations_1<Shabal256_SSE2>;
+	using PlotVerifierOperation_sphlib = PlotVerifierOperations_1<Shabal256_Sphlib>;
 	using PlotVerifierOperation_sse4 = PlotVerifierOperations_4<Shabal256_SSE4>;
 	using PlotVerifierOperation_avx = PlotVerifierOperations_4<Shabal256_AVX>;
 	using PlotVerifierOperation_avx2 = PlotVerifierOperations_8<Shabal256_AVX2>;
-
-	using PlotVerifierAlgorithm_sse2 = PlotVerifierAlgorithm_cpu<Shabal256_SSE2, PlotVerifierOperation_sse2>;
-	using PlotVerifierAlgorithm_sse4 = PlotVerifierAlgorithm_cpu<Shabal256_SSE4, PlotVerifierOperation_sse4>;
-	using PlotVerifierAlgorithm_avx = PlotVerifierAlgorithm_cpu<Shabal256_AVX, PlotVerifierOperation_avx>;
-	using PlotVerifierAlgorithm_avx2 = PlotVerifierAlgorithm_cpu<Shabal256_AVX2, PlotVerifierOperation_avx2>;
+	using PlotVerifierOperation_avx512 = PlotVerifierOperations_16<Shabal256_AVX512>;
+
+	using PlotVerifierAlgorithm_sphlib = PlotVerifierAlgorithm_cpu<Shabal256_Sphlib, PlotVerifierOperation_sphlib>;
+	using PlotVerifierAlgorithm_sse4_generic = PlotVerifierAlgorithm_cpu<Shabal256_SSE4, PlotVerifierOperation_sse4>;
+	using PlotVerifierAlgorithm_avx_generic = PlotVerifierAlgorithm_cpu<Shabal256_AVX, PlotVerifierOperation_avx>;
+	using PlotVerifierAlgorithm_avx2_generic = PlotVerifierAlgorithm_cpu<Shabal256_AVX2, PlotVerifierOperation_avx2>;
+	using PlotVerifierAlgorithm_avx512_generic = PlotVerifierAlgorithm_cpu<Shabal256_AVX512, PlotVerifierOperation_avx512>;
+
+#ifdef USE_SSE2
+	using PlotVerifierOperation_sse2 = PlotVerifierOperations_4<Shabal256_SSE2>;
+	using PlotVerifierAlgorithm_sse2_generic = PlotVerifierAlgorithm_cpu<Shabal256_SSE2, PlotVerifierOperation_sse2>;
+	using PlotVerifierAlgorithm_sse2 = PlotVerifierAlgorithm_fixed<Mshabal_sse2_Impl>;
+#else
+	// without SSE2 (non x86 platforms) the scalar sphlib is the baseline
+	using PlotVerifierAlgorithm_sse2_generic = PlotVerifierAlgorithm_sphlib;
+	using PlotVerifierAlgorithm_sse2 = PlotVerifierAlgorithm_sphlib;
+#endif
+
+	using PlotVerifierAlgorithm_sse4 = PlotVerifierAlgorithm_fixed<Mshabal_sse4_Impl>;
+	using PlotVerifierAlgorithm_avx = PlotVerifierAlgorithm_fixed<Mshabal_avx_Impl>;
+	using PlotVerifierAlgorithm_avx2 = PlotVerifierAlgorithm_fixed<Mshabal_avx2_Impl>;
+	using PlotVerifierAlgorithm_avx512 = PlotVerifierAlgorithm_fixed<Mshabal_avx512_Impl>;
 
 	using PlotVerifier_sse2 = PlotVerifier<PlotVerifierAlgorithm_sse2>;
 	using PlotVerifier_sse4 = PlotVerifier<PlotVerifierAlgorithm_sse4>;
 	using PlotVerifier_avx = PlotVerifier<PlotVerifierAlgorithm_avx>;
 	using PlotVerifier_avx2 = PlotVerifier<PlotVerifierAlgorithm_avx2>;
+	using PlotVerifier_avx512 = PlotVerifier<PlotVerifierAlgorithm_avx512>;
+
+	/**
+	 * \brief Measures the speed of a CPU verification algorithm.
+	 * \tparam TAlgorithm The verification algorithm.
+	 * \param buffer The scoops, that are verified.
+	 * \param gensig The generation signature.
+	 * \param rounds How many times the buffer is verified.
+	 * \return The verified nonces per second.
+	 */
+	template <typename TAlgorithm>
+	double measureVerifierAlgorithm(std::vector<ScoopData>& buffer, const GensigData& gensig, unsigned rounds)
+	{
+		const DeadlineThreshold threshold;
+		const auto startPoint = std::chrono::high_resolution_clock::now();
+
+		for (auto i = 0u; i < rounds; ++i)
+			TAlgorithm::run(buffer, 0, 0, 1, gensig, threshold, []() { return false; }, nullptr);
+
+		const auto seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startPoint).count();
+
+		if (seconds <= 0)
+			return 0;
+
+		return static_cast<double>(buffer.size()) * rounds / seconds;
+	}
+
+	/**
+	 * \brief Measures and logs the speed of all CPU verification algorithms,
+	 * that are supported by the build and the CPU.
+	 * \param nonces The number of nonces in the synthetic buffer.
+	 * \param rounds How many times the buffer is verified by every algorithm.
+	 */
+	void benchmarkVerifierAlgorithms(size_t nonces, unsigned rounds);
+
+	/**
+	 * \brief Measures and logs how many chunks the readers can hand over to 1, 2, 4, ... verifiers,
+	 * once with a single shared queue and once with the work stealing scheduler.
+	 * \param nonces The number of nonces per chunk.
+	 * \param notifications The number of chunks, that are verified per measurement.
+	 * \param maxVerifiers The max. number of verifiers.
+	 */
+	void benchmarkVerificationScheduler(size_t nonces, size_t notifications, unsigned maxVerifiers);
+
+	/**
+	 * \brief Measures the fixed length kernels of all CPU instruction sets,
+	 * that are supported by the build and the CPU, and returns the fastest one.
+	 * A newer instruction set is not always faster (e.g. AVX2 on downclocking CPUs).
+	 * \param nonces The number of nonces in the synthetic buffer.
+	 * \param rounds How many times the buffer is verified by every kernel.
+	 * \return The name of the fastest instruction set (SSE2, SSE4, AVX, AVX2 or AVX512).
+	 */
+	std::string calibrateCpuInstructionSet(size_t nonces, unsigned rounds);
+
+	/**
+	 * \brief Returns the fastest CPU instruction set for the "AUTO" setting.
+	 * The result of the calibration is cached in the miner home dir and only
+	 * measured again, when the CPU or the compiled kernels changed.
+	 * \return The name of the fastest instruction set.
+	 */
+	std::string getCalibratedCpuInstructionSet();
 
 	using PlotVerifierAlgorithm_cuda = PlotVerifierAlgorithm_gpu<GpuCuda, Gpu_Algorithm_Atomic>;
 	using PlotVerifierAlgorithm_opencl = PlotVerifierAlgorithm_gpu<GpuOpenCL, Gpu_Algorithm_Atomic>;
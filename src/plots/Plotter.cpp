@@ -0,0 +1,289 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "Plotter.hpp"
+#include "DirectFile.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Timestamp.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+
+constexpr Poco::UInt64 Burst::Plotter::NonceAlignment;
+
+namespace
+{
+	char* alignBuffer(std::vector<char>& buffer, const Poco::UInt64 size)
+	{
+		buffer.resize(size + Burst::DirectFile::Alignment);
+
+		void* alignedBuffer = buffer.data();
+		auto space = buffer.size();
+
+		return static_cast<char*>(std::align(Burst::DirectFile::Alignment, size, alignedBuffer, space));
+	}
+
+	double noncesPerMinute(const Poco::UInt64 nonces, const Poco::Timestamp& start)
+	{
+		const auto elapsed = std::max<Poco::Timestamp::TimeDiff>(start.elapsed(), 1);
+		return nonces * 60.0 * 1000 * 1000 / elapsed;
+	}
+}
+
+Burst::Plotter::Plotter(const Poco::UInt64 account, const Poco::UInt64 startNonce, const Poco::UInt64 nonces,
+	const std::string& dir, const bool poc2, const Poco::UInt64 memoryBytes, const unsigned threads)
+	: account_(account),
+	  startNonce_(startNonce),
+	  nonces_(nonces / NonceAlignment * NonceAlignment),
+	  poc2_(poc2),
+	  threads_(threads > 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u))
+{
+	// two windows, so that the next window is generated while the current one is written
+	windowNonces_ = std::max(memoryBytes / (2 * Settings::PlotSize) / NonceAlignment * NonceAlignment, NonceAlignment);
+
+	auto name = std::to_string(account_) + "_" + std::to_string(startNonce_) + "_" + std::to_string(nonces_);
+
+	if (!poc2_)
+		name += "_" + std::to_string(nonces_);
+
+	path_ = Poco::Path{dir}.makeDirectory().setFileName(name).toString();
+
+	arenas_.resize(threads_);
+}
+
+bool Burst::Plotter::run(const std::function<bool()>& cancel)
+{
+	if (nonces_ == 0)
+	{
+		log_error(MinerLogger::general, "A plot file needs at least %s nonces!", std::to_string(NonceAlignment));
+		return false;
+	}
+
+	Poco::File file{path_};
+	Poco::UInt64 noncesWritten = 0;
+
+	// only unfinished plot files are continued, complete ones are never overwritten
+	if (file.exists() && !readPlotFileProgress(path_, noncesWritten))
+	{
+		log_error(MinerLogger::general, "The plot file %s already exists!", path_);
+		return false;
+	}
+
+	if (noncesWritten == 0)
+	{
+		const auto size = nonces_ * Settings::PlotSize;
+		const auto existing = file.exists() ? file.getSize() : 0;
+
+		if (Poco::File{Poco::Path{path_}.parent().toString()}.freeSpace() + existing < size)
+		{
+			log_error(MinerLogger::general, "Not enough free space to plot the file %s (needed: %s)",
+				path_, memToString(size, 2));
+			return false;
+		}
+
+		// the progress is written first, so that an interrupted preallocation is repeated
+		if (!writePlotFileProgress(path_, 0))
+		{
+			log_error(MinerLogger::general, "Could not write the progress of the plot file %s!", path_);
+			return false;
+		}
+
+		file.createFile();
+		file.setSize(size);
+	}
+	else
+		log_information(MinerLogger::general, "Resuming the plot file %s at nonce %s of %s", path_,
+			numberToString(noncesWritten), numberToString(nonces_));
+
+	log_information(MinerLogger::general, "Plotting %s with %s threads (%s)", path_, std::to_string(threads_),
+		PlotGeneratorArena::getInstructionSet());
+
+	std::vector<char> windows[2];
+	char* buffers[2] = {
+		alignBuffer(windows[0], windowNonces_ * Settings::PlotSize),
+		alignBuffer(windows[1], windowNonces_ * Settings::PlotSize)
+	};
+
+	std::future<bool> pendingWrite;
+	Poco::Timestamp start;
+	Poco::UInt64 noncesGenerated = 0;
+	auto lastPercent = noncesWritten * 100 / nonces_;
+	size_t window = 0;
+
+	for (auto nonce = noncesWritten; nonce < nonces_; ++window)
+	{
+		const auto nonces = std::min(windowNonces_, nonces_ - nonce);
+		const auto buffer = buffers[window % 2];
+
+		generate(nonce, nonces, buffer, cancel);
+
+		// the other window needs to be written, before it is generated again
+		if (pendingWrite.valid() && !pendingWrite.get())
+			return false;
+
+		if (cancel())
+			return false;
+
+		pendingWrite = std::async(std::launch::async, [this, nonce, nonces, buffer]()
+		{
+			if (!write(nonce, nonces, buffer))
+				return false;
+
+			if (!writePlotFileProgress(path_, nonce + nonces))
+			{
+				log_error(MinerLogger::general, "Could not write the progress of the plot file %s!", path_);
+				return false;
+			}
+
+			return true;
+		});
+
+		nonce += nonces;
+		noncesGenerated += nonces;
+
+		const auto percent = nonce * 100 / nonces_;
+
+		if (percent / 10 != lastPercent / 10)
+			log_information(MinerLogger::general, "Plotting %s: %s%% (%.0f nonces/minute)", path_,
+				numberToString(percent), noncesPerMinute(noncesGenerated, start));
+
+		lastPercent = percent;
+	}
+
+	if (pendingWrite.valid() && !pendingWrite.get())
+		return false;
+
+	Poco::File{path_ + ":stream"}.remove();
+
+	log_success(MinerLogger::general, "Plotted the file %s (%.0f nonces/minute)", path_,
+		noncesPerMinute(noncesGenerated, start));
+
+	return true;
+}
+
+const std::string& Burst::Plotter::getPath() const
+{
+	return path_;
+}
+
+void Burst::Plotter::benchmark(const Poco::UInt64 nonces)
+{
+	Plotter plotter{1, 0, std::max(nonces, NonceAlignment), "", false, 0, 0};
+
+	// the generator of the integrity check runs on one thread and allocates every nonce
+	const auto generatorNonces = std::min<Poco::UInt64>(plotter.nonces_, 256);
+	Poco::Timestamp start;
+
+	for (Poco::UInt64 nonce = 0; nonce < generatorNonces; nonce += Shabal256_SSE2::HashSize)
+		PlotGenerator::generateSse2(plotter.account_, nonce);
+
+	const auto generatorSpeed = noncesPerMinute(generatorNonces, start);
+
+	log_information(MinerLogger::general, "Generator (SSE2, 1 thread): %.0f nonces/minute", generatorSpeed);
+
+	std::vector<char> window;
+	const auto buffer = alignBuffer(window, plotter.nonces_ * Settings::PlotSize);
+
+	start.update();
+	plotter.generate(0, plotter.nonces_, buffer, []() { return false; });
+
+	const auto plotterSpeed = noncesPerMinute(plotter.nonces_, start);
+
+	log_information(MinerLogger::general, "Plotter (%s, %s threads): %.0f nonces/minute (%.2fx)",
+		PlotGeneratorArena::getInstructionSet(), std::to_string(plotter.threads_), plotterSpeed, plotterSpeed / generatorSpeed);
+}
+
+void Burst::Plotter::generate(const Poco::UInt64 nonce, const Poco::UInt64 nonces, char* buffer,
+	const std::function<bool()>& cancel)
+{
+	const auto lanes = PlotGeneratorArena::getLanes();
+	const auto batches = (nonces + lanes - 1) / lanes;
+	const auto windowScoopBytes = nonces * Settings::ScoopSize;
+
+	std::atomic<Poco::UInt64> nextBatch{0};
+	std::vector<std::thread> threads;
+
+	for (auto& arena : arenas_)
+		threads.emplace_back([&]()
+		{
+			for (auto batch = nextBatch++; batch < batches && !cancel(); batch = nextBatch++)
+			{
+				const auto first = batch * lanes;
+
+				// the arena is only allocated by the first batch
+				arena.generate(account_, startNonce_ + nonce + first, lanes);
+
+				// scatter the scoops into the layout of the plot file
+				for (size_t lane = 0; lane < lanes && first + lane < nonces; ++lane)
+				{
+					const auto target = buffer + (first + lane) * Settings::ScoopSize;
+
+					for (size_t scoop = 0; scoop < Settings::ScoopPerPlot; ++scoop)
+						arena.copyScoop(lane, scoop, poc2_, target + scoop * windowScoopBytes);
+				}
+			}
+		});
+
+	for (auto& thread : threads)
+		thread.join();
+}
+
+bool Burst::Plotter::write(const Poco::UInt64 nonce, const Poco::UInt64 nonces, const char* buffer)
+{
+	const auto windowScoopBytes = nonces * Settings::ScoopSize;
+
+	DirectFile directFile{path_, true};
+	std::ofstream stream;
+
+	for (size_t scoop = 0; scoop < Settings::ScoopPerPlot; ++scoop)
+	{
+		const auto offset = (scoop * nonces_ + nonce) * Settings::ScoopSize;
+		const auto source = buffer + scoop * windowScoopBytes;
+
+		if (directFile.write(source, offset, windowScoopBytes))
+			continue;
+
+		// fall back to buffered writing, if the filesystem does not support direct access
+		if (!stream.is_open())
+			stream.open(path_, std::ios::in | std::ios::out | std::ios::binary);
+
+		stream.seekp(offset);
+		stream.write(source, windowScoopBytes);
+
+		if (!stream)
+		{
+			log_error(MinerLogger::general, "Could not write to the plot file %s!", path_);
+			return false;
+		}
+	}
+
+	if (stream.is_open())
+		stream.flush();
+
+	return true;
+}
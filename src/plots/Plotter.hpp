@@ -0,0 +1,94 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include "PlotGenerator.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	/**
+	 * \brief Writes new plot files in the optimized layout (one stagger with all nonces).
+	 * The nonces are generated with the widest SIMD kernel, that is supported by the build and the cpu,
+	 * on all cores. Every thread generates into its own arena, that is allocated once.
+	 * The nonces are collected in windows, that are written with one large (and if possible direct)
+	 * write per scoop, while the next window is generated.
+	 * The progress is stored in <file>:stream, so an interrupted plot file is resumed with the next run.
+	 */
+	class Plotter
+	{
+	public:
+		/**
+		 * \brief The number of nonces, that fill one aligned block per scoop.
+		 * The number of nonces of a plot file and of every window is a multiple of it,
+		 * so all writes are aligned for direct access.
+		 */
+		static constexpr Poco::UInt64 NonceAlignment = 64;
+
+		/**
+		 * \brief Constructor.
+		 * \param account The numeric id of the account.
+		 * \param startNonce The first nonce of the plot file.
+		 * \param nonces The number of nonces, it is rounded down to a multiple of NonceAlignment.
+		 * \param dir The dir of the plot file.
+		 * \param poc2 If true, the plot file has the PoC2 format, otherwise the PoC1 format.
+		 * \param memoryBytes The memory, that is used for the two windows.
+		 * \param threads The number of threads, that generate the nonces (0 = all cores).
+		 */
+		Plotter(Poco::UInt64 account, Poco::UInt64 startNonce, Poco::UInt64 nonces, const std::string& dir, bool poc2,
+			Poco::UInt64 memoryBytes, unsigned threads);
+
+		/**
+		 * \brief Plots the file.
+		 * \param cancel If this returns true, the plotter stops. The progress is kept.
+		 * \return true, if the plot file is complete.
+		 */
+		bool run(const std::function<bool()>& cancel);
+
+		/**
+		 * \brief Returns the path of the plot file.
+		 * \return The path.
+		 */
+		const std::string& getPath() const;
+
+		/**
+		 * \brief Compares the speed of the plotter with the speed of the generator,
+		 * that is used to check the integrity of plot files. Nothing is written.
+		 * \param nonces The number of nonces, that are generated by the plotter.
+		 */
+		static void benchmark(Poco::UInt64 nonces);
+
+	private:
+		void generate(Poco::UInt64 nonce, Poco::UInt64 nonces, char* buffer, const std::function<bool()>& cancel);
+
+		bool write(Poco::UInt64 nonce, Poco::UInt64 nonces, const char* buffer);
+
+		Poco::UInt64 account_, startNonce_, nonces_, windowNonces_;
+		std::string path_;
+		bool poc2_;
+		unsigned threads_;
+		std::vector<PlotGeneratorArena> arenas_;
+	};
+}
@@ -0,0 +1,201 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "VerificationScheduler.hpp"
+#include "PlotVerifier.hpp"
+#include <deque>
+#include <Poco/Timestamp.h>
+#include <Poco/Timespan.h>
+#include <Poco/ScopedUnlock.h>
+#include <thread>
+
+struct Burst::VerificationScheduler::LocalQueue
+{
+	Poco::FastMutex mutex;
+	std::deque<VerifyNotification::Ptr> notifications;
+};
+
+Burst::VerificationScheduler::VerificationScheduler(size_t queues)
+	: pending_{0}, readers_{0}, verifiers_{0}, sleeping_{0}, wakeUps_{0}, workStealing_{false}
+{
+	if (queues == 0)
+		queues = std::max(1u, std::thread::hardware_concurrency());
+
+	for (size_t i = 0; i < queues; ++i)
+		queues_.emplace_back(std::make_unique<LocalQueue>());
+}
+
+Burst::VerificationScheduler::~VerificationScheduler() = default;
+
+size_t Burst::VerificationScheduler::registerReader()
+{
+	return readers_++ % queues_.size();
+}
+
+void Burst::VerificationScheduler::setWorkStealing(const bool workStealing)
+{
+	workStealing_ = workStealing;
+}
+
+size_t Burst::VerificationScheduler::registerVerifier()
+{
+	return verifiers_++ % queues_.size();
+}
+
+void Burst::VerificationScheduler::enqueue(VerifyNotification::Ptr notification, const size_t queue)
+{
+	if (!workStealing_)
+	{
+		sharedQueue_.enqueueNotification(notification);
+		return;
+	}
+
+	auto& localQueue = *queues_[queue % queues_.size()];
+
+	{
+		Poco::FastMutex::ScopedLock lock{localQueue.mutex};
+		localQueue.notifications.emplace_back(std::move(notification));
+	}
+
+	++pending_;
+
+	// a verifier, that goes to sleep, registers itself before it checks the pending notifications,
+	// so either it sees this notification or we see the sleeping verifier
+	if (sleeping_ > 0)
+	{
+		Poco::FastMutex::ScopedLock lock{sleepMutex_};
+		available_.signal();
+	}
+}
+
+Burst::VerifyNotification::Ptr Burst::VerificationScheduler::dequeue(const size_t homeQueue)
+{
+	if (!workStealing_)
+	{
+		Poco::Notification::Ptr notification(sharedQueue_.dequeueNotification());
+		return notification.cast<VerifyNotification>();
+	}
+
+	if (pending_ == 0)
+		return nullptr;
+
+	// first the home queue, then steal from the others
+	for (size_t i = 0; i < queues_.size(); ++i)
+	{
+		auto& localQueue = *queues_[(homeQueue + i) % queues_.size()];
+		Poco::FastMutex::ScopedLock lock{localQueue.mutex};
+
+		if (!localQueue.notifications.empty())
+		{
+			auto notification = std::move(localQueue.notifications.front());
+			localQueue.notifications.pop_front();
+			--pending_;
+			return notification;
+		}
+	}
+
+	return nullptr;
+}
+
+Burst::VerifyNotification::Ptr Burst::VerificationScheduler::waitDequeue(const size_t homeQueue, const long milliseconds)
+{
+	if (!workStealing_)
+	{
+		Poco::Notification::Ptr notification(sharedQueue_.waitDequeueNotification(milliseconds));
+		return notification.cast<VerifyNotification>();
+	}
+
+	auto notification = dequeue(homeQueue);
+
+	if (notification)
+		return notification;
+
+	const auto until = Poco::Timestamp{} + Poco::Timespan{milliseconds * 1000};
+	Poco::FastMutex::ScopedLock lock{sleepMutex_};
+	const auto wakeUps = wakeUps_;
+
+	// a verifier, that was signaled, can lose the notification to a stealing one,
+	// so it sleeps again until the time is over
+	while (wakeUps_ == wakeUps)
+	{
+		++sleeping_;
+
+		while (pending_ == 0 && wakeUps_ == wakeUps)
+		{
+			const auto remaining = until - Poco::Timestamp{};
+
+			if (remaining <= 0 || !available_.tryWait(sleepMutex_, static_cast<long>(remaining / 1000) + 1))
+				break;
+		}
+
+		--sleeping_;
+
+		if (wakeUps_ != wakeUps)
+			break;
+
+		// the queues are locked without the sleep mutex, so an enqueue can signal in the meantime
+		{
+			Poco::ScopedUnlock<Poco::FastMutex> unlock{sleepMutex_};
+			notification = dequeue(homeQueue);
+		}
+
+		if (notification || until <= Poco::Timestamp{})
+			return notification;
+	}
+
+	return nullptr;
+}
+
+void Burst::VerificationScheduler::wakeUpAll()
+{
+	sharedQueue_.wakeUpAll();
+
+	Poco::FastMutex::ScopedLock lock{sleepMutex_};
+	++wakeUps_;
+	available_.broadcast();
+}
+
+void Burst::VerificationScheduler::setFusedVerifier(FusedVerifyFunction verifier)
+{
+	std::shared_ptr<FusedVerifyFunction> fusedVerifier;
+
+	if (verifier)
+		fusedVerifier = std::make_shared<FusedVerifyFunction>(std::move(verifier));
+
+	std::atomic_store(&fusedVerifier_, fusedVerifier);
+}
+
+bool Burst::VerificationScheduler::verifyFused(const VerifyNotification::Ptr& notification,
+	const std::function<bool()>& cancelled) const
+{
+	const auto fusedVerifier = std::atomic_load(&fusedVerifier_);
+
+	if (fusedVerifier == nullptr)
+		return false;
+
+	(*fusedVerifier)(notification, cancelled);
+	return true;
+}
+
+size_t Burst::VerificationScheduler::size() const
+{
+	return workStealing_ ? pending_.load() : static_cast<size_t>(sharedQueue_.size());
+}
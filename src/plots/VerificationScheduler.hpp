@@ -0,0 +1,144 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <Poco/AutoPtr.h>
+#include <Poco/Condition.h>
+#include <Poco/Mutex.h>
+#include <Poco/NotificationQueue.h>
+#include <Poco/Types.h>
+
+namespace Burst
+{
+	struct VerifyNotification;
+
+	/**
+	 * \brief Distributes the read scoops from the plot readers to the verifiers.
+	 * By default all readers and verifiers share one single queue.
+	 * With work stealing every reader pushes into its own local queue and every verifier takes first
+	 * from its home queue and steals from the other queues, when its home queue is empty.
+	 * So the readers and verifiers do not fight for one single lock.
+	 */
+	class VerificationScheduler
+	{
+	public:
+		/**
+		 * \brief A function, that verifies a chunk in the thread of the reader.
+		 * The second parameter returns true, if the reader was cancelled.
+		 */
+		using FusedVerifyFunction = std::function<void(Poco::AutoPtr<VerifyNotification>, const std::function<bool()>&)>;
+
+		/**
+		 * \brief Constructor.
+		 * \param queues The number of local queues, 0 for one queue per logical cpu core.
+		 */
+		explicit VerificationScheduler(size_t queues = 0);
+		~VerificationScheduler();
+
+		VerificationScheduler(const VerificationScheduler&) = delete;
+		VerificationScheduler& operator=(const VerificationScheduler&) = delete;
+
+		/**
+		 * \brief Returns the local queue for a new reader.
+		 * \return The index of the local queue.
+		 */
+		size_t registerReader();
+
+		/**
+		 * \brief Switches between the single shared queue and the local queues with work stealing.
+		 * Must only be called, while no reader or verifier is running.
+		 * \param workStealing If true, the local queues are used.
+		 */
+		void setWorkStealing(bool workStealing);
+
+		/**
+		 * \brief Returns the home queue for a new verifier.
+		 * \return The index of the home queue.
+		 */
+		size_t registerVerifier();
+
+		/**
+		 * \brief Pushes a read notification into a local queue and wakes up a sleeping verifier.
+		 * \param notification The notification.
+		 * \param queue The index of the local queue (see registerReader).
+		 */
+		void enqueue(Poco::AutoPtr<VerifyNotification> notification, size_t queue);
+
+		/**
+		 * \brief Takes a notification without waiting.
+		 * \param homeQueue The index of the queue, that is searched first (see registerVerifier).
+		 * \return The notification, nullptr if all queues are empty.
+		 */
+		Poco::AutoPtr<VerifyNotification> dequeue(size_t homeQueue);
+
+		/**
+		 * \brief Takes a notification and waits, until one is available.
+		 * \param homeQueue The index of the queue, that is searched first (see registerVerifier).
+		 * \param milliseconds The max. time to wait.
+		 * \return The notification, nullptr if the time is over or the verifiers were woken up by wakeUpAll.
+		 */
+		Poco::AutoPtr<VerifyNotification> waitDequeue(size_t homeQueue, long milliseconds);
+
+		/**
+		 * \brief Wakes up all waiting verifiers, their waitDequeue returns nullptr.
+		 */
+		void wakeUpAll();
+
+		/**
+		 * \brief Sets the function, that is used by the readers to verify their chunks themselves.
+		 * \param verifier The function, nullptr if the chunks have to be given to the verifiers.
+		 */
+		void setFusedVerifier(FusedVerifyFunction verifier);
+
+		/**
+		 * \brief Verifies a chunk in the calling thread, while the scoops are still in its cache.
+		 * \param notification The chunk.
+		 * \param cancelled Returns true, if the verification has to be stopped.
+		 * \return true, if the chunk was verified, false if there is no fused verifier.
+		 */
+		bool verifyFused(const Poco::AutoPtr<VerifyNotification>& notification, const std::function<bool()>& cancelled) const;
+
+		/**
+		 * \brief Returns the number of notifications in all queues.
+		 * \return The number of notifications.
+		 */
+		size_t size() const;
+
+	private:
+		struct LocalQueue;
+
+		std::vector<std::unique_ptr<LocalQueue>> queues_;
+		std::atomic<size_t> pending_;
+		std::atomic<size_t> readers_, verifiers_;
+		std::atomic<int> sleeping_;
+		Poco::UInt64 wakeUps_;
+		Poco::FastMutex sleepMutex_;
+		Poco::Condition available_;
+		std::shared_ptr<FusedVerifyFunction> fusedVerifier_;
+		bool workStealing_;
+		Poco::NotificationQueue sharedQueue_;
+	};
+}
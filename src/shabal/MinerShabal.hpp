@@ -24,8 +24,10 @@
 #include <memory>
 
 #include "shabal/impl/mshabal_avx2_impl.hpp"
+#include "shabal/impl/mshabal_avx512_impl.hpp"
 #include "shabal/impl/mshabal_avx_impl.hpp"
 #include "shabal/impl/mshabal_sse4_impl.hpp"
+#include "shabal/impl/mshabal_sse2_impl.hpp"
 #include "shabal/impl/sphlib_impl.hpp"
 #include <Poco/ByteOrder.h>
 
@@ -64,8 +66,21 @@ namespace Burst
 		typename TAlgorithm::context_t context_;
 	};
 
+	using Shabal256_AVX512 = Shabal256_Shell<Mshabal_avx512_Impl>;
 	using Shabal256_AVX2 = Shabal256_Shell<Mshabal_avx2_Impl>;
 	using Shabal256_AVX = Shabal256_Shell<Mshabal_avx_Impl>;
 	using Shabal256_SSE4 = Shabal256_Shell<Mshabal_sse4_Impl>;
-	using Shabal256_SSE2 = Shabal256_Shell<Sphlib_Impl>;
+
+	/**
+	 * \brief The scalar sphlib implementation.
+	 * Only used as the reference for the SIMD implementations and
+	 * on platforms without SSE2.
+	 */
+	using Shabal256_Sphlib = Shabal256_Shell<Sphlib_Impl>;
+
+#ifdef USE_SSE2
+	using Shabal256_SSE2 = Shabal256_Shell<Mshabal_sse2_Impl>;
+#else
+	using Shabal256_SSE2 = Shabal256_Sphlib;
+#endif
 }
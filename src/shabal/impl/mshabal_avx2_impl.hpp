@@ -22,6 +22,7 @@
 #pragma once
 
 #include "shabal/mshabal/mshabal.h"
+#include "shabal/mshabal/mshabal_deadline.h"
 
 namespace Burst
 {
@@ -30,6 +31,8 @@ namespace Burst
 		static constexpr size_t HashSize = 8;
 
 		using context_t = mshabal256_context;
+		using deadline_context_t = mshabal_deadline_context;
+		static constexpr size_t DeadlineLanes = 8;
 
 		static void init(context_t& context)
 		{
@@ -62,6 +65,17 @@ namespace Burst
 			avx2_mshabal_close(&context, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 			                   out1, out2, out3, out4, out5, out6, out7, out8);
 		}
+
+		static void initDeadline(deadline_context_t& context, const void* gensig)
+		{
+			mshabal_deadline_init(&context, gensig);
+		}
+
+		static void calculateTargets(const deadline_context_t& context, const void* scoops, size_t count,
+		                             unsigned long long* targets)
+		{
+			avx2_mshabal_deadline(&context, scoops, count, targets);
+		}
 	};
 }
 
@@ -74,4 +88,7 @@ inline void avx2_mshabal(mshabal256_context* sc, const void* data0, const void*
 inline void avx2_mshabal_close(mshabal256_context* sc, unsigned ub0, unsigned ub1, unsigned ub2, unsigned ub3, unsigned ub4,
                         unsigned ub5, unsigned ub6, unsigned ub7, unsigned n, void* dst0, void* dst1, void* dst2,
                         void* dst3, void* dst4, void* dst5, void* dst6, void* dst7) {}
+
+inline void avx2_mshabal_deadline(const mshabal_deadline_context* dc, const void* scoops, size_t count,
+                         unsigned long long* targets) {}
 #endif
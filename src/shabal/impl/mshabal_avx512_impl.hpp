@@ -0,0 +1,106 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "shabal/mshabal/mshabal.h"
+#include "shabal/mshabal/mshabal_deadline.h"
+
+namespace Burst
+{
+	struct Mshabal_avx512_Impl
+	{
+		static constexpr size_t HashSize = 16;
+
+		using context_t = mshabal512_context;
+		using deadline_context_t = mshabal_deadline_context;
+		static constexpr size_t DeadlineLanes = 16;
+
+		static void init(context_t& context)
+		{
+			avx512_mshabal_init(&context, 256);
+		}
+
+		static void update(context_t& context, const void* data, size_t length)
+		{
+			update(context, data, data, data, data, data, data, data, data,
+			       data, data, data, data, data, data, data, data, length);
+		}
+
+		static void update(context_t& context,
+		                   const void* data1, const void* data2, const void* data3, const void* data4,
+		                   const void* data5, const void* data6, const void* data7, const void* data8,
+		                   const void* data9, const void* data10, const void* data11, const void* data12,
+		                   const void* data13, const void* data14, const void* data15, const void* data16,
+		                   size_t length)
+		{
+			const void* const data[] = {
+				data1, data2, data3, data4, data5, data6, data7, data8,
+				data9, data10, data11, data12, data13, data14, data15, data16
+			};
+
+			avx512_mshabal(&context, data, length);
+		}
+
+		static void close(context_t& context, void* output)
+		{
+			close(context, output, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+			      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+		}
+
+		static void close(context_t& context,
+		                  void* out1, void* out2, void* out3, void* out4,
+		                  void* out5, void* out6, void* out7, void* out8,
+		                  void* out9, void* out10, void* out11, void* out12,
+		                  void* out13, void* out14, void* out15, void* out16)
+		{
+			void* const out[] = {
+				out1, out2, out3, out4, out5, out6, out7, out8,
+				out9, out10, out11, out12, out13, out14, out15, out16
+			};
+
+			avx512_mshabal_close(&context, nullptr, 0, out);
+		}
+
+		static void initDeadline(deadline_context_t& context, const void* gensig)
+		{
+			mshabal_deadline_init(&context, gensig);
+		}
+
+		static void calculateTargets(const deadline_context_t& context, const void* scoops, size_t count,
+		                             unsigned long long* targets)
+		{
+			avx512_mshabal_deadline(&context, scoops, count, targets);
+		}
+	};
+}
+
+#ifndef USE_AVX512
+inline void avx512_mshabal_init(mshabal512_context* sc, unsigned out_size) {}
+
+inline void avx512_mshabal(mshabal512_context* sc, const void* const data[MSHABAL512_LANES], size_t len) {}
+
+inline void avx512_mshabal_close(mshabal512_context* sc, const unsigned ub[MSHABAL512_LANES], unsigned n,
+                          void* const dst[MSHABAL512_LANES]) {}
+
+inline void avx512_mshabal_deadline(const mshabal_deadline_context* dc, const void* scoops, size_t count,
+                           unsigned long long* targets) {}
+#endif
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "shabal/mshabal/mshabal.h"
+#include "shabal/mshabal/mshabal_deadline.h"
 
 namespace Burst
 {
@@ -30,6 +31,8 @@ namespace Burst
 		static constexpr size_t HashSize = 4;
 
 		using context_t = mshabal_context;
+		using deadline_context_t = mshabal_deadline_context;
+		static constexpr size_t DeadlineLanes = 4;
 
 		static void init(context_t& context)
 		{
@@ -58,6 +61,17 @@ namespace Burst
 		{
 			avx1_mshabal_close(&context, 0, 0, 0, 0, 0, out1, out2, out3, out4);
 		}
+
+		static void initDeadline(deadline_context_t& context, const void* gensig)
+		{
+			mshabal_deadline_init(&context, gensig);
+		}
+
+		static void calculateTargets(const deadline_context_t& context, const void* scoops, size_t count,
+		                             unsigned long long* targets)
+		{
+			avx1_mshabal_deadline(&context, scoops, count, targets);
+		}
 	};
 }
 
@@ -69,4 +83,7 @@ inline void avx1_mshabal(mshabal_context* sc, const void* data0, const void* dat
 
 inline void avx1_mshabal_close(mshabal_context* sc, unsigned ub0, unsigned ub1, unsigned ub2, unsigned ub3, unsigned n,
                         void* dst0, void* dst1, void* dst2, void* dst3) {}
+
+inline void avx1_mshabal_deadline(const mshabal_deadline_context* dc, const void* scoops, size_t count,
+                         unsigned long long* targets) {}
 #endif
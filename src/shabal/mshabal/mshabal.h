@@ -84,6 +84,7 @@ extern "C" {
 #endif
 
 #define MSHABAL256_FACTOR 2
+#define MSHABAL512_LANES 16
 
 	/*
 	* The context structure for a Shabal computation. Contents are
@@ -121,6 +122,26 @@ extern "C" {
 		unsigned out_size;
 	} mshabal256_context;
 
+	/*
+	* The context structure for a Shabal computation with sixteen parallel
+	* instances (AVX-512). Contents are private. Such a structure should be
+	* allocated and released by the caller, in any memory area.
+	*/
+	typedef struct {
+		unsigned char buf[MSHABAL512_LANES][64];
+		size_t ptr;
+		mshabal_u32 state[(12 + 16 + 16) * MSHABAL512_LANES];
+		mshabal_u32 Whigh, Wlow;
+		unsigned out_size;
+	} mshabal512_context;
+
+	/*
+	* Initialize a context structure. The output size must be a multiple
+	* of 32, between 32 and 512 (inclusive). The output size is expressed
+	* in bits.
+	*/
+	void sse2_mshabal_init(mshabal_context *sc, unsigned out_size);
+
 	/*
 	* Initialize a context structure. The output size must be a multiple
 	* of 32, between 32 and 512 (inclusive). The output size is expressed
@@ -142,6 +163,27 @@ extern "C" {
 	*/
 	void avx2_mshabal_init(mshabal256_context *sc, unsigned out_size);
 
+	/*
+	* Initialize a context structure. The output size must be a multiple
+	* of 32, between 32 and 512 (inclusive). The output size is expressed
+	* in bits.
+	*/
+	void avx512_mshabal_init(mshabal512_context *sc, unsigned out_size);
+
+	/*
+	* Process some more data bytes; four chunks of data, pointed to by
+	* data0, data1, data2 and data3, are processed. The four chunks have
+	* the same length of "len" bytes. For efficiency, it is best if data is
+	* processed by medium-sized chunks, e.g. a few kilobytes at a time.
+	*
+	* The "len" data bytes shall all be accessible. If "len" is zero, this
+	* this function does nothing and ignores the data* arguments.
+	* Otherwise, if one of the data* argument is NULL, then the
+	* corresponding instance is deactivated (the final value obtained from
+	* that instance is undefined).
+	*/
+	void sse2_mshabal(mshabal_context *sc, const void *data0, const void *data1, const void *data2, const void *data3, size_t len);
+
 	/*
 	* Process some more data bytes; four chunks of data, pointed to by
 	* data0, data1, data2 and data3, are processed. The four chunks have
@@ -187,6 +229,37 @@ extern "C" {
 		const void *data4, const void *data5, const void *data6, const void *data7,
 		size_t len);
 
+	/*
+	* Process some more data bytes; sixteen chunks of data, pointed to by
+	* data[0] to data[15], are processed. The semantics are the same as
+	* for avx2_mshabal().
+	*/
+	void avx512_mshabal(mshabal512_context *sc, const void *const data[MSHABAL512_LANES], size_t len);
+
+	/*
+	* Terminate the Shabal computation incarnated by the provided context
+	* structure. "n" shall be a value between 0 and 7 (inclusive): this is
+	* the number of extra bits to extract from ub0, ub1, ub2 and ub3, and
+	* append at the end of the input message for each of the four parallel
+	* instances. Bits in "ub*" are taken in big-endian format: first bit is
+	* the one of numerical value 128, second bit has numerical value 64,
+	* and so on. Other bits in "ub*" are ignored. For most applications,
+	* input messages will consist in sequence of bytes, and the "ub*" and
+	* "n" parameters will be zero.
+	*
+	* The Shabal output for each of the parallel instances is written out
+	* in the areas pointed to by, respectively, dst0, dst1, dst2 and dst3.
+	* These areas shall be wide enough to accomodate the result (result
+	* size was specified as parameter to mshabal_init()). It is acceptable
+	* to use NULL for any of those pointers, if the result from the
+	* corresponding instance is not needed.
+	*
+	* After this call, the context structure is invalid. The caller shall
+	* release it, or reinitialize it with mshabal_init(). The mshabal_close()
+	* function does NOT imply a hidden call to mshabal_init().
+	*/
+	void sse2_mshabal_close(mshabal_context *sc, unsigned ub0, unsigned ub1, unsigned ub2, unsigned ub3, unsigned n, void *dst0, void *dst1, void *dst2, void *dst3);
+
 	/*
 	* Terminate the Shabal computation incarnated by the provided context
 	* structure. "n" shall be a value between 0 and 7 (inclusive): this is
@@ -264,6 +337,15 @@ extern "C" {
 		void *dst0, void *dst1, void *dst2, void *dst3,
 		void *dst4, void *dst5, void *dst6, void *dst7);
 
+	/*
+	* Terminate the Shabal computation of the sixteen parallel instances.
+	* The semantics are the same as for avx2_mshabal_close(), with the extra
+	* bits in ub[0] to ub[15] and the outputs in dst[0] to dst[15]. Every
+	* dst entry may be NULL.
+	*/
+	void avx512_mshabal_close(mshabal512_context *sc, const unsigned ub[MSHABAL512_LANES], unsigned n,
+		void *const dst[MSHABAL512_LANES]);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -533,4 +533,52 @@ extern "C" {
 
 #ifdef  __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
+
+/*
+* The fixed length deadline kernel, see mshabal_deadline.h.
+*/
+#include "mshabal_deadline_impl.hpp"
+
+namespace
+{
+	struct MshabalDeadlineOps256
+	{
+		typedef __m256i vector_t;
+		static const size_t Lanes = 8;
+
+		static inline __m256i set1(mshabal_u32 x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+		static inline __m256i add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+		static inline __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+		static inline __m256i xor_(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+		static inline __m256i or_(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+		static inline __m256i andnot(__m256i a, __m256i b) { return _mm256_andnot_si256(a, b); }
+
+		template <int N>
+		static inline __m256i slli(__m256i a) { return _mm256_slli_epi32(a, N); }
+
+		template <int N>
+		static inline __m256i srli(__m256i a) { return _mm256_srli_epi32(a, N); }
+
+		static inline void load(const unsigned char *scoops, __m256i *words)
+		{
+			/* the scoops of the lanes are 16 words apart */
+			const __m256i index = _mm256_set_epi32(112, 96, 80, 64, 48, 32, 16, 0);
+
+			for (size_t j = 0; j < 16; j++)
+				words[j] = _mm256_i32gather_epi32(reinterpret_cast<const int*>(scoops) + j, index, 4);
+		}
+
+		static inline void store(__m256i a, mshabal_u32 *words)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(words), a);
+		}
+	};
+}
+
+extern "C" void
+	avx2_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets)
+{
+	MshabalDeadline<MshabalDeadlineOps256>::run(dc, scoops, count, targets);
+}
@@ -0,0 +1,404 @@
+/*
+* Parallel implementation of Shabal, using the AVX-512 unit. Sixteen
+* instances are computed at once, one in every 32 bit lane of a 512 bit
+* register. This code compiles and runs on x86-64 architectures, which
+* possess the AVX-512 foundation instructions (AVX512F).
+*
+* Based on the SSE2 implementation:
+*
+* (c) 2010 SAPHIR project. This software is provided 'as-is', without
+* any epxress or implied warranty. In no event will the authors be held
+* liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to no restriction.
+*
+* Technical remarks and questions can be addressed to:
+* <thomas.pornin@cryptolog.com>
+*/
+
+#include <stddef.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "mshabal.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4146)
+#endif
+
+	typedef mshabal_u32 u32;
+
+#define C32(x)         ((u32)x ## UL)
+#define LANES          MSHABAL512_LANES
+
+	static void
+		mshabal512_compress(mshabal512_context *sc, const unsigned char *const buf[LANES], size_t num)
+	{
+		union {
+			u32 words[16 * LANES];
+			__m512i data[16];
+		} u;
+		const unsigned char *src[LANES];
+		size_t j, k;
+		__m512i A[12], B[16], C[16];
+		__m512i one;
+
+		for (k = 0; k < LANES; k++)
+			src[k] = buf[k];
+
+		for (j = 0; j < 12; j++)
+			A[j] = _mm512_loadu_si512((__m512i *)sc->state + j);
+		for (j = 0; j < 16; j++) {
+			B[j] = _mm512_loadu_si512((__m512i *)sc->state + j + 12);
+			C[j] = _mm512_loadu_si512((__m512i *)sc->state + j + 28);
+		}
+		one = _mm512_set1_epi32(C32(0xFFFFFFFF));
+
+#define M(i)   _mm512_load_si512(u.data + (i))
+
+		while (num-- > 0) {
+
+			for (j = 0; j < 16; j++)
+				for (k = 0; k < LANES; k++)
+					memcpy(&u.words[j * LANES + k], src[k] + 4 * j, sizeof(u32));
+
+			for (j = 0; j < 16; j++)
+				B[j] = _mm512_add_epi32(B[j], M(j));
+
+			A[0] = _mm512_xor_si512(A[0], _mm512_set1_epi32(sc->Wlow));
+			A[1] = _mm512_xor_si512(A[1], _mm512_set1_epi32(sc->Whigh));
+
+			for (j = 0; j < 16; j++)
+				B[j] = _mm512_rol_epi32(B[j], 17);
+
+			/*
+			* The rotations map to vprold and the xor/andnot chain of the
+			* B words to a single ternary logic instruction:
+			* 0x96 = a ^ b ^ c, 0xD2 = a ^ (~b & c).
+			*/
+#define PP(xa0, xa1, xb0, xb1, xb2, xb3, xc, xm)   do { \
+    __m512i tt; \
+    tt = _mm512_rol_epi32(xa1, 15); \
+    tt = _mm512_add_epi32(_mm512_slli_epi32(tt, 2), tt); \
+    tt = _mm512_ternarylogic_epi32(xa0, tt, xc, 0x96); \
+    tt = _mm512_add_epi32(_mm512_slli_epi32(tt, 1), tt); \
+    tt = _mm512_ternarylogic_epi32(_mm512_xor_si512(tt, xb1), xb3, xb2, 0xD2); \
+    xa0 = _mm512_xor_si512(tt, xm); \
+    xb0 = _mm512_ternarylogic_epi32(_mm512_rol_epi32(xb0, 1), xa0, one, 0x96); \
+        } while (0)
+
+			PP(A[0x0], A[0xB], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M(0x0));
+			PP(A[0x1], A[0x0], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M(0x1));
+			PP(A[0x2], A[0x1], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M(0x2));
+			PP(A[0x3], A[0x2], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M(0x3));
+			PP(A[0x4], A[0x3], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M(0x4));
+			PP(A[0x5], A[0x4], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M(0x5));
+			PP(A[0x6], A[0x5], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M(0x6));
+			PP(A[0x7], A[0x6], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M(0x7));
+			PP(A[0x8], A[0x7], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M(0x8));
+			PP(A[0x9], A[0x8], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M(0x9));
+			PP(A[0xA], A[0x9], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M(0xA));
+			PP(A[0xB], A[0xA], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M(0xB));
+			PP(A[0x0], A[0xB], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M(0xC));
+			PP(A[0x1], A[0x0], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M(0xD));
+			PP(A[0x2], A[0x1], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M(0xE));
+			PP(A[0x3], A[0x2], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M(0xF));
+
+			PP(A[0x4], A[0x3], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M(0x0));
+			PP(A[0x5], A[0x4], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M(0x1));
+			PP(A[0x6], A[0x5], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M(0x2));
+			PP(A[0x7], A[0x6], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M(0x3));
+			PP(A[0x8], A[0x7], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M(0x4));
+			PP(A[0x9], A[0x8], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M(0x5));
+			PP(A[0xA], A[0x9], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M(0x6));
+			PP(A[0xB], A[0xA], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M(0x7));
+			PP(A[0x0], A[0xB], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M(0x8));
+			PP(A[0x1], A[0x0], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M(0x9));
+			PP(A[0x2], A[0x1], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M(0xA));
+			PP(A[0x3], A[0x2], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M(0xB));
+			PP(A[0x4], A[0x3], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M(0xC));
+			PP(A[0x5], A[0x4], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M(0xD));
+			PP(A[0x6], A[0x5], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M(0xE));
+			PP(A[0x7], A[0x6], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M(0xF));
+
+			PP(A[0x8], A[0x7], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M(0x0));
+			PP(A[0x9], A[0x8], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M(0x1));
+			PP(A[0xA], A[0x9], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M(0x2));
+			PP(A[0xB], A[0xA], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M(0x3));
+			PP(A[0x0], A[0xB], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M(0x4));
+			PP(A[0x1], A[0x0], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M(0x5));
+			PP(A[0x2], A[0x1], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M(0x6));
+			PP(A[0x3], A[0x2], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M(0x7));
+			PP(A[0x4], A[0x3], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M(0x8));
+			PP(A[0x5], A[0x4], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M(0x9));
+			PP(A[0x6], A[0x5], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M(0xA));
+			PP(A[0x7], A[0x6], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M(0xB));
+			PP(A[0x8], A[0x7], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M(0xC));
+			PP(A[0x9], A[0x8], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M(0xD));
+			PP(A[0xA], A[0x9], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M(0xE));
+			PP(A[0xB], A[0xA], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M(0xF));
+
+			A[0xB] = _mm512_add_epi32(A[0xB], C[0x6]);
+			A[0xA] = _mm512_add_epi32(A[0xA], C[0x5]);
+			A[0x9] = _mm512_add_epi32(A[0x9], C[0x4]);
+			A[0x8] = _mm512_add_epi32(A[0x8], C[0x3]);
+			A[0x7] = _mm512_add_epi32(A[0x7], C[0x2]);
+			A[0x6] = _mm512_add_epi32(A[0x6], C[0x1]);
+			A[0x5] = _mm512_add_epi32(A[0x5], C[0x0]);
+			A[0x4] = _mm512_add_epi32(A[0x4], C[0xF]);
+			A[0x3] = _mm512_add_epi32(A[0x3], C[0xE]);
+			A[0x2] = _mm512_add_epi32(A[0x2], C[0xD]);
+			A[0x1] = _mm512_add_epi32(A[0x1], C[0xC]);
+			A[0x0] = _mm512_add_epi32(A[0x0], C[0xB]);
+			A[0xB] = _mm512_add_epi32(A[0xB], C[0xA]);
+			A[0xA] = _mm512_add_epi32(A[0xA], C[0x9]);
+			A[0x9] = _mm512_add_epi32(A[0x9], C[0x8]);
+			A[0x8] = _mm512_add_epi32(A[0x8], C[0x7]);
+			A[0x7] = _mm512_add_epi32(A[0x7], C[0x6]);
+			A[0x6] = _mm512_add_epi32(A[0x6], C[0x5]);
+			A[0x5] = _mm512_add_epi32(A[0x5], C[0x4]);
+			A[0x4] = _mm512_add_epi32(A[0x4], C[0x3]);
+			A[0x3] = _mm512_add_epi32(A[0x3], C[0x2]);
+			A[0x2] = _mm512_add_epi32(A[0x2], C[0x1]);
+			A[0x1] = _mm512_add_epi32(A[0x1], C[0x0]);
+			A[0x0] = _mm512_add_epi32(A[0x0], C[0xF]);
+			A[0xB] = _mm512_add_epi32(A[0xB], C[0xE]);
+			A[0xA] = _mm512_add_epi32(A[0xA], C[0xD]);
+			A[0x9] = _mm512_add_epi32(A[0x9], C[0xC]);
+			A[0x8] = _mm512_add_epi32(A[0x8], C[0xB]);
+			A[0x7] = _mm512_add_epi32(A[0x7], C[0xA]);
+			A[0x6] = _mm512_add_epi32(A[0x6], C[0x9]);
+			A[0x5] = _mm512_add_epi32(A[0x5], C[0x8]);
+			A[0x4] = _mm512_add_epi32(A[0x4], C[0x7]);
+			A[0x3] = _mm512_add_epi32(A[0x3], C[0x6]);
+			A[0x2] = _mm512_add_epi32(A[0x2], C[0x5]);
+			A[0x1] = _mm512_add_epi32(A[0x1], C[0x4]);
+			A[0x0] = _mm512_add_epi32(A[0x0], C[0x3]);
+
+#define SWAP_AND_SUB(xb, xc, xm)   do { \
+    __m512i tmp; \
+    tmp = xb; \
+    xb = _mm512_sub_epi32(xc, xm); \
+    xc = tmp; \
+        } while (0)
+
+			SWAP_AND_SUB(B[0x0], C[0x0], M(0x0));
+			SWAP_AND_SUB(B[0x1], C[0x1], M(0x1));
+			SWAP_AND_SUB(B[0x2], C[0x2], M(0x2));
+			SWAP_AND_SUB(B[0x3], C[0x3], M(0x3));
+			SWAP_AND_SUB(B[0x4], C[0x4], M(0x4));
+			SWAP_AND_SUB(B[0x5], C[0x5], M(0x5));
+			SWAP_AND_SUB(B[0x6], C[0x6], M(0x6));
+			SWAP_AND_SUB(B[0x7], C[0x7], M(0x7));
+			SWAP_AND_SUB(B[0x8], C[0x8], M(0x8));
+			SWAP_AND_SUB(B[0x9], C[0x9], M(0x9));
+			SWAP_AND_SUB(B[0xA], C[0xA], M(0xA));
+			SWAP_AND_SUB(B[0xB], C[0xB], M(0xB));
+			SWAP_AND_SUB(B[0xC], C[0xC], M(0xC));
+			SWAP_AND_SUB(B[0xD], C[0xD], M(0xD));
+			SWAP_AND_SUB(B[0xE], C[0xE], M(0xE));
+			SWAP_AND_SUB(B[0xF], C[0xF], M(0xF));
+
+			for (k = 0; k < LANES; k++)
+				src[k] += 64;
+			if (++sc->Wlow == 0)
+				sc->Whigh++;
+
+		}
+
+		for (j = 0; j < 12; j++)
+			_mm512_storeu_si512((__m512i *)sc->state + j, A[j]);
+		for (j = 0; j < 16; j++) {
+			_mm512_storeu_si512((__m512i *)sc->state + j + 12, B[j]);
+			_mm512_storeu_si512((__m512i *)sc->state + j + 28, C[j]);
+		}
+
+#undef M
+#undef PP
+#undef SWAP_AND_SUB
+	}
+
+	static void
+		mshabal512_compress_buffers(mshabal512_context *sc)
+	{
+		const unsigned char *buf[LANES];
+		size_t k;
+
+		for (k = 0; k < LANES; k++)
+			buf[k] = sc->buf[k];
+
+		mshabal512_compress(sc, buf, 1);
+	}
+
+	/* see mshabal.h */
+	void
+		avx512_mshabal_init(mshabal512_context *sc, unsigned out_size)
+	{
+		unsigned u, k;
+
+		for (u = 0; u < (12 + 16 + 16) * LANES; u++)
+			sc->state[u] = 0;
+		memset(sc->buf, 0, sizeof sc->buf);
+		for (u = 0; u < 16; u++) {
+			for (k = 0; k < LANES; k++) {
+				sc->buf[k][4 * u + 0] = (out_size + u);
+				sc->buf[k][4 * u + 1] = (out_size + u) >> 8;
+			}
+		}
+		sc->Whigh = sc->Wlow = C32(0xFFFFFFFF);
+		mshabal512_compress_buffers(sc);
+		for (u = 0; u < 16; u++) {
+			for (k = 0; k < LANES; k++) {
+				sc->buf[k][4 * u + 0] = (out_size + u + 16);
+				sc->buf[k][4 * u + 1] = (out_size + u + 16) >> 8;
+			}
+		}
+		mshabal512_compress_buffers(sc);
+		sc->ptr = 0;
+		sc->out_size = out_size;
+	}
+
+	/* see mshabal.h */
+	void
+		avx512_mshabal(mshabal512_context *sc, const void *const data[LANES], size_t len)
+	{
+		const unsigned char *src[LANES];
+		const void *first = NULL;
+		size_t ptr, num, k;
+
+		for (k = 0; k < LANES && first == NULL; k++)
+			first = data[k];
+
+		if (first == NULL)
+			return;
+
+		/* deactivated instances just process the data of the first active one */
+		for (k = 0; k < LANES; k++)
+			src[k] = (const unsigned char *)(data[k] != NULL ? data[k] : first);
+
+		ptr = sc->ptr;
+		if (ptr != 0) {
+			size_t clen;
+
+			clen = (sizeof sc->buf[0] - ptr);
+			if (clen > len) {
+				for (k = 0; k < LANES; k++)
+					memcpy(sc->buf[k] + ptr, src[k], len);
+				sc->ptr = ptr + len;
+				return;
+			}
+			else {
+				for (k = 0; k < LANES; k++) {
+					memcpy(sc->buf[k] + ptr, src[k], clen);
+					src[k] += clen;
+				}
+				mshabal512_compress_buffers(sc);
+				len -= clen;
+			}
+		}
+
+		num = len >> 6;
+		if (num != 0) {
+			mshabal512_compress(sc, src, num);
+			for (k = 0; k < LANES; k++)
+				src[k] += num << 6;
+		}
+		len &= (size_t)63;
+		for (k = 0; k < LANES; k++)
+			memcpy(sc->buf[k], src[k], len);
+		sc->ptr = len;
+	}
+
+	/* see mshabal.h */
+	void
+		avx512_mshabal_close(mshabal512_context *sc, const unsigned ub[LANES], unsigned n,
+			void *const dst[LANES])
+	{
+		size_t ptr, off, k;
+		unsigned z, out_size_w32;
+
+		z = 0x80 >> n;
+		ptr = sc->ptr;
+		for (k = 0; k < LANES; k++) {
+			sc->buf[k][ptr] = ((ub != NULL ? ub[k] : 0) & -z) | z;
+			memset(sc->buf[k] + ptr + 1, 0, (sizeof sc->buf[k]) - ptr - 1);
+		}
+		for (z = 0; z < 4; z++) {
+			mshabal512_compress_buffers(sc);
+			if (sc->Wlow-- == 0)
+				sc->Whigh--;
+		}
+		out_size_w32 = sc->out_size >> 5;
+		off = LANES * (28 + (16 - out_size_w32));
+		for (k = 0; k < LANES; k++) {
+			u32 *out;
+
+			if (dst[k] == NULL)
+				continue;
+
+			out = (u32*)dst[k];
+			for (z = 0; z < out_size_w32; z++)
+				out[z] = sc->state[off + LANES * z + k];
+		}
+	}
+
+#undef LANES
+
+#ifdef  __cplusplus
+}
+#endif
+
+/*
+* The fixed length deadline kernel, see mshabal_deadline.h.
+*/
+#include "mshabal_deadline_impl.hpp"
+
+namespace
+{
+	struct MshabalDeadlineOps512
+	{
+		typedef __m512i vector_t;
+		static const size_t Lanes = 16;
+
+		static inline __m512i set1(mshabal_u32 x) { return _mm512_set1_epi32(static_cast<int>(x)); }
+		static inline __m512i add(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
+		static inline __m512i sub(__m512i a, __m512i b) { return _mm512_sub_epi32(a, b); }
+		static inline __m512i xor_(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+		static inline __m512i or_(__m512i a, __m512i b) { return _mm512_or_si512(a, b); }
+		static inline __m512i andnot(__m512i a, __m512i b) { return _mm512_andnot_si512(a, b); }
+
+		template <int N>
+		static inline __m512i slli(__m512i a) { return _mm512_slli_epi32(a, N); }
+
+		template <int N>
+		static inline __m512i srli(__m512i a) { return _mm512_srli_epi32(a, N); }
+
+		static inline void load(const unsigned char *scoops, __m512i *words)
+		{
+			/* the scoops of the lanes are 16 words apart */
+			const __m512i index = _mm512_set_epi32(240, 224, 208, 192, 176, 160, 144, 128,
+				112, 96, 80, 64, 48, 32, 16, 0);
+
+			for (size_t j = 0; j < 16; j++)
+				words[j] = _mm512_i32gather_epi32(index, reinterpret_cast<const int*>(scoops) + j, 4);
+		}
+
+		static inline void store(__m512i a, mshabal_u32 *words)
+		{
+			_mm512_storeu_si512(reinterpret_cast<__m512i*>(words), a);
+		}
+	};
+}
+
+extern "C" void
+	avx512_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets)
+{
+	MshabalDeadline<MshabalDeadlineOps512>::run(dc, scoops, count, targets);
+}
@@ -0,0 +1,65 @@
+/*
+* Gensig dependent precomputation of the fixed length Shabal-256
+* deadline kernels, see mshabal_deadline.h. This part is scalar and
+* compiled without any special instruction set.
+*/
+
+#include <string.h>
+
+#include "mshabal_deadline.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+	typedef mshabal_u32 u32;
+
+#define C32(x)         ((u32)x ## UL)
+#define T32(x)         ((x) & C32(0xFFFFFFFF))
+#define ROTL32(x, n)   T32(((x) << (n)) | ((x) >> (32 - (n))))
+
+	/*
+	* The state of Shabal-256 after the two prefix blocks, the same
+	* as A_init_256, B_init_256 and C_init_256 of sphlib.
+	*/
+	static const u32 A_init_256[] = {
+		C32(0x52F84552), C32(0xE54B7999), C32(0x2D8EE3EC), C32(0xB9645191),
+		C32(0xE0078B86), C32(0xBB7C44C9), C32(0xD2B5C1CA), C32(0xB0D2EB8C),
+		C32(0x14CE5A45), C32(0x22AF50DC), C32(0xEFFDBC6B), C32(0xEB21B74A)
+	};
+
+	static const u32 B_init_256[] = {
+		C32(0xB555C6EE), C32(0x3E710596), C32(0xA72A652F), C32(0x9301515F),
+		C32(0xDA28C1FA), C32(0x696FD868), C32(0x9CB6BF72), C32(0x0AFE4002),
+		C32(0xA6E03615), C32(0x5138C1D4), C32(0xBE216306), C32(0xB38B8890),
+		C32(0x3EA8B96B), C32(0x3299ACE4), C32(0x30924DD4), C32(0x55CB34A5)
+	};
+
+	static const u32 C_init_256[] = {
+		C32(0xB405F031), C32(0xC4233EBA), C32(0xB3733979), C32(0xC0DD9D55),
+		C32(0xC51C28AE), C32(0xA327B8E1), C32(0x56C56167), C32(0xED614433),
+		C32(0x88B59D60), C32(0x60E2CEBA), C32(0x758B4B8B), C32(0x83E82A7F),
+		C32(0xBC968828), C32(0xE6E00BF7), C32(0xBA839E55), C32(0x9B491C60)
+	};
+
+	void
+		mshabal_deadline_init(mshabal_deadline_context *dc, const void *gensig)
+	{
+		size_t j;
+
+		memcpy(dc->A, A_init_256, sizeof dc->A);
+		memcpy(dc->B, B_init_256, sizeof dc->B);
+		memcpy(dc->C, C_init_256, sizeof dc->C);
+		memcpy(dc->M, gensig, sizeof dc->M);
+
+		/* the first message block has the counter W = 1 */
+		dc->A[0] ^= C32(1);
+
+		/* the first eight words of the first message block are the gensig */
+		for (j = 0; j < 8; j++)
+			dc->B[j] = ROTL32(T32(dc->B[j] + dc->M[j]), 17);
+	}
+
+#ifdef  __cplusplus
+}
+#endif
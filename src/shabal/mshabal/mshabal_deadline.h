@@ -0,0 +1,83 @@
+/*
+* Fixed length Shabal-256 for the deadline calculation of Burstcoin.
+*
+* A deadline is always calculated from the same 96 byte message:
+* the 32 byte generation signature of the round followed by a 64 byte
+* scoop. The functions in this file exploit that:
+*
+*  - mshabal_deadline_init() precomputes everything, that only depends
+*    on the generation signature (the initial state and the gensig part
+*    of the first message block). It is called once per round.
+*  - <isa>_mshabal_deadline() hashes a run of consecutive scoops with the
+*    two compression rounds and the three finalisation rounds unrolled
+*    and writes out only the first 64 bit word of every digest, which is
+*    the only part the deadline depends on.
+*
+* The results are identical to the first 8 bytes of
+* Shabal256(gensig || scoop), read as a little endian integer.
+*/
+
+#ifndef MSHABAL_DEADLINE_H__
+#define MSHABAL_DEADLINE_H__
+
+#include <stddef.h>
+#include "mshabal.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+	/*
+	* The precomputed, gensig dependent state. It is read only after
+	* mshabal_deadline_init(), so one instance can be shared by threads.
+	*/
+	typedef struct {
+		mshabal_u32 A[12];
+		mshabal_u32 B[16];
+		mshabal_u32 C[16];
+		mshabal_u32 M[8];
+	} mshabal_deadline_context;
+
+	/*
+	* Precomputes the state for a generation signature of 32 bytes.
+	*/
+	void mshabal_deadline_init(mshabal_deadline_context *dc, const void *gensig);
+
+	/*
+	* Hashes "count" consecutive scoops of 64 bytes, starting at "scoops".
+	* For every scoop the first 64 bit word of the digest is written into
+	* "targets". Any count is allowed, the last group of lanes is padded
+	* internally.
+	*/
+	void sse4_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets);
+
+	/*
+	* See sse4_mshabal_deadline(), compiled for the SSE2 baseline.
+	*/
+	void sse2_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets);
+
+	/*
+	* See sse4_mshabal_deadline(), compiled for AVX.
+	*/
+	void avx1_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets);
+
+	/*
+	* See sse4_mshabal_deadline(), with eight lanes for AVX2.
+	*/
+	void avx2_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets);
+
+	/*
+	* See sse4_mshabal_deadline(), with sixteen lanes for AVX-512.
+	*/
+	void avx512_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,238 @@
+/*
+* The SIMD kernel of the fixed length Shabal-256 deadline calculation,
+* see mshabal_deadline.h.
+*
+* This file is included by the mshabal_<isa>.cpp files, that are compiled
+* with the flags of their instruction set. Everything lives in an anonymous
+* namespace, so every translation unit gets its own copy and the linker can
+* never mix the code of two instruction sets.
+*
+* A lane operations type provides the vector type and the needed integer
+* operations:
+*
+*   typedef ... vector_t;
+*   static const size_t Lanes;
+*   set1, add, sub, xor_, or_, andnot (~a & b), slli<n>, srli<n>,
+*   load(scoops, words): the 16 words of the scoops of all lanes,
+*   store(vector, words): all lanes into an array of u32.
+*/
+
+#ifndef MSHABAL_DEADLINE_IMPL_HPP__
+#define MSHABAL_DEADLINE_IMPL_HPP__
+
+#include <stddef.h>
+#include <string.h>
+
+#include "mshabal_deadline.h"
+
+namespace
+{
+	template <typename TOps>
+	struct MshabalDeadline
+	{
+		typedef typename TOps::vector_t V;
+		typedef mshabal_u32 u32;
+
+		static const size_t Lanes = TOps::Lanes;
+
+		static inline void rotl17(V& x)
+		{
+			x = TOps::or_(TOps::template slli<17>(x), TOps::template srli<15>(x));
+		}
+
+		static inline void pp(V& xa0, const V& xa1, V& xb0, const V& xb1, const V& xb2, const V& xb3,
+			const V& xc, const V& xm, const V& one)
+		{
+			V tt = TOps::or_(TOps::template slli<15>(xa1), TOps::template srli<17>(xa1));
+			tt = TOps::add(TOps::template slli<2>(tt), tt);
+			tt = TOps::xor_(TOps::xor_(xa0, tt), xc);
+			tt = TOps::add(TOps::template slli<1>(tt), tt);
+			tt = TOps::xor_(TOps::xor_(tt, xb1), TOps::xor_(TOps::andnot(xb3, xb2), xm));
+			xa0 = tt;
+			tt = TOps::or_(TOps::template slli<1>(xb0), TOps::template srli<31>(xb0));
+			xb0 = TOps::xor_(tt, TOps::xor_(xa0, one));
+		}
+
+		/*
+		* The three loops of the permutation. If "full" is false, the permutation
+		* stops as soon as B[8] and B[9] (the first digest words) are final.
+		*/
+		static inline void permute(V* A, V* B, const V* C, const V* M, const V& one, bool full = true)
+		{
+			pp(A[0x0], A[0xB], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M[0x0], one);
+			pp(A[0x1], A[0x0], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M[0x1], one);
+			pp(A[0x2], A[0x1], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M[0x2], one);
+			pp(A[0x3], A[0x2], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M[0x3], one);
+			pp(A[0x4], A[0x3], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M[0x4], one);
+			pp(A[0x5], A[0x4], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M[0x5], one);
+			pp(A[0x6], A[0x5], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M[0x6], one);
+			pp(A[0x7], A[0x6], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M[0x7], one);
+			pp(A[0x8], A[0x7], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M[0x8], one);
+			pp(A[0x9], A[0x8], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M[0x9], one);
+			pp(A[0xA], A[0x9], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M[0xA], one);
+			pp(A[0xB], A[0xA], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M[0xB], one);
+			pp(A[0x0], A[0xB], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M[0xC], one);
+			pp(A[0x1], A[0x0], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M[0xD], one);
+			pp(A[0x2], A[0x1], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M[0xE], one);
+			pp(A[0x3], A[0x2], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M[0xF], one);
+
+			pp(A[0x4], A[0x3], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M[0x0], one);
+			pp(A[0x5], A[0x4], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M[0x1], one);
+			pp(A[0x6], A[0x5], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M[0x2], one);
+			pp(A[0x7], A[0x6], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M[0x3], one);
+			pp(A[0x8], A[0x7], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M[0x4], one);
+			pp(A[0x9], A[0x8], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M[0x5], one);
+			pp(A[0xA], A[0x9], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M[0x6], one);
+			pp(A[0xB], A[0xA], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M[0x7], one);
+			pp(A[0x0], A[0xB], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M[0x8], one);
+			pp(A[0x1], A[0x0], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M[0x9], one);
+			pp(A[0x2], A[0x1], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M[0xA], one);
+			pp(A[0x3], A[0x2], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M[0xB], one);
+			pp(A[0x4], A[0x3], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M[0xC], one);
+			pp(A[0x5], A[0x4], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M[0xD], one);
+			pp(A[0x6], A[0x5], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M[0xE], one);
+			pp(A[0x7], A[0x6], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M[0xF], one);
+
+			pp(A[0x8], A[0x7], B[0x0], B[0xD], B[0x9], B[0x6], C[0x8], M[0x0], one);
+			pp(A[0x9], A[0x8], B[0x1], B[0xE], B[0xA], B[0x7], C[0x7], M[0x1], one);
+			pp(A[0xA], A[0x9], B[0x2], B[0xF], B[0xB], B[0x8], C[0x6], M[0x2], one);
+			pp(A[0xB], A[0xA], B[0x3], B[0x0], B[0xC], B[0x9], C[0x5], M[0x3], one);
+			pp(A[0x0], A[0xB], B[0x4], B[0x1], B[0xD], B[0xA], C[0x4], M[0x4], one);
+			pp(A[0x1], A[0x0], B[0x5], B[0x2], B[0xE], B[0xB], C[0x3], M[0x5], one);
+			pp(A[0x2], A[0x1], B[0x6], B[0x3], B[0xF], B[0xC], C[0x2], M[0x6], one);
+			pp(A[0x3], A[0x2], B[0x7], B[0x4], B[0x0], B[0xD], C[0x1], M[0x7], one);
+			pp(A[0x4], A[0x3], B[0x8], B[0x5], B[0x1], B[0xE], C[0x0], M[0x8], one);
+			pp(A[0x5], A[0x4], B[0x9], B[0x6], B[0x2], B[0xF], C[0xF], M[0x9], one);
+
+			if (!full)
+				return;
+
+			pp(A[0x6], A[0x5], B[0xA], B[0x7], B[0x3], B[0x0], C[0xE], M[0xA], one);
+			pp(A[0x7], A[0x6], B[0xB], B[0x8], B[0x4], B[0x1], C[0xD], M[0xB], one);
+			pp(A[0x8], A[0x7], B[0xC], B[0x9], B[0x5], B[0x2], C[0xC], M[0xC], one);
+			pp(A[0x9], A[0x8], B[0xD], B[0xA], B[0x6], B[0x3], C[0xB], M[0xD], one);
+			pp(A[0xA], A[0x9], B[0xE], B[0xB], B[0x7], B[0x4], C[0xA], M[0xE], one);
+			pp(A[0xB], A[0xA], B[0xF], B[0xC], B[0x8], B[0x5], C[0x9], M[0xF], one);
+		}
+
+		/* the additions of C into A and the swap of B and C at the end of a compression */
+		static inline void finish(V* A, V* B, V* C, const V* M)
+		{
+			static const unsigned char offsets[] = { 6, 10, 14 };
+
+			for (size_t r = 0; r < 3; r++)
+				for (size_t j = 0; j < 12; j++)
+					A[11 - j] = TOps::add(A[11 - j], C[(offsets[r] - j + 16) & 15]);
+
+			for (size_t j = 0; j < 16; j++)
+			{
+				const V tmp = B[j];
+				B[j] = TOps::sub(C[j], M[j]);
+				C[j] = tmp;
+			}
+		}
+
+		/* the start of a compression: add the message and xor the counter */
+		static inline void start(V* A, V* B, const V* M, u32 wlow)
+		{
+			for (size_t j = 0; j < 16; j++)
+			{
+				B[j] = TOps::add(B[j], M[j]);
+				rotl17(B[j]);
+			}
+
+			A[0] = TOps::xor_(A[0], TOps::set1(wlow));
+		}
+
+		static void run(const mshabal_deadline_context *dc, const unsigned char *scoops,
+			unsigned long long *targets)
+		{
+			V A[12], B[16], C[16], M[16], S[16];
+			const V one = TOps::set1(0xFFFFFFFF);
+			size_t j;
+
+			TOps::load(scoops, S);
+
+			/* first block: gensig || scoop[0..32), the gensig part is precomputed */
+			for (j = 0; j < 12; j++)
+				A[j] = TOps::set1(dc->A[j]);
+
+			for (j = 0; j < 8; j++)
+			{
+				B[j] = TOps::set1(dc->B[j]);
+				M[j] = TOps::set1(dc->M[j]);
+			}
+
+			for (j = 8; j < 16; j++)
+			{
+				M[j] = S[j - 8];
+				B[j] = TOps::add(TOps::set1(dc->B[j]), M[j]);
+				rotl17(B[j]);
+			}
+
+			for (j = 0; j < 16; j++)
+				C[j] = TOps::set1(dc->C[j]);
+
+			permute(A, B, C, M, one);
+			finish(A, B, C, M);
+
+			/* second block: scoop[32..64) and the padding, the counter is 2 from now on */
+			for (j = 0; j < 8; j++)
+				M[j] = S[j + 8];
+
+			M[8] = TOps::set1(0x80);
+
+			for (j = 9; j < 16; j++)
+				M[j] = TOps::set1(0);
+
+			start(A, B, M, 2);
+			permute(A, B, C, M, one);
+			finish(A, B, C, M);
+
+			/* two of the three finalisation rounds */
+			for (j = 0; j < 2; j++)
+			{
+				start(A, B, M, 2);
+				permute(A, B, C, M, one);
+				finish(A, B, C, M);
+			}
+
+			/* the last finalisation round, the first digest words are B[8] and B[9] before the swap */
+			start(A, B, M, 2);
+			permute(A, B, C, M, one, false);
+
+			u32 low[Lanes], high[Lanes];
+			TOps::store(B[8], low);
+			TOps::store(B[9], high);
+
+			for (j = 0; j < Lanes; j++)
+				targets[j] = static_cast<unsigned long long>(high[j]) << 32 | low[j];
+		}
+
+		static void run(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+			unsigned long long *targets)
+		{
+			const unsigned char *input = static_cast<const unsigned char*>(scoops);
+
+			for (; count >= Lanes; count -= Lanes)
+			{
+				run(dc, input, targets);
+				input += Lanes * 64;
+				targets += Lanes;
+			}
+
+			/* the last lanes are padded */
+			if (count > 0)
+			{
+				unsigned char padded[Lanes * 64] = {};
+				unsigned long long paddedTargets[Lanes];
+
+				memcpy(padded, input, count * 64);
+				run(dc, padded, paddedTargets);
+				memcpy(targets, paddedTargets, count * sizeof(unsigned long long));
+			}
+		}
+	};
+}
+
+#endif
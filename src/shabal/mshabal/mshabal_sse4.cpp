@@ -401,4 +401,64 @@ extern "C" {
 
 #ifdef  __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
+
+/*
+* The fixed length deadline kernel, see mshabal_deadline.h.
+*/
+#include "mshabal_deadline_impl.hpp"
+
+namespace
+{
+	struct MshabalDeadlineOps128
+	{
+		typedef __m128i vector_t;
+		static const size_t Lanes = 4;
+
+		static inline __m128i set1(mshabal_u32 x) { return _mm_set1_epi32(static_cast<int>(x)); }
+		static inline __m128i add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+		static inline __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+		static inline __m128i xor_(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+		static inline __m128i or_(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+		static inline __m128i andnot(__m128i a, __m128i b) { return _mm_andnot_si128(a, b); }
+
+		template <int N>
+		static inline __m128i slli(__m128i a) { return _mm_slli_epi32(a, N); }
+
+		template <int N>
+		static inline __m128i srli(__m128i a) { return _mm_srli_epi32(a, N); }
+
+		static inline void load(const unsigned char *scoops, __m128i *words)
+		{
+			/* four words of every lane, transposed into four vectors of four lanes */
+			for (size_t j = 0; j < 16; j += 4)
+			{
+				const __m128i *lanes = reinterpret_cast<const __m128i*>(scoops + 4 * j);
+				const __m128i r0 = _mm_loadu_si128(lanes + 0);
+				const __m128i r1 = _mm_loadu_si128(lanes + 4);
+				const __m128i r2 = _mm_loadu_si128(lanes + 8);
+				const __m128i r3 = _mm_loadu_si128(lanes + 12);
+				const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+				const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+				const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+				const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+				words[j + 0] = _mm_unpacklo_epi64(t0, t1);
+				words[j + 1] = _mm_unpackhi_epi64(t0, t1);
+				words[j + 2] = _mm_unpacklo_epi64(t2, t3);
+				words[j + 3] = _mm_unpackhi_epi64(t2, t3);
+			}
+		}
+
+		static inline void store(__m128i a, mshabal_u32 *words)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(words), a);
+		}
+	};
+}
+
+extern "C" void
+	sse4_mshabal_deadline(const mshabal_deadline_context *dc, const void *scoops, size_t count,
+		unsigned long long *targets)
+{
+	MshabalDeadline<MshabalDeadlineOps128>::run(dc, scoops, count, targets);
+}
@@ -38,17 +38,10 @@ Burst::Account::Account(AccountId id)
 	  wallet_{nullptr}
 {}
 
-Burst::Account::Account(const Wallet& wallet, AccountId id, bool fetchAll)
+Burst::Account::Account(const Wallet& wallet, AccountId id)
 	: id_{id},
 	  wallet_{&wallet}
-{
-	if (fetchAll)
-	{
-		getOrLoadName(true);
-		getOrLoadRewardRecipient(true);
-		getOrLoadAccountBlocks(true);
-	}
-}
+{}
 
 void Burst::Account::setWallet(const Wallet& wallet)
 {
@@ -72,12 +65,18 @@ template <typename T>
 const T DefaultValueHolder<T>::value = T();
 
 template <typename T>
-const T& getHelper(Poco::Nullable<T>& val, const Burst::Wallet* wallet, bool reset, Poco::Mutex& mutex, std::function<bool(T&)> fetchFunction)
+Poco::ActiveResult<T> loadHelper(std::weak_ptr<Burst::Account> account, Poco::Nullable<T>& val, const Burst::Wallet* wallet,
+                                 bool reset, Poco::Mutex& mutex, std::function<void(Burst::Wallet::Callback<T>)> fetchFunction)
 {
+	Poco::ActiveResult<T> result{new Poco::ActiveResultHolder<T>};
 	Poco::ScopedLockWithUnlock<Poco::Mutex> lock{ mutex };
 
 	if (wallet != nullptr && !wallet->isActive())
-		return val.value(DefaultValueHolder<T>::value);
+	{
+		result.data(new T(val.value(DefaultValueHolder<T>::value)));
+		result.notify();
+		return result;
+	}
 
 	// delete cached name if resetflag is set
 	if (reset && !val.isNull())
@@ -92,22 +91,39 @@ const T& getHelper(Poco::Nullable<T>& val, const Burst::Wallet* wallet, bool res
 
 		lock.unlock();
 
-		T fetchedVal;
-
-		if (fetchFunction(fetchedVal))
-		{
-			Poco::Mutex::ScopedLock innerLock{ mutex };
-			val = fetchedVal;
-		}
-		else
+		// the callback runs on the loop of the http client or on the retry timer,
+		// val and mutex are members of the account, so they are only touched while it lives
+		fetchFunction([account, &val, &mutex, result](bool success, T fetchedVal) mutable
 		{
-			Poco::Mutex::ScopedLock innerLock{ mutex };
-			val.clear();
-		}
+			const auto lockedAccount = account.lock();
+
+			if (lockedAccount == nullptr)
+			{
+				result.data(new T(success ? fetchedVal : DefaultValueHolder<T>::value));
+				result.notify();
+				return;
+			}
+
+			{
+				Poco::Mutex::ScopedLock innerLock{ mutex };
+
+				if (success)
+					val = fetchedVal;
+				else
+					val.clear();
+
+				result.data(new T(val.value(DefaultValueHolder<T>::value)));
+			}
+
+			result.notify();
+		});
+
+		return result;
 	}
 
-	Poco::Mutex::ScopedLock innerLock{ mutex };
-	return val.value(DefaultValueHolder<T>::value);
+	result.data(new T(val.value(DefaultValueHolder<T>::value)));
+	result.notify();
+	return result;
 }
 
 const std::string& Burst::Account::getName() const
@@ -130,17 +146,17 @@ const std::vector<Burst::Block>& Burst::Account::getBlocks()
 
 Poco::ActiveResult<std::string> Burst::Account::getOrLoadName(bool reset)
 {
-	return DataLoader::getInstance().getName(std::make_tuple(std::ref(*this), reset));
+	return DataLoader::getName(*this, reset);
 }
 
 Poco::ActiveResult<Burst::AccountId> Burst::Account::getOrLoadRewardRecipient(bool reset)
 {
-	return DataLoader::getInstance().getRewardRecipient(std::make_tuple(std::ref(*this), reset));
+	return DataLoader::getRewardRecipient(*this, reset);
 }
 
 Poco::ActiveResult<std::vector<Burst::Block>> Burst::Account::getOrLoadAccountBlocks(bool reset)
 {
-	return DataLoader::getInstance().getAccountBlocks(std::make_tuple(std::ref(*this), reset));
+	return DataLoader::getAccountBlocks(*this, reset);
 }
 
 std::string Burst::Account::getAddress() const
@@ -174,50 +190,27 @@ Poco::JSON::Object::Ptr Burst::Account::toJSON() const
 	return json;
 }
 
-Burst::Account::DataLoader::DataLoader()
-	: getName{this, &DataLoader::runGetName},
-	  getRewardRecipient{this, &DataLoader::runGetRewardRecipient},
-	  getAccountBlocks{this, &DataLoader::runGetAccountBlocks}
-{}
-
-Burst::Account::DataLoader::~DataLoader() {}
-
-Burst::Account::DataLoader& Burst::Account::DataLoader::getInstance()
+Poco::ActiveResult<std::string> Burst::Account::DataLoader::getName(Account& account, bool reset)
 {
-	static DataLoader dataLoader;
-	return dataLoader;
-}
-
-std::string Burst::Account::DataLoader::runGetName(const AsyncParameter& parameter)
-{
-	auto& account = std::get<0>(parameter);
-	const auto reset = std::get<1>(parameter);
-
-	return getHelper<std::string>(account.name_, account.wallet_, reset, account.mutex_, [&account](std::string& name)
+	return loadHelper<std::string>(account.shared_from_this(), account.name_, account.wallet_, reset, account.mutex_, [&account](Wallet::Callback<std::string> callback)
 	{
-		return account.wallet_->getNameOfAccount(account.id_, name);
+		account.wallet_->getNameOfAccount(account.id_, std::move(callback));
 	});
 }
 
-Burst::AccountId Burst::Account::DataLoader::runGetRewardRecipient(const AsyncParameter& parameter)
+Poco::ActiveResult<Burst::AccountId> Burst::Account::DataLoader::getRewardRecipient(Account& account, bool reset)
 {
-	auto& account = std::get<0>(parameter);
-	const auto reset = std::get<1>(parameter);
-	
-	return getHelper<AccountId>(account.rewardRecipient_, account.wallet_, reset, account.mutex_, [&account](AccountId& rewardRecipient)
+	return loadHelper<AccountId>(account.shared_from_this(), account.rewardRecipient_, account.wallet_, reset, account.mutex_, [&account](Wallet::Callback<AccountId> callback)
 	{
-		return account.wallet_->getRewardRecipientOfAccount(account.id_, rewardRecipient);
+		account.wallet_->getRewardRecipientOfAccount(account.id_, std::move(callback));
 	});
 }
 
-std::vector<Burst::Block> Burst::Account::DataLoader::runGetAccountBlocks(const AsyncParameter& parameter)
+Poco::ActiveResult<std::vector<Burst::Block>> Burst::Account::DataLoader::getAccountBlocks(Account& account, bool reset)
 {
-	auto& account = std::get<0>(parameter);
-	const auto reset = std::get<1>(parameter);
-	
-	return getHelper<std::vector<Block>>(account.blocks_, account.wallet_, reset, account.mutex_, [&account](std::vector<Block>& blocks)
+	return loadHelper<std::vector<Block>>(account.shared_from_this(), account.blocks_, account.wallet_, reset, account.mutex_, [&account](Wallet::Callback<std::vector<Block>> callback)
 	{
-		return account.wallet_->getAccountBlocks(account.id_, blocks);
+		account.wallet_->getAccountBlocks(account.id_, std::move(callback));
 	});
 }
 
@@ -230,11 +223,16 @@ std::shared_ptr<Burst::Account> Burst::Accounts::getAccount(AccountId id, const
 	// if the account is not in the cache, we have to fetch him
 	if (iter == accounts_.end())
 	{
-		auto account = std::make_shared<Account>(wallet, id, persistent);
+		auto account = std::make_shared<Account>(wallet, id);
 
 		// save the account in the cache if wanted
 		if (persistent)
 		{
+			// the responses are dropped, if the account is destroyed before they arrive
+			account->getOrLoadName(true);
+			account->getOrLoadRewardRecipient(true);
+			account->getOrLoadAccountBlocks(true);
+
 			accounts_.emplace(id, account);
 			log_debug(MinerLogger::general, "Cached accounts: %z", accounts_.size());
 		}
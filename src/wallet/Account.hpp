@@ -29,6 +29,7 @@
 #include <Poco/JSON/Object.h>
 #include <vector>
 #include <Poco/ActiveDispatcher.h>
+#include <memory>
 
 namespace Burst
 {
@@ -36,12 +37,18 @@ namespace Burst
 
 	using Block = Poco::UInt64;
 
-	class Account
+	/**
+	 * \brief An account with its data, that is loaded from the wallet.
+	 * The data is loaded asynchronously, so the account has to be owned by a std::shared_ptr
+	 * (see Accounts::getAccount), when getOrLoad* is called.
+	 * A response, that arrives after the account was destroyed, is dropped.
+	 */
+	class Account : public std::enable_shared_from_this<Account>
 	{
 	public:
 		Account();
 		Account(AccountId id);
-		Account(const Wallet& wallet, AccountId id, bool fetchAll = false);
+		Account(const Wallet& wallet, AccountId id);
 
 		void setWallet(const Wallet& wallet);
 
@@ -58,24 +65,17 @@ namespace Burst
 		Poco::JSON::Object::Ptr toJSON() const;
 		
 	private:
-		class DataLoader : public Poco::ActiveDispatcher
+		/**
+		 * \brief Loads the data of an account from the wallet.
+		 * The requests are sent by the AsyncHttpClient and the results are set by its callbacks,
+		 * so a pending request does not occupy a thread.
+		 */
+		class DataLoader
 		{
 		public:
-			DataLoader();
-			~DataLoader() override;
-
-			static DataLoader& getInstance();
-
-			using AsyncParameter = std::tuple<Account&, bool>;
-
-			Poco::ActiveMethod<std::string, AsyncParameter, DataLoader, Poco::ActiveStarter<ActiveDispatcher>> getName;
-			Poco::ActiveMethod<AccountId, AsyncParameter, DataLoader, Poco::ActiveStarter<ActiveDispatcher>> getRewardRecipient;
-			Poco::ActiveMethod<std::vector<Block>, AsyncParameter, DataLoader, Poco::ActiveStarter<ActiveDispatcher>> getAccountBlocks;
-
-		private:
-			std::string runGetName(const AsyncParameter& parameter);
-			AccountId runGetRewardRecipient(const AsyncParameter& parameter);
-			std::vector<Block> runGetAccountBlocks(const AsyncParameter& parameter);
+			static Poco::ActiveResult<std::string> getName(Account& account, bool reset);
+			static Poco::ActiveResult<AccountId> getRewardRecipient(Account& account, bool reset);
+			static Poco::ActiveResult<std::vector<Block>> getAccountBlocks(Account& account, bool reset);
 		};
 
 	private:
@@ -23,17 +23,60 @@
 #include "MinerUtil.hpp"
 #include <Poco/Net/HTTPClientSession.h>
 #include "mining/MinerConfig.hpp"
-#include "network/Request.hpp"
+#include "network/AsyncHttpClient.hpp"
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/JSON/Parser.h>
 #include <cassert>
 #include <Poco/NestedDiagnosticContext.h>
 #include "logging/MinerLogger.hpp"
 #include "Account.hpp"
-#include <thread>
+#include <Poco/Util/Timer.h>
+#include <Poco/Util/TimerTask.h>
+#include <future>
 
 using namespace Poco::Net;
 
+namespace
+{
+	class RetryTask : public Poco::Util::TimerTask
+	{
+	public:
+		explicit RetryTask(std::function<void()> function)
+			: function_(std::move(function))
+		{}
+
+		void run() override
+		{
+			function_();
+		}
+
+	private:
+		std::function<void()> function_;
+	};
+
+	Poco::Util::Timer& getRetryTimer()
+	{
+		static Poco::Util::Timer timer;
+		return timer;
+	}
+
+	template <typename T>
+	bool waitFor(const std::function<void(Burst::Wallet::Callback<T>)>& request, T& value)
+	{
+		std::promise<std::pair<bool, T>> promise;
+		auto future = promise.get_future();
+
+		request([&promise](bool success, T result)
+		{
+			promise.set_value(std::make_pair(success, std::move(result)));
+		});
+
+		auto result = future.get();
+		value = std::move(result.second);
+		return result.first;
+	}
+}
+
 Burst::Wallet::Wallet()
 {}
 
@@ -79,59 +122,55 @@ bool Burst::Wallet::getWinnerOfBlock(Poco::UInt64 block, AccountId& winnerId) co
 bool Burst::Wallet::getNameOfAccount(AccountId account, std::string& name) const
 {
 	poco_ndc(Wallet::getNameOfAccount);
-	Poco::JSON::Object::Ptr json;
-	name = "";
-
-	if (!isActive())
-		return false;
+	return waitFor<std::string>([this, account](Callback<std::string> callback)
+	{
+		getNameOfAccount(account, std::move(callback));
+	}, name);
+}
 
+void Burst::Wallet::getNameOfAccount(AccountId account, Callback<std::string> callback) const
+{
 	Poco::URI uri;
 	uri.setPath("/burst");
 	uri.addQueryParameter("requestType", "getAccount");
 	uri.addQueryParameter("account", std::to_string(account));
 
-	if (sendWalletRequest(uri, json))
+	sendWalletRequest(uri, [callback](Poco::JSON::Object::Ptr json)
 	{
-		if (json->has("name"))
-		{
-			name = json->get("name").convert<std::string>();
-			return true;
-		}
-
-		return false;
-	}
+		if (json.isNull())
+			log_debug(MinerLogger::wallet, "Could not get name of account!");
+		else if (json->has("name"))
+			return callback(true, json->get("name").convert<std::string>());
 
-	log_debug(MinerLogger::wallet, "Could not get name of account!");
-	return false;
+		callback(false, "");
+	});
 }
 
 bool Burst::Wallet::getRewardRecipientOfAccount(AccountId account, AccountId& rewardRecipient) const
 {
 	poco_ndc(Wallet::getRewardRecipientOfAccount);
-	Poco::JSON::Object::Ptr json;
-	rewardRecipient = 0;
-
-	if (!isActive())
-		return false;
+	return waitFor<AccountId>([this, account](Callback<AccountId> callback)
+	{
+		getRewardRecipientOfAccount(account, std::move(callback));
+	}, rewardRecipient);
+}
 
+void Burst::Wallet::getRewardRecipientOfAccount(AccountId account, Callback<AccountId> callback) const
+{
 	Poco::URI uri;
 	uri.setPath("/burst");
 	uri.addQueryParameter("requestType", "getRewardRecipient");
 	uri.addQueryParameter("account", std::to_string(account));
 
-	if (sendWalletRequest(uri, json))
+	sendWalletRequest(uri, [callback](Poco::JSON::Object::Ptr json)
 	{
-		if (json->has("rewardRecipient"))
-		{
-            rewardRecipient = static_cast<Poco::UInt64>(json->get("rewardRecipient"));
-			return true;
-		}
-
-		return false;
-	}
+		if (json.isNull())
+			log_debug(MinerLogger::wallet, "Could not get name of account!");
+		else if (json->has("rewardRecipient"))
+			return callback(true, static_cast<Poco::UInt64>(json->get("rewardRecipient")));
 
-	log_debug(MinerLogger::wallet, "Could not get name of account!");
-	return false;
+		callback(false, 0);
+	});
 }
 
 bool Burst::Wallet::getLastBlock(Poco::UInt64& block) const
@@ -171,20 +210,26 @@ void Burst::Wallet::getAccount(AccountId id, Account& account) const
 
 bool Burst::Wallet::getAccountBlocks(AccountId id, std::vector<Block>& blocks) const
 {
-	Poco::JSON::Object::Ptr json;
-	blocks.clear();
-
-	if (!isActive())
-		return false;
+	return waitFor<std::vector<Block>>([this, id](Callback<std::vector<Block>> callback)
+	{
+		getAccountBlocks(id, std::move(callback));
+	}, blocks);
+}
 
+void Burst::Wallet::getAccountBlocks(AccountId id, Callback<std::vector<Block>> callback) const
+{
 	Poco::URI uri;
 	uri.setPath("/burst");
 	uri.addQueryParameter("requestType", "getAccountBlockIds");
 	uri.addQueryParameter("account", std::to_string(id));
 
-	if (sendWalletRequest(uri, json))
+	sendWalletRequest(uri, [callback](Poco::JSON::Object::Ptr json)
 	{
-		if (json->has("blockIds"))
+		std::vector<Block> blocks;
+
+		if (json.isNull())
+			log_debug(MinerLogger::wallet, "Could not get account blocks!");
+		else if (json->has("blockIds"))
 		{
 			auto blockIds = json->getArray("blockIds");
 
@@ -202,14 +247,11 @@ bool Burst::Wallet::getAccountBlocks(AccountId id, std::vector<Block>& blocks) c
 				}
 			}
 
-			return true;
+			return callback(true, std::move(blocks));
 		}
 
-		return false;
-	}
-
-	log_debug(MinerLogger::wallet, "Could not get account blocks!");
-	return false;
+		callback(false, std::move(blocks));
+	});
 }
 
 bool Burst::Wallet::isActive() const
@@ -224,36 +266,64 @@ bool Burst::Wallet::sendWalletRequest(const Poco::URI& uri, Poco::JSON::Object::
 	if (!isActive())
 		return false;
 
-	HTTPRequest request{ HTTPRequest::HTTP_GET, uri.getPathAndQuery(), HTTPRequest::HTTP_1_1};
-	request.setKeepAlive(false);
-		
-	Request req{ url_.createSession() };
-	auto resp = req.send(request);
-	std::string data;
+	std::promise<Poco::JSON::Object::Ptr> promise;
+	auto future = promise.get_future();
 
-	for (auto i = 0u; i < MinerConfig::getConfig().getWalletRequestTries(); ++i)
+	sendWalletRequest(uri, [&promise](Poco::JSON::Object::Ptr response)
 	{
-		if (resp.receive(data))
+		promise.set_value(response);
+	});
+
+	json = future.get();
+	return !json.isNull();
+}
+
+void Burst::Wallet::sendWalletRequest(const Poco::URI& uri, std::function<void(Poco::JSON::Object::Ptr)> callback) const
+{
+	if (!isActive())
+		return callback(nullptr);
+
+	sendWalletRequest(url_, uri.getPathAndQuery(), MinerConfig::getConfig().getWalletRequestTries(), std::move(callback));
+}
+
+void Burst::Wallet::sendWalletRequest(const Url& url, const std::string& pathAndQuery, const unsigned tries,
+                                      std::function<void(Poco::JSON::Object::Ptr)> callback)
+{
+	if (tries == 0)
+	{
+		log_error(MinerLogger::wallet, "Got no response for wallet request '%s'", pathAndQuery);
+		return callback(nullptr);
+	}
+
+	HTTPRequest request{ HTTPRequest::HTTP_GET, pathAndQuery, HTTPRequest::HTTP_1_1};
+	request.setKeepAlive(true);
+
+	AsyncHttpClient::instance().send(url, request, "", [url, pathAndQuery, tries, callback](AsyncHttpResponse& response)
+	{
+		if (response.isOk())
 		{
+			Poco::JSON::Object::Ptr json;
+
 			try
 			{
 				Poco::JSON::Parser parser;
-				json = parser.parse(data).extract<Poco::JSON::Object::Ptr>();
-				return true;
+				json = parser.parse(response.body).extract<Poco::JSON::Object::Ptr>();
 			}
 			catch (Poco::Exception&)
 			{
-				log_error(MinerLogger::wallet, "Got invalid json response from wallet!\n\tURI: %s", uri.getPathAndQuery());
-				log_file_only(MinerLogger::wallet, Poco::Message::PRIO_ERROR, TextType::Error, "Got invalid json response from wallet!\n%s", data);
-				log_current_stackframe(MinerLogger::wallet);
-				return false;
+				log_error(MinerLogger::wallet, "Got invalid json response from wallet!\n\tURI: %s", pathAndQuery);
+				log_file_only(MinerLogger::wallet, Poco::Message::PRIO_ERROR, TextType::Error, "Got invalid json response from wallet!\n%s", response.body);
 			}
-		}
 
-		std::this_thread::sleep_for(std::chrono::seconds(MinerConfig::getConfig().getWalletRequestRetryWaitTime()));
-	}
+			return callback(json);
+		}
 
-	log_error(MinerLogger::wallet, "Got no response for wallet request '%s'", uri.toString());
+		// every try sends the request again, the wait for it does not block a thread
+		const auto waitTime = MinerConfig::getConfig().getWalletRequestRetryWaitTime();
 
-	return false;
+		getRetryTimer().schedule(new RetryTask([url, pathAndQuery, tries, callback]()
+		{
+			sendWalletRequest(url, pathAndQuery, tries - 1, callback);
+		}), Poco::Timestamp() + static_cast<Poco::Timestamp::TimeDiff>(waitTime) * Poco::Timestamp::resolution());
+	});
 }
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <Poco/JSON/Object.h>
 #include "Declarations.hpp"
@@ -46,6 +47,14 @@ namespace Burst
 	class Wallet
 	{
 	public:
+		/**
+		 * \brief Called with the result of an asynchronous wallet request.
+		 * The first parameter is false, if the request failed. It is called by the event loop
+		 * of the AsyncHttpClient and must not block.
+		 */
+		template <typename T>
+		using Callback = std::function<void(bool, T)>;
+
 		Wallet();
 		Wallet(const Url& url);
 		Wallet(const Wallet& rhs) = delete;
@@ -59,6 +68,10 @@ namespace Burst
 		void getAccount(AccountId id, Account& account) const;
 		bool getAccountBlocks(AccountId id, std::vector<Block>& blocks) const;
 
+		void getNameOfAccount(AccountId account, Callback<std::string> callback) const;
+		void getRewardRecipientOfAccount(AccountId account, Callback<AccountId> callback) const;
+		void getAccountBlocks(AccountId id, Callback<std::vector<Block>> callback) const;
+
 		bool isActive() const;
 
 		Wallet& operator=(const Wallet& rhs) = delete;
@@ -66,6 +79,16 @@ namespace Burst
 
 	private:
 		bool sendWalletRequest(const Poco::URI& uri, Poco::JSON::Object::Ptr& json) const;
+
+		/**
+		 * \brief Sends a request to the wallet without waiting for the response.
+		 * \param uri The uri of the request.
+		 * \param callback Called with the json response or with a null pointer, if all tries failed.
+		 */
+		void sendWalletRequest(const Poco::URI& uri, std::function<void(Poco::JSON::Object::Ptr)> callback) const;
+
+		static void sendWalletRequest(const Url& url, const std::string& pathAndQuery, unsigned tries,
+		                              std::function<void(Poco::JSON::Object::Ptr)> callback);
 		Url url_;
 	};
 }
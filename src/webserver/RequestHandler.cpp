@@ -32,6 +32,7 @@
 #include "mining/Miner.hpp"
 #include <Poco/NestedDiagnosticContext.h>
 #include "network/Request.hpp"
+#include "network/AsyncHttpClient.hpp"
 #include "mining/MinerConfig.hpp"
 #include "plots/PlotSizes.hpp"
 #include <Poco/Logger.h>
@@ -40,6 +41,7 @@
 #include <Poco/StringTokenizer.h>
 #include <Poco/Net/HTMLForm.h>
 #include "plots/PlotGenerator.hpp"
+#include "plots/PlotChecker.hpp"
 #include <regex>
 #include <utility>
 #include <Poco/Net/NetException.h>
@@ -398,9 +400,10 @@ void Burst::RequestHandler::forward(Poco::Net::HTTPServerRequest& request, Poco:
 		}
 	}
 
-	auto session = MinerConfig::getConfig().createSession(hostType);
+	const auto url = hostType == HostType::Wallet ? MinerConfig::getConfig().getWalletUrl() :
+		hostType == HostType::MiningInfo ? MinerConfig::getConfig().getMiningInfoUrl() : MinerConfig::getConfig().getPoolUrl();
 
-	if (session == nullptr)
+	if (url.empty())
 		return;
 
 	log_information(MinerLogger::server, "Forwarding request:\n\t%s", request.getURI());
@@ -412,20 +415,24 @@ void Burst::RequestHandler::forward(Poco::Net::HTTPServerRequest& request, Poco:
 		Poco::Net::HTTPRequest forwardingRequest;
 		forwardingRequest.setURI(request.getURI());
 		forwardingRequest.setMethod(request.getMethod());
-		forwardingRequest.setContentLength(request.getContentLength());
-		forwardingRequest.setTransferEncoding(request.getTransferEncoding());
-		forwardingRequest.setChunkedTransferEncoding(request.getChunkedTransferEncoding());
-		forwardingRequest.setKeepAlive(request.getKeepAlive());
+		// the connection to the host is pooled, independent of the connection to the client
+		forwardingRequest.setKeepAlive(true);
 		forwardingRequest.setVersion(request.getVersion());
 
-		Request forwardRequest{ std::move(session) };
-		auto forwardResponse = forwardRequest.send(forwardingRequest);
+		// the body is forwarded as a whole, the http client sets its length
+		const std::string body{std::istreambuf_iterator<char>(request.stream()), {}};
+
+		if (!body.empty())
+			forwardingRequest.setContentType(request.getContentType());
+
+		auto forwardResponse = AsyncHttpClient::instance().send(url, forwardingRequest, body);
 
 		log_debug(MinerLogger::server, "Request forwarded, waiting for response...");
 
-		std::string data;
+		const auto forwarded = forwardResponse.get();
+		const auto& data = forwarded.body;
 
-		if (forwardResponse.receive(data))
+		if (forwarded.isOk())
 		{
 			log_debug(MinerLogger::server, "Got response, sending back...\n\t%s", data);
 
@@ -494,22 +501,14 @@ void Burst::RequestHandler::checkAllPlotfiles(Poco::Net::HTTPServerRequest& requ
 
 	log_information(MinerLogger::server, "Got request to check all files for corruption...");
 
-	const auto plotFiles = MinerConfig::getConfig().getPlotFiles();
-	auto totalSize = 0ull;
-	auto totalWeightedIntegrity = 0.0;
+	// all plot files are checked at once, every device in parallel
+	const auto totalIntegrity = PlotChecker{miner, server}.check(MinerConfig::getConfig().getPlotFiles());
 
-	for (const auto& plotFile : plotFiles)
-	{
-		const auto& plotPath = plotFile->getPath();
-		auto integrity = PlotGenerator::checkPlotfileIntegrity(plotPath, miner, server);
-		totalWeightedIntegrity += integrity * plotFile->getSize();
-		totalSize += plotFile->getSize();
-	}
-	log_information(MinerLogger::general, "Overall miner plot integrity: " + std::to_string(totalWeightedIntegrity / totalSize) + "%");
+	log_information(MinerLogger::general, "Overall miner plot integrity: " + std::to_string(totalIntegrity) + "%");
 	//response
 	Poco::JSON::Object json;
 	json.set("type", "totalPlotcheck-result");
-	json.set("totalPlotIntegrity", std::to_string(totalWeightedIntegrity / totalSize));
+	json.set("totalPlotIntegrity", std::to_string(totalIntegrity));
 
 	server.sendToWebsockets(json);
 